@@ -1,4 +1,5 @@
 #pragma once
+#include "Portable.h"
 
 using std::array;
 using std::vector;
@@ -4,12 +4,14 @@
 #include "DataDefs/RulesOps.h"
 
 #include "DataDefs/Multivector.h"
+#include "DataDefs/DetectionCache.h"
 
 #include "RulesMenu.h"			// Player PlayerRules management menu
 #include "ExtraKeywords.h"		// Add keywords from MCM Papyrus functions
 
 #include "Types/SLHelpers.h"
 #include "Types/SyncTypes.h"
+#include "Types/Timing.h"
 
 namespace Data {
 
@@ -28,6 +30,23 @@ namespace Data {
 		constexpr bool FearEnabled = true; // Replace with MCM check
 		constexpr bool DebuffsEnabled = true; // Replace with MCM check
 
+		// Main thread time per default update that detection checks may take. 0 means check every pair every update.
+		static std::atomic<u32> detection_budget_us{ 2000 };
+		static std::atomic<bool> detection_cache_stale{ false }; // Set on revert, since handles of the old game mean nothing in the new one
+		static std::atomic<bool> debuffs_stale{ true }; // Set on revert, since the loaded player has whatever debuffs the save has
+		static std::atomic<i32> shown_recent_dodges{ -1 }; // What the Recent Dodges description says, so short updates only rewrite it on changes. -1 for unknown.
+		static std::atomic<bool> trace_wanted{ false }; // Set by SetUpdateTrace(). The update thread starts or stops the trace when it sees it changed.
+		static std::atomic<u32> save_format{ std::to_underlying(ActorRecords::format::Columns) }; // ActorRecords::format of the next save, set by SetSaveFormat()
+		static std::atomic<u32> cold_after{ 5 }; // Long updates an actor can go ungathered before its row goes cold, set by SetColdAfter(). 0 for never.
+		// What the last refresh did, for GetDetectionStats()
+		static struct {
+			std::atomic<u32> pairs{ 0 };
+			std::atomic<u32> refreshed{ 0 };
+			std::atomic<u32> unknown{ 0 };
+			std::atomic<u32> max_age{ 0 };
+			std::atomic<u32> spent_us{ 0 };
+		} detection_stats{};
+
 		void BrawlEvent(RE::TESForm* controller, const bool starting) noexcept {
 			using SLHelpers::sslThreadController_interface::MaxActors;
 			const SLHelpers::sslThreadController_interface analyzer{ controller };
@@ -41,12 +60,12 @@ namespace Data {
 
 			// Just be dumb and simply do this if scene is ending, and live with the slight code duplication
 			if (!starting) {
-				if (const auto idx = locked->find_index(analyzer.PassiveActor()); locked->is_valid(idx)) {
-					locked->fear(idx).in_brawl = false;
+				if (const auto idx = locked->find_or_take(analyzer.PassiveActor()); locked->is_valid(idx)) {
+					locked->fear(idx).set_in_brawl(false);
 				}
 				for (u32 i = 0, actor_count = analyzer.ActorCount(); i < actor_count; ++i) {
-					if (const size_t idx = locked->find_index(actives[i].get()); locked->is_valid(idx)) {
-						locked->fear(idx).in_brawl = false;
+					if (const size_t idx = locked->find_or_take(actives[i].get()); locked->is_valid(idx)) {
+						locked->fear(idx).set_in_brawl(false);
 					}
 				}
 				return;
@@ -59,59 +78,58 @@ namespace Data {
 			};
 			array<idx_pair, MaxActors> found_idxs{};
 			const u32 found_count = [&locked, &actives, &found_idxs, actor_count = analyzer.ActorCount()]() {
-				// Find FearInfo pointers of actives, and update their in_brawl. Do it in here because I like const counts.
+				// Find data indexes of actives, and update their in_brawl. Do it in here because I like const counts.
 				u32 found_count = 0;
 				for (u32 i = 0; i < actor_count; ++i) {
-					if (const size_t prospective = locked->find_index(actives[i].get()); locked->is_valid(prospective)) {
+					if (const size_t prospective = locked->find_or_take(actives[i].get()); locked->is_valid(prospective)) {
 						found_idxs[found_count].active_idx = i;
 						found_idxs[found_count].data_idx = static_cast<u32>(prospective);
 						++found_count;
-						locked->fear(prospective).in_brawl = true;
+						locked->fear(prospective).set_in_brawl(true);
 					}
 				}
 				return found_count;
 			}();
 
-			FearInfo* passive_fear;
-			if (const auto passive_index = locked->find_index(analyzer.PassiveActor()); locked->is_valid(passive_index)) {
-				passive_fear = &locked->fear(passive_index);
-			} else {
+			const size_t passive_index = locked->find_or_take(analyzer.PassiveActor());
+			if (!locked->is_valid(passive_index)) {
 				return; // No data for passive. Can return.
 			}
-			passive_fear->in_brawl = true;
+			const fear_columns::ref passive_fear = locked->fear(passive_index);
+			passive_fear.set_in_brawl(true);
 			if (found_count == 0) {
 				return; // Everything below requires a passive actor and at least 1 active actor, and should only trigger on scene start (picked arbitrarily, just need triggering once)
 			}
 
 			// Fears adjustment. SKSE queues the modevent callbacks using Skyrim's Papyrus VM like all other events, so these should be safe to access game data from.
-			const bool passive_female = passive_fear->is_female;
+			const bool passive_female = passive_fear.is_female();
 			u8 pres_flags = 0;
 			if (passive_female) {
 				for (u32 i = 0; i < found_count; ++i) {
-					FearInfo& info = locked->fear(found_idxs[i].data_idx);
-					pres_flags |= static_cast<u8>(1 << static_cast<u8>(info.is_female));
+					const fear_columns::ref info = locked->fear(found_idxs[i].data_idx);
+					pres_flags |= static_cast<u8>(1 << static_cast<u8>(info.is_female()));
 					info.fears_female *= 0.99f;
 					actives[found_idxs[i].active_idx]->AddToFaction(::Fear::Faction(::Fear::FAC::FearsFemale), info.FearsFemaleRank());
 				}
 			} else {
 				for (u32 i = 0; i < found_count; ++i) {
-					FearInfo& info = locked->fear(found_idxs[i].data_idx);
-					pres_flags |= static_cast<u8>(1 << static_cast<u8>(info.is_female));
+					const fear_columns::ref info = locked->fear(found_idxs[i].data_idx);
+					pres_flags |= static_cast<u8>(1 << static_cast<u8>(info.is_female()));
 					info.fears_male *= 0.99f;
 					actives[found_idxs[i].active_idx]->AddToFaction(::Fear::Faction(::Fear::FAC::FearsMale), info.FearsMaleRank());
 				}
 			}
 			if (pres_flags & 1) { // Male in actives (1 << false)
-				passive_fear->fears_male *= 1.01f;
-				analyzer.PassiveActor()->AddToFaction(::Fear::Faction(::Fear::FAC::FearsMale), passive_fear->FearsMaleRank());
+				passive_fear.fears_male *= 1.01f;
+				analyzer.PassiveActor()->AddToFaction(::Fear::Faction(::Fear::FAC::FearsMale), passive_fear.FearsMaleRank());
 			}
 			if (pres_flags & 2) { // Female in actives (1 << true)
-				passive_fear->fears_female *= 1.01f;
-				analyzer.PassiveActor()->AddToFaction(::Fear::Faction(::Fear::FAC::FearsFemale), passive_fear->FearsFemaleRank());
+				passive_fear.fears_female *= 1.01f;
+				analyzer.PassiveActor()->AddToFaction(::Fear::Faction(::Fear::FAC::FearsFemale), passive_fear.FearsFemaleRank());
 			}
 
 			// PlayerRules rules stuff for passive player
-			if (analyzer.PassiveActor()->IsPlayerRef() bitand passive_fear->is_blocked) {
+			if (analyzer.PassiveActor()->IsPlayerRef() bitand passive_fear.is_blocked) {
 				rules_info& prules = locked->player_rules();
 				prules.EnteredBrawl(analyzer.Tags());
 				if (analyzer.PassiveIsVictim()) {
@@ -126,80 +144,150 @@ namespace Data {
 		}
 
 
-		void ProcessEquip(RE::Actor* act, const RE::TESBoundObject* obj) noexcept {
-			if (IsValidAddable(act)) {
-				switch (obj->GetFormType()) {
-				case RE::TESObjectARMO::FORMTYPE: {
-					const auto locked = locker.GetExclusive();
-					if (auto idx = locked->has_or_add(act); idx < locked->size()) {
-						auto flags = locked->equipstate(idx).ProcessArmorEquip(static_cast<const RE::TESObjectARMO*>(obj));
-						if (act->IsPlayerRef() and locked->player_is_blocked()) {
-							locked->player_rules().ArmorEquipped(flags);
+		// Applies one equip event to data. Player rules only see player events.
+		static void ApplyEquip(multivector& data, RE::Actor* act, const RE::TESBoundObject* obj, const bool equipped) noexcept {
+			switch (obj->GetFormType()) {
+			case RE::TESObjectARMO::FORMTYPE: {
+				if (auto idx = data.has_or_add(act); idx < data.size()) {
+					if (equipped) {
+						auto flags = data.armor_equipped(idx, static_cast<const RE::TESObjectARMO*>(obj));
+						if (act->IsPlayerRef() and data.player_is_blocked()) {
+							data.player_rules().ArmorEquipped(flags);
+						}
+					} else {
+						const EquipState& state = data.armor_unequipped(idx, static_cast<const RE::TESObjectARMO*>(obj));
+						if (act->IsPlayerRef() and data.player_is_blocked()) {
+							data.player_rules().ArmorUnequipped(state);
 						}
 					}
-					break;
 				}
-				case RE::TESObjectWEAP::FORMTYPE: {
-					if (auto type = static_cast<const RE::TESObjectWEAP*>(obj)->GetWeaponType(); type != RE::WeaponTypes::WEAPON_TYPE::kHandToHandMelee) { // Ignore Fists
-						const auto locked = locker.GetExclusive();
-						if (auto idx = locked->has_or_add(act); idx < locked->size()) {
-							locked->equipstate(idx).UpdateHands(act);
-							if (act->IsPlayerRef() and locked->player_is_blocked()) {
-								locked->player_rules().HandEquipped({ type });
-							}
+				break;
+			}
+			case RE::TESObjectWEAP::FORMTYPE:
+			case RE::SpellItem::FORMTYPE: {
+				if (auto idx = data.has_or_add(act); idx < data.size()) {
+					EquipState& state = data.equipstate(idx);
+					state.UpdateHands(act);
+					if (act->IsPlayerRef() and data.player_is_blocked()) {
+						if (!equipped) {
+							data.player_rules().HandUnequipped(state.hands);
+						} else if (obj->GetFormType() == RE::TESObjectWEAP::FORMTYPE) {
+							data.player_rules().HandEquipped({ static_cast<const RE::TESObjectWEAP*>(obj)->GetWeaponType() });
+						} else {
+							data.player_rules().HandEquipped({ static_cast<const RE::SpellItem*>(obj)->GetAssociatedSkill() });
 						}
 					}
-					break;
 				}
-				case RE::SpellItem::FORMTYPE: {
-					const auto locked = locker.GetExclusive();
-					if (auto idx = locked->has_or_add(act); idx < locked->size()) {
-						locked->equipstate(idx).UpdateHands(act);
-						if (act->IsPlayerRef() and locked->player_is_blocked()) {
-							locked->player_rules().HandEquipped({ static_cast<const RE::SpellItem*>(obj)->GetAssociatedSkill() });
+				break;
+			}
+			default: break;
+			}
+		}
+
+		// NPC equip events wait here, so the game threads sending them don't fight over the lock with each other and the update.
+		// They get applied in batches under one exclusive lock, by whoever next needs equip data up to date.
+		// Player events are applied right away, after the queue, so player rules keep seeing them in order.
+		struct equip_delta {
+			trivial_handle actor;
+			RE::FormID form;
+			u32 slots;	// Biped slots of armor, 0 for hand events
+			RE::FormType type;
+			bool equipped;
+		};
+		static_assert(std::is_trivially_copyable_v<equip_delta> and sizeof(equip_delta) == 16);
+		enum : u32 { EquipQueueCapacity = 256 };
+		static SyncTypes::mpsc_ring<equip_delta, EquipQueueCapacity> equip_queue{};
+
+		// Drops an actor's equip/unequip pairs of the same armor, unless another of their armor events in between touches its slots, since each slot keeps whatever armor touched it last.
+		// Their hand events in between don't matter to that, and all but the last hand event of each actor get dropped too, since UpdateHands() reads the actor's current hands anyway.
+		// Outfit swaps send such bursts. Returns the new count, order kept.
+		static u32 CoalesceEquips(equip_delta* batch, const u32 count) noexcept {
+			array<bool, EquipQueueCapacity> dead{};
+			for (u32 k = 1; k < count; ++k) {
+				const equip_delta& cur = batch[k];
+				const bool hand = cur.type != RE::TESObjectARMO::FORMTYPE;
+				for (u32 prev = k; prev-- > 0;) {
+					const equip_delta& old = batch[prev];
+					if (dead[prev] or (old.actor != cur.actor)) {
+						continue;
+					}
+					if (hand and (old.type != RE::TESObjectARMO::FORMTYPE)) {
+						dead[prev] = true; // Superseded
+						break;
+					}
+					if (!hand and (old.form == cur.form)) {
+						if (old.equipped != cur.equipped) { // Cancel out
+							dead[prev] = true;
+							dead[k] = true;
 						}
+						break;
+					}
+					if (!hand and ((old.slots & cur.slots) != 0)) {
+						break; // Dropping the pair would change what the shared slots end up with
 					}
-					break;
 				}
-				default: break;
+			}
+			u32 out = 0;
+			for (u32 k = 0; k < count; ++k) {
+				if (!dead[k]) {
+					batch[out++] = batch[k];
 				}
 			}
+			return out;
 		}
-		void ProcessUnequip(RE::Actor* act, const RE::TESBoundObject* obj) noexcept {
-			if (IsValidAddable(act)) {
-				switch (obj->GetFormType()) {
-				case RE::TESObjectARMO::FORMTYPE: {
-					const auto locked = locker.GetExclusive();
-					if (auto idx = locked->has_or_add(act); idx < locked->size()) {
-						EquipState& state = locked->equipstate(idx);
-						state.ProcessArmorUnequip(static_cast<const RE::TESObjectARMO*>(obj));
-						if (act->IsPlayerRef() and locked->player_is_blocked()) {
-							locked->player_rules().ArmorUnequipped(state);
-						}
-					}
-					break;
+
+		// Call with the exclusive lock held, which also makes this the only consumer
+		static void DrainEquips(multivector& data) noexcept {
+			array<equip_delta, EquipQueueCapacity> batch;
+			for (;;) {
+				u32 count = 0;
+				while ((count < EquipQueueCapacity) and equip_queue.try_pop(batch[count])) {
+					++count;
 				}
-				case RE::TESObjectWEAP::FORMTYPE: {
-					if (static_cast<const RE::TESObjectWEAP*>(obj)->GetWeaponType() == RE::WeaponTypes::WEAPON_TYPE::kHandToHandMelee) {
-						return; // Ignore Fists
-					}
-					// Fallthrough because, besides the Fists check, Weapons and Spells do the exact same thing on unequip
-				}
-				case RE::SpellItem::FORMTYPE: {
-					const auto locked = locker.GetExclusive();
-					if (auto idx = locked->has_or_add(act); idx < locked->size()) {
-						EquipState& state = locked->equipstate(idx);
-						state.UpdateHands(act);
-						if (act->IsPlayerRef() and locked->player_is_blocked()) {
-							locked->player_rules().HandUnequipped(state.hands);
+				if (count == 0) {
+					return;
+				}
+				for (u32 k = 0, end = CoalesceEquips(batch.data(), count); k < end; ++k) {
+					const equip_delta& delta = batch[k];
+					if (const RE::ActorPtr act = delta.actor.get(); act and IsValidAddable(act.get())) {
+						if (const RE::TESBoundObject* obj = RE::TESForm::LookupByID<RE::TESBoundObject>(delta.form); obj and (obj->GetFormType() == delta.type)) {
+							ApplyEquip(data, act.get(), obj, delta.equipped);
 						}
 					}
-					break;
 				}
-				default: break;
+				if (count < EquipQueueCapacity) {
+					return; // Got all there was
 				}
 			}
 		}
+		static void DiscardEquips() noexcept {
+			const auto locked = locker.GetExclusive(); // Only to be the only consumer
+			for (equip_delta ignored{}; equip_queue.try_pop(ignored);) { ; }
+		}
+
+		static void QueueEquip(RE::Actor* act, const RE::TESBoundObject* obj, const bool equipped) noexcept {
+			if (!IsValidAddable(act)) {
+				return;
+			}
+			const RE::FormType type = obj->GetFormType();
+			if ((type != RE::TESObjectARMO::FORMTYPE) and (type != RE::TESObjectWEAP::FORMTYPE) and (type != RE::SpellItem::FORMTYPE)) {
+				return;
+			}
+			if ((type == RE::TESObjectWEAP::FORMTYPE) and (static_cast<const RE::TESObjectWEAP*>(obj)->GetWeaponType() == RE::WeaponTypes::WEAPON_TYPE::kHandToHandMelee)) {
+				return; // Ignore Fists
+			}
+			const u32 slots = (type == RE::TESObjectARMO::FORMTYPE) ? static_cast<const RE::TESObjectARMO*>(obj)->bipedModelData.bipedObjectSlots.underlying() : 0;
+			if (!act->IsPlayerRef() and equip_queue.try_push(equip_delta{ act, obj->GetFormID(), slots, type, equipped })) {
+				return;
+			}
+			// Player, or queue full. Apply everything queued so far, then this one.
+			const auto locked = locker.GetExclusive();
+			DrainEquips(*locked);
+			ApplyEquip(*locked, act, obj, equipped);
+		}
+
+		void ProcessEquip(RE::Actor* act, const RE::TESBoundObject* obj) noexcept { QueueEquip(act, obj, true); }
+		void ProcessUnequip(RE::Actor* act, const RE::TESBoundObject* obj) noexcept { QueueEquip(act, obj, false); }
 
 		void FastTravelEnd(const float hours) noexcept {
 			PlayerRules::FastTravelEnd(hours);
@@ -209,241 +297,523 @@ namespace Data {
 		}
 
 
-		void Update(const UpdateKinds kinds, const UpdateDeltas deltas) noexcept {
-			using namespace UpdateTypes;
-			alignas(64) static array<trivial_handle, MaxUpdateCount> handles{};			// 128 - 2 cachelines
-			alignas(64) static array<RE::ActorPtr, MaxUpdateCount> actptrs{};			// 256 - 4 cachelines
-			alignas(64) static array<main_out, MaxUpdateCount> mains{};					// 256 - 4 cachelines	Main thread pulls, for Fear
-			alignas(64) static ranks_and_oneofs pack{};									// 128 - 2 cachelines	ranks from Fear for main thread in first 1.5, misc in other 0.5
-			// Total 768 bytes, in 12 cachelines. Arrays in the first 11.5, and then some bytes for one-ofs and bookkeeping
-			
-			struct {
-				using Task_t = void(*)(void);
-				// Overwrites the oldest task to make room for the new one, even if that oldest task wasn't null.
-				void AddTask(Task_t task) noexcept {
-					tq[2] = tq[1];
-					tq[1] = tq[0];
-					tq[0] = task;
-				}
-				// Nulls all tasks.
-				void ClearTasks() noexcept {
-					tq[0] = nullptr;
-					tq[1] = nullptr;
-					tq[2] = nullptr;
-				}
-				// Queues and waits for all non-null tasks to finish executing on the main thread.
-				void RunTasks() noexcept {
-					if (const u32 count = CountTasks(); count != 0) {
-						const auto tasker = SKSE::GetTaskInterface();
-						if (!tasker) {
-							return;
-						}
-
-						std::atomic<bool> waiter{};
-						waiter.store(false, std::memory_order_release); // Required? Not if construction syncs but does it? Also, maybe sequential?
+		// Where update time goes, per phase, and per thread the phase runs on. Lock waits are their own phases, so stalls can be told apart from contention.
+		struct UpdatePhase {
+			enum Phase : u32 {
+				ZeroInvalidHandles,
+				ClearZeroHandles,
+				GetFilteredActors,
+				SwapAllocateMove,
+				InitNews,
+				GetMain,
+				GatherLockWait,
+				ComputeLockWait,
+				DrainEquips,
+				FearUpdate,
+				RulesUpdate,
+				SetRanks,
+				SetDebuffs,
+
+				Total
+			};
+			static constexpr array<string_view, Total> Names{
+				"zero_invalid_handles"sv, "clear_zero_handles"sv, "get_filtered_actors"sv, "swap_allocate_move"sv, "init_news"sv, "get_main"sv, "gather_lock_wait"sv,
+				"compute_lock_wait"sv, "drain_equips"sv, "Fear::Update"sv, "PlayerRules::Update"sv,
+				"set_ranks"sv, "set_debuffs"sv
+			};
+			static constexpr array<bool, Total> OnMainThread{
+				true, true, true, true, true, true, true,
+				false, false, false, false,
+				true, true
+			};
+		};
+		static array<Timing::latency_histogram, UpdatePhase::Total> phase_times{};
+		static std::atomic<u64> main_thread_ns{ 0 };
+		static std::atomic<u64> update_thread_ns{ 0 };
+		// Fear rank writes DiffRanks() batched, and those it skipped as unchanged, since the timings were last reset
+		static std::atomic<u64> rank_writes{ 0 };
+		static std::atomic<u64> rank_skips{ 0 };
+
+		static Timing::scoped_span TimePhase(const UpdatePhase::Phase phase) noexcept {
+			return Timing::scoped_span{ phase_times[phase], UpdatePhase::OnMainThread[phase] ? &main_thread_ns : &update_thread_ns };
+		}
+		static auto TimedExclusive(const UpdatePhase::Phase wait_phase) noexcept {
+			const auto span = TimePhase(wait_phase);
+			return locker.GetExclusive();
+		}
 
-						tasker->AddTask([&] {
-							if (waiter.load(std::memory_order_acquire) != false) { // For sync
-								return;
-							}
-							for (size_t i = 0; i < count; ++i) {
-								tq[i]();
-							}
-							waiter.store(true, std::memory_order_release);
-							waiter.notify_all();
-						});
+		static string UpdateTimingSummary() {
+			string ret = std::format("Update timings: main thread {} ms, update thread {} ms",
+				main_thread_ns.load(std::memory_order_relaxed) / 1'000'000, update_thread_ns.load(std::memory_order_relaxed) / 1'000'000);
+			ret += std::format("\n\tFear ranks: {} writes, {} skipped as unchanged", rank_writes.load(std::memory_order_relaxed), rank_skips.load(std::memory_order_relaxed));
+			for (u32 phase = 0; phase < UpdatePhase::Total; ++phase) {
+				const Timing::latency_histogram& hist = phase_times[phase];
+				if (hist.count() == 0) {
+					continue;
+				}
+				ret += std::format("\n\t{} ({}): {} runs, avg {} us, p50 < {} us, p99 < {} us, max {} us",
+					UpdatePhase::Names[phase], UpdatePhase::OnMainThread[phase] ? "main"sv : "update"sv, hist.count(),
+					std::chrono::duration_cast<microseconds>(hist.average()).count(), hist.quantile_upper(0.5).count(), hist.quantile_upper(0.99).count(),
+					std::chrono::duration_cast<microseconds>(hist.max()).count());
+			}
+			return ret;
+		}
+		static void ResetUpdateTimings() noexcept {
+			for (auto& hist : phase_times) {
+				hist.reset();
+			}
+			main_thread_ns.store(0, std::memory_order_relaxed);
+			update_thread_ns.store(0, std::memory_order_relaxed);
+			rank_writes.store(0, std::memory_order_relaxed);
+			rank_skips.store(0, std::memory_order_relaxed);
+		}
 
-						waiter.wait(false, std::memory_order_acquire); // Wait until not false
+		// Player debuff tiers as integer magnitudes, which is all the descriptions show, so the main thread is only bothered when one moves by a whole point.
+		// Each tier starts once the one before it gets far enough. 0 is off.
+		struct PlayerDebuffs {
+			enum Tier : u32 {
+				MSCW,	// Movement speed and carry weight
+				Crafts,
+				Resist,
+				Power,
 
-						ClearTasks();
-					}
-				}
-				// Executes given task immediately, bypassing (and not affecting) queue
-				void ExecuteImmediately(Task_t task) const noexcept {
-					if (const auto tasker = SKSE::GetTaskInterface(); tasker) {
-						std::atomic<bool> waiter{};
-						waiter.store(false, std::memory_order_release); // Required? Not if construction syncs but does it? Also, maybe sequential?
+				Total
+			};
+			using mags = array<u8, Total>;
+			static constexpr u8 Unknown = 0xFF; // Never a magnitude, so marks every tier changed
+			static constexpr u32 MaxCap = 75;
+
+			static constexpr mags FromTension(const float tension, const float willpower) noexcept {
+				const float mag_base = (tension - 1.0f) * (1.0f - willpower);
+				return mags{
+					scale(mag_base, 0.5f),			// Cap at 50 speed and 100 carry weight
+					scale(mag_base - 0.5f, 0.75f),	// Start after mscw gets capped. Cap at 75.
+					scale(mag_base - 1.0f, 0.75f),	// Start after craft reaches 50%. Cap at 75 magic resist and 225 armor.
+					scale(mag_base - 2.0f, 0.75f)	// Start a bit after resist gets capped. Cap at 75 weapon damage/spell power.
+				};
+			}
+		private:
+			static constexpr u8 scale(const float mag, const float cap) noexcept { return (mag > 0.0f) ? static_cast<u8>(std::min(mag, cap) * 100.0f) : 0; }
+		};
 
-						tasker->AddTask([&] {
-							if (waiter.load(std::memory_order_acquire) != false) { // For sync
-								return;
-							}
-							task();
-							waiter.store(true, std::memory_order_release);
-							waiter.notify_all();
-						});
+		// Default updates are pipelined between the update thread and the main thread, so the update thread never waits for a frame:
+		// a default update runs Fear and rules on the update_frame a main thread task gathered since the last one, then posts a task to gather into the other frame,
+		// and another main thread task applies the results (ranks, debuffs) whenever it runs. So Fear works on data gathered one update earlier.
+		// The next gather is only posted once the compute released the exclusive lock, so the main thread never waits out a compute, and the gather can't reorder rows under the frame being computed.
+		struct update_frame {
+			enum State : u32 {
+				Free,		// Unused. Only the update thread takes it out of this.
+				Gathering,	// A main thread task is filling it
+				Gathered,	// Waiting for the update thread
+				Applying	// A main thread task is applying its results
+			};
 
-						waiter.wait(false, std::memory_order_acquire); // Wait until not false
-					}
+			UpdateTypes::seeing_matrix seeing{};									// 16KiB	Main thread pulls, for Fear. Only the first actor_count rows of actor_count bits are touched, so 32 actors use 512B of it.
+			array<RE::ActorPtr, UpdateTypes::MaxUpdateCount> actptrs{};			// 2KiB
+			array<trivial_handle, UpdateTypes::MaxUpdateCount> handles{};		// 1KiB
+			UpdateTypes::ranks_and_oneofs pack{};								// 832B	ranks from Fear for main thread, then misc in the last cacheline
+			array<UpdateTypes::main_out, UpdateTypes::MaxUpdateCount> mains{};	// 512B	Main thread pulls, for Fear
+			array<UpdateTypes::rank_write, UpdateTypes::MaxUpdateCount * 3> rank_writes{};	// 3KiB	Ranks that changed, for main thread
+			u32 rank_write_count{ 0 };
+			PlayerDebuffs::mags debuffs{};		// Player debuff magnitudes to apply
+			u32 debuffs_changed{ 0 };			// Bit per tier whose magnitude changed since it was last applied
+			Timing::nanoseconds gather_cost{ 0 };	// How long the main thread spent gathering it
+			std::atomic<State> state{ Free };
+			bool apply_ranks{ false };
+			bool apply_debuffs{ false };
+
+			void release_actors() noexcept {
+				for (auto& ptr : actptrs) {
+					ptr.reset(); // Let go of the shared pointers
 				}
-			private:
-				u32 CountTasks() const noexcept { return static_cast<u32>((tq[0] != nullptr) + (tq[1] != nullptr) + (tq[2] != nullptr)); }
-				array<void(*)(), 3> tq{}; // Only need 2 atm
-			} static task_queue{}; // Holds a queue of up to 3 tasks to execute on the main thread.
-
-			static auto get_filtered_actors = [] {
-				const RE::ProcessLists* lists{ RE::ProcessLists::GetSingleton() };
-				const trivial_handle ph{ RE::PlayerCharacter::GetSingleton() };
-				RE::ActorPtr pptr = ph.get();
-				if ((pptr != nullptr) bitand (lists != nullptr)) {
-					pack.now = GameDataUtils::DaysPassed();
-					pack.follower = static_cast<RE::PlayerCharacter*>(pptr.get())->teammateCount != 0;
-					handles[0] = ph;
-					actptrs[0] = std::move(pptr);
-					const u32 max_i = std::min<u32>(lists->highActorHandles.size(), MaxUpdateCount - 1);
-					u32 next = 1;
-					for (u32 i = 0; i < max_i; ++i) {
-						const trivial_handle h = lists->highActorHandles[i];
-						if (RE::ActorPtr ptr = h.get(); ptr and IsValidAddable(ptr.get())) {
-							handles[next] = h;
-							actptrs[next] = std::move(ptr);
-							++next;
-						}
+			}
+		};
+		alignas(64) static array<update_frame, 2> frames{};
+
+		// Main thread
+		static void GetFilteredActors(update_frame& frame) noexcept {
+			const RE::ProcessLists* lists{ RE::ProcessLists::GetSingleton() };
+			const trivial_handle ph{ RE::PlayerCharacter::GetSingleton() };
+			RE::ActorPtr pptr = ph.get();
+			if ((pptr != nullptr) bitand (lists != nullptr)) {
+				UpdateTypes::ranks_and_oneofs& pack = frame.pack;
+				pack.now = GameDataUtils::DaysPassed();
+				pack.follower = static_cast<RE::PlayerCharacter*>(pptr.get())->teammateCount != 0;
+				frame.handles[0] = ph;
+				frame.actptrs[0] = std::move(pptr);
+				const u32 max_i = std::min<u32>(lists->highActorHandles.size(), UpdateTypes::MaxUpdateCount - 1);
+				u32 next = 1;
+				for (u32 i = 0; i < max_i; ++i) {
+					const trivial_handle h = lists->highActorHandles[i];
+					if (RE::ActorPtr ptr = h.get(); ptr and IsValidAddable(ptr.get())) {
+						frame.handles[next] = h;
+						frame.actptrs[next] = std::move(ptr);
+						++next;
 					}
-					pack.actor_count = next;
-					// Log::Error("\tUpdating: get_filtered_actors grabbed {} valids out of {}"sv, pack.actor_count, lists->highActorHandles.size());
 				}
-			};
-			static auto get_main = [] {
-				const u32 end = pack.actor_count;
-				for (u32 i = 0; i < end; ++i) {
-					mains[i].ParseActor(actptrs[i].get());
-				}
-				for (u32 i = 0; i < end; ++i) {
-					for (u32 j = 0; j < end; ++j) {
-						mains[i].seeing.set_if_val(j, actptrs[i]->RequestDetectionLevel(actptrs[j].get()) > 0);
+				pack.actor_count = next;
+				// Log::Error("\tUpdating: get_filtered_actors grabbed {} valids out of {}"sv, pack.actor_count, lists->highActorHandles.size());
+			}
+		}
+		// Main thread
+		static void GetMain(update_frame& frame) noexcept {
+			const u32 end = frame.pack.actor_count;
+			static detection_cache detections{};
+			for (u32 i = 0; i < end; ++i) {
+				frame.mains[i].ParseActor(frame.actptrs[i].get());
+			}
+			if (detection_cache_stale.exchange(false, std::memory_order_relaxed)) {
+				detections.clear();
+			}
+			detections.remap(frame.handles.data(), end);
+			const detection_cache::stats stats = detections.refresh(
+				[&frame](const u32 i, const u32 j) { return frame.actptrs[i]->RequestDetectionLevel(frame.actptrs[j].get()) > 0; },
+				[&frame](const u32 i) { return (i == 0) or frame.mains[i].combat; },
+				microseconds{ detection_budget_us.load(std::memory_order_relaxed) },
+				frame.seeing);
+			detection_stats.pairs.store(stats.pairs, std::memory_order_relaxed);
+			detection_stats.refreshed.store(stats.refreshed, std::memory_order_relaxed);
+			detection_stats.unknown.store(stats.unknown, std::memory_order_relaxed);
+			detection_stats.max_age.store(stats.max_age, std::memory_order_relaxed);
+			detection_stats.spent_us.store(static_cast<u32>(stats.spent.count()), std::memory_order_relaxed);
+		}
+		enum : size_t { ColdSweepBudget = 256 }; // Cold rows looked up per long update, to drop those of actors gone since
+		// Main thread. Gets exclusive lock.
+		static void ZeroInvalidHandles() noexcept {
+			const auto locked = TimedExclusive(UpdatePhase::GatherLockWait);
+			{
+				const auto span = TimePhase(UpdatePhase::ZeroInvalidHandles);
+				for (auto& handle : locked->all_handles()) {
+					if (RE::Actor* act = handle.get().get(); !act or !IsValidKeepable(act)) {
+						handle.reset();
 					}
 				}
-			};
-			// Gets exclusive lock
-			static auto init_news_and_get_main = [] {
-				locker.GetExclusive()->init_news(actptrs, pack, FearEnabled);
-				get_main();
-			};
-			static auto set_desc = [] {
-				const i32 mag = pack.mag;
-				SetNthEffectDescription(::PlayerRules::Spell(::PlayerRules::SPL::RecentDodges), 0, "You have Dodged " + to_string(mag) + " time" + ((mag != 1) ? "s" : "") + " recently");
-			};
-			static auto set_ranks = [] {
-				for (u32 i = 0, end = pack.actor_count; i < end; ++i) {
-					actptrs[i]->AddToFaction(::Fear::Faction(::Fear::FAC::Fear), pack.ranks[i][0]);
-					actptrs[i]->AddToFaction(::Fear::Faction(::Fear::FAC::Thrillseeking), pack.ranks[i][1]);
-					actptrs[i]->AddToFaction(::Fear::Faction(::Fear::FAC::Thrillseeker), pack.ranks[i][2]);
+			}
+			const auto span = TimePhase(UpdatePhase::ClearZeroHandles);
+			locked->demote_unseen(cold_after.load(std::memory_order_relaxed));
+			locked->sweep_cold(ColdSweepBudget);
+			locked->clear_zero_handles();
+			locked->forget_applied_ranks(); // Every long update, in case anything else changed them
+		}
+		// Main thread. Gets exclusive lock.
+		static void GatherFrame(update_frame& frame, const bool long_update) noexcept {
+			const auto start = Timing::clock::now();
+			if (long_update) { // Do the long first because it removes invalid elements
+				ZeroInvalidHandles();
+			}
+			frame.pack.reset();
+			{
+				const auto span = TimePhase(UpdatePhase::GetFilteredActors);
+				GetFilteredActors(frame);
+			}
+			if (frame.pack.actor_count != 0) {
+				if (const auto locked = TimedExclusive(UpdatePhase::GatherLockWait); [&] { const auto span = TimePhase(UpdatePhase::SwapAllocateMove); return locked->swap_allocate_move(frame.handles, frame.actptrs, frame.pack); }()) {
+					const auto span = TimePhase(UpdatePhase::InitNews);
+					locked->init_news(frame.actptrs, frame.pack, FearEnabled);
 				}
-			};
-			static auto set_debuffs = [] {
-				RE::SpellItem* const mscw = ::PlayerRules::Spell(::PlayerRules::SPL::DebuffMSCW);
-				RE::SpellItem* const craft = ::PlayerRules::Spell(::PlayerRules::SPL::DebuffCrafts);
-				RE::SpellItem* const resist = ::PlayerRules::Spell(::PlayerRules::SPL::DebuffResist);
-				RE::SpellItem* const power = ::PlayerRules::Spell(::PlayerRules::SPL::DebuffPower);
-
-				RE::Actor* pptr = actptrs[0].get();
-
-				pptr->RemoveSpell(mscw); // Always clear all debuffs first. Must remove anyway to reapply.
-				pptr->RemoveSpell(craft);
-				pptr->RemoveSpell(resist);
-				pptr->RemoveSpell(power);
-				
-				const float wp_mod = 1.0f - pack.player_willpower;
-				const float mag_base = (pack.player_tension - 1.0f) * wp_mod;
+				const auto span = TimePhase(UpdatePhase::GetMain);
+				GetMain(frame);
+			}
+			frame.gather_cost = Timing::clock::now() - start;
+			frame.state.store(update_frame::Gathered, std::memory_order_release);
+		}
 
-				if (mag_base > 0.0f) {
-					const float scaled100 = std::min<float>(mag_base, 0.5f) * 100.0f; // Cap at 50 speed and 100 carry weight
-					SetNthEffectMagnitude(mscw, 0, scaled100);
-					pptr->AddSpell(mscw);
-					const u32 trunc = static_cast<u32>(scaled100);
-					SetNthEffectDescription(mscw, 0, "Movement Speed is reduced by <" + to_string(trunc) + ">, and Carry Weight by <" + to_string(trunc * 2) + '>');
+		// Main thread
+		static void SetRecentDodgesDesc(const i32 mag) noexcept {
+			array<char, 64> buf;
+			const auto res = std::format_to_n(buf.data(), buf.size() - 1, "You have Dodged {} time{} recently", mag, (mag != 1) ? "s"sv : ""sv);
+			*res.out = '\0';
+			SetNthEffectDescription(::PlayerRules::Spell(::PlayerRules::SPL::RecentDodges), 0, buf.data());
+		}
+		// Main thread
+		static void SetRanks(update_frame& frame) noexcept {
+			const array<RE::TESFaction*, 3> factions{ ::Fear::Faction(::Fear::FAC::Fear), ::Fear::Faction(::Fear::FAC::Thrillseeking), ::Fear::Faction(::Fear::FAC::Thrillseeker) };
+			for (const UpdateTypes::rank_write write : std::span{ frame.rank_writes.data(), frame.rank_write_count }) {
+				frame.actptrs[write.actor]->AddToFaction(factions[write.faction], write.rank);
+			}
+		}
+		// Main thread. Descriptions of every magnitude a tier has shown so far, formatted the first time each is needed.
+		static const string& DebuffDescription(const PlayerDebuffs::Tier tier, const u32 mag) {
+			static array<array<string, PlayerDebuffs::MaxCap + 1>, PlayerDebuffs::Total> cache{};
+			string& desc = cache[tier][mag];
+			if (desc.empty()) {
+				switch (tier) {
+				case PlayerDebuffs::MSCW: desc = std::format("Movement Speed is reduced by <{}>, and Carry Weight by <{}>", mag, mag * 2); break;
+				case PlayerDebuffs::Crafts: desc = std::format("Smithing, Alchemy, and Enchanting are <{}>% weaker", mag); break;
+				case PlayerDebuffs::Resist: desc = std::format("Magic Resistance is reduced by <{}>% and Armor by <{}>", mag, mag * 5); break;
+				case PlayerDebuffs::Power: desc = std::format("Weapons deal <{0}>% less damage and Illusion, Conjuration, Destruction, Alteration, and Restoration are <{0}>% weaker", mag); break;
+				default: break;
 				}
-				else {
-					return; // Below checks would fail
+			}
+			return desc;
+		}
+		// Main thread. Only touches the tiers whose magnitude changed. Those get removed, and re-added if still on, since the magnitude only takes when added.
+		static void SetDebuffs(update_frame& frame) noexcept {
+			static constexpr array<::PlayerRules::SPL, PlayerDebuffs::Total> spells{ ::PlayerRules::SPL::DebuffMSCW, ::PlayerRules::SPL::DebuffCrafts, ::PlayerRules::SPL::DebuffResist, ::PlayerRules::SPL::DebuffPower };
+
+			RE::Actor* pptr = frame.actptrs[0].get();
+			for (u32 t = 0; t < PlayerDebuffs::Total; ++t) {
+				if (((frame.debuffs_changed >> t) & 1) == 0) {
+					continue;
+				}
+				const auto tier = static_cast<PlayerDebuffs::Tier>(t);
+				RE::SpellItem* const spell = ::PlayerRules::Spell(spells[t]);
+				pptr->RemoveSpell(spell);
+				const u32 mag = frame.debuffs[t];
+				if (mag == 0) {
+					continue;
+				}
+				const float mag100 = static_cast<float>(mag);
+				switch (tier) {
+				case PlayerDebuffs::MSCW: SetNthEffectMagnitude(spell, 0, mag100); break;
+				case PlayerDebuffs::Crafts: SetEffectsMagnitude(spell, 0, 1, mag100); break;
+				case PlayerDebuffs::Resist: SetNthEffectMagnitude(spell, 0, mag100); break;
+				case PlayerDebuffs::Power:
+					SetNthEffectMagnitude(spell, 0, mag100 * 0.01f); // AttackDamageMult 1=>100%
+					SetEffectsMagnitude(spell, 1, 3, mag100); // <skill>PowerMod 100=>100%
+					break;
+				default: break;
 				}
+				pptr->AddSpell(spell);
+				SetNthEffectDescription(spell, 0, DebuffDescription(tier, mag));
+			}
+		}
+		// Main thread
+		static void ApplyFrame(update_frame& frame) noexcept {
+			if (frame.apply_ranks) {
+				const auto span = TimePhase(UpdatePhase::SetRanks);
+				SetRanks(frame);
+			}
+			if (frame.apply_debuffs) {
+				const auto span = TimePhase(UpdatePhase::SetDebuffs);
+				SetDebuffs(frame);
+			}
+			frame.release_actors();
+			frame.state.store(update_frame::Free, std::memory_order_release);
+		}
 
-				if (const float mag_craft = mag_base - 0.5f; mag_craft > 0.0f) { // Start applying after mscw gets capped
-					const float scaled100 = std::min<float>(mag_craft, 0.75f) * 100.0f; // Cap at 75
-					SetEffectsMagnitude(craft, 0, 1, scaled100);
-					pptr->AddSpell(craft);
-					SetNthEffectDescription(craft, 0, "Smithing, Alchemy, and Enchanting are <" + to_string(static_cast<u32>(scaled100)) + ">% weaker");
-				}
-				else {
-					return; // Below checks would fail
+		// Update thread. Fills in what the frame saw and whether that differs from the last frame computed.
+		static void ObserveFrame(const update_frame& frame, UpdateActivity& activity) noexcept {
+			static u64 last_signature{ 0 };
+			static u32 last_in_combat{ 0 };
+
+			u64 signature = 0; // Order-independent, since gathering order follows the engine's process lists
+			u32 in_combat = 0;
+			for (u32 i = 0, end = frame.pack.actor_count; i < end; ++i) {
+				const u64 h = frame.handles[i].native_handle() * 0x9E3779B97F4A7C15ull;
+				signature += h ^ (h >> 29);
+				in_combat += frame.mains[i].combat;
+			}
+			activity.actor_count = frame.pack.actor_count;
+			activity.in_combat = in_combat;
+			activity.changed = (signature != last_signature) or (in_combat != last_in_combat);
+			last_signature = signature;
+			last_in_combat = in_combat;
+		}
+
+		// Update thread, with the exclusive lock held. Batches the ranks that differ from what each actor was last given, and takes them as given.
+		static void DiffRanks(multivector& data, update_frame& frame) noexcept {
+			u32 writes = 0;
+			for (u32 i = 0, end = frame.pack.actor_count; i < end; ++i) {
+				UpdateTypes::applied_ranks& applied = data.applied(i);
+				const array<i8, 3>& ranks = frame.pack.ranks[i];
+				for (u32 f = 0; f < 3; ++f) {
+					if (ranks[f] != applied[f]) {
+						frame.rank_writes[writes++] = UpdateTypes::rank_write{ static_cast<u16>(i), static_cast<u8>(f), ranks[f] };
+						applied[f] = ranks[f];
+					}
 				}
+			}
+			frame.rank_write_count = writes;
+			rank_writes.fetch_add(writes, std::memory_order_relaxed); // Logged with the timings every long update, rather than a line per update
+			rank_skips.fetch_add((frame.pack.actor_count * 3) - writes, std::memory_order_relaxed);
+		}
+
+		// Update thread. Quantizes the player's debuffs and marks the tiers that differ from what was last applied, taking them as applied.
+		static void DiffDebuffs(update_frame& frame) noexcept {
+			static PlayerDebuffs::mags applied{};
+			if (debuffs_stale.exchange(false, std::memory_order_relaxed)) {
+				applied.fill(PlayerDebuffs::Unknown);
+			}
+			frame.debuffs = PlayerDebuffs::FromTension(frame.pack.player_tension, frame.pack.player_willpower);
+			frame.debuffs_changed = 0;
+			for (u32 t = 0; t < PlayerDebuffs::Total; ++t) {
+				frame.debuffs_changed |= static_cast<u32>(frame.debuffs[t] != applied[t]) << t;
+			}
+			applied = frame.debuffs;
+		}
+
+		// Update thread, with the exclusive lock held. Returns whether there is anything to apply. Fills in trace if given one.
+		static bool ComputeFrame(multivector& data, update_frame& frame, const milliseconds delta, UpdateTrace::record* trace) noexcept {
+			UpdateTypes::ranks_and_oneofs& pack = frame.pack;
+			const u32 count = pack.actor_count;
+			if (count == 0) {
+				return false;
+			}
+			// Rows may have moved since gathering (a revert or erasures in between), in which case skip rather than mix actors up
+			if ((data.size() < count) or !std::equal(frame.handles.begin(), frame.handles.begin() + count, data.all_handles().begin())) {
+				return false;
+			}
+			{
+				const auto span = TimePhase(UpdatePhase::DrainEquips);
+				DrainEquips(data); // Exposures up to date for Fear. Only appends rows, so the frame's stay put.
+			}
+
+			pack.need_ranks = FearEnabled;
+			{
+				const auto span = TimePhase(UpdatePhase::FearUpdate);
+				Fear::Update(delta, data.all_fears(), data.all_exposures(), frame.mains, frame.seeing, frame.actptrs, frame.handles, pack, trace);
+			}
+			frame.apply_ranks = false;
+			if (FearEnabled) { // Only affect factions if our Fear is used
+				DiffRanks(data, frame);
+				frame.apply_ranks = frame.rank_write_count != 0;
+			}
+			frame.apply_debuffs = false;
 
-				if (const float mag_resist = mag_base - 1.0f; mag_resist > 0.0f) { // Start applying after craft reaches 50%
-					const float scaled100 = std::min<float>(mag_resist, 0.75f) * 100.0f; // Cap at 75 magic resist and 225 armor
-					SetNthEffectMagnitude(resist, 0, scaled100);
-					pptr->AddSpell(resist);
-					const u32 trunc = static_cast<u32>(scaled100);
-					SetNthEffectDescription(resist, 0, "Magic Resistance is reduced by <" + to_string(trunc) + ">% and Armor by <" + to_string(trunc * 5) + '>');
+			if (data.player_is_blocked()) {
+				const auto span = TimePhase(UpdatePhase::RulesUpdate);
+				rules_info& prules = data.player_rules();
+				const float day_delta = PlayerRules::GetDayDelta(pack.now);
+				if (trace) {
+					trace->rules_inputs(prules, data.equipstate(0), day_delta, pack.player_tension, pack.follower);
+				}
+				prules.Update(data.equipstate(0), day_delta, pack.player_tension, pack.follower);
+				if (trace) {
+					trace->rules_outputs(prules);
 				}
-				else {
-					return; // Below checks would fail
+				pack.player_willpower = prules.Exp().get();
+				if (DebuffsEnabled) {
+					DiffDebuffs(frame);
+					frame.apply_debuffs = frame.debuffs_changed != 0;
 				}
+			}
+			return frame.apply_ranks or frame.apply_debuffs;
+		}
+
+		// Queues task on the main thread without waiting for it
+		template<typename Task>
+		static bool PostTask(Task&& task) noexcept {
+			if (const auto tasker = SKSE::GetTaskInterface(); tasker) {
+				tasker->AddTask(std::forward<Task>(task));
+				return true;
+			}
+			return false;
+		}
 
-				if (const float mag_power = mag_base - 2.0f; mag_power > 0.0f) { // Start applying a bit after resist gets capped
-					const float scaled1 = std::min<float>(mag_power, 0.75f); // Cap at 75 weapon damage/spell power
-					const float scaled100 = scaled1 * 100.0f;
-					SetNthEffectMagnitude(power, 0, scaled1); // AttackDamageMult 1=>100%
-					SetEffectsMagnitude(power, 1, 3, scaled100); // <skill>PowerMod 100=>100%
-					pptr->AddSpell(power);
-					const string trunc{ to_string(static_cast<u32>(scaled100)) };
-					SetNthEffectDescription(power, 0, "Weapons deal <" + trunc + ">% less damage and Illusion, Conjuration, Destruction, Alteration, and Restoration are <" + trunc + ">% weaker");
+		// Update thread. Starts or stops the trace as asked, and gives the record to fill in if tracing.
+		static UpdateTrace::record* SyncTrace(UpdateTrace::recorder& recorder) noexcept {
+			static UpdateTrace::record rec{};
+			if (const bool wanted = trace_wanted.load(std::memory_order_relaxed); wanted != recorder.is_open()) {
+				if (!wanted) {
+					recorder.close();
+				} else if (const auto dir = SKSE::log::log_directory(); !dir or !recorder.open((*dir / (string{ Version::PROJECT } + "_trace.bin")).string())) {
+					trace_wanted.store(false, std::memory_order_relaxed);
 				}
+			}
+			if (!recorder.is_open()) {
+				return nullptr;
+			}
+			rec.reset();
+			return &rec;
+		}
 
-			};
-			// Gets exclusive lock
-			static auto zero_invalid_handles = [] {
-				for (auto& handle : locker.GetExclusive()->all_handles()) {
-					if (RE::Actor* act = handle.get().get(); !act or !IsValidKeepable(act)) {
-						handle.reset();
-					}
+		// Update thread. Decays recent dodges, and refreshes their description when the count shown is off. Returns whether any are left.
+		static bool UpdateShort(const milliseconds delta) noexcept {
+			i32 left = -1;
+			{
+				const auto locked = locker.GetExclusive();
+				if (locked->player_is_blocked()) {
+					left = PlayerRules::UpdateShort(locked->player_rules(), delta);
 				}
-			};
+			}
+			if ((left >= 0) and (left != shown_recent_dodges.load(std::memory_order_relaxed))) {
+				if (PostTask([left] { SetRecentDodgesDesc(left); })) {
+					shown_recent_dodges.store(left, std::memory_order_relaxed);
+				}
+			}
+			return left > 0;
+		}
+
+		UpdateActivity Update(const UpdateKinds kinds, const UpdateDeltas deltas) noexcept {
+			static milliseconds uncomputed{ 0ms }; // Default update time not yet accounted for by Fear, in case some updates had nothing gathered
 
 			// Log::Info("Update!"sv);
 
-			if (kinds.is_marked(UpdateKinds::LongUpdate)) { // Do the long first because it removes invalid elements
-				task_queue.ExecuteImmediately(zero_invalid_handles);
-				locker.GetExclusive()->clear_zero_handles();
+			const auto start = Timing::clock::now();
+			UpdateActivity activity{};
+			if (kinds.is_marked(UpdateKinds::ShortUpdate)) {
+				activity.recent_dodges = UpdateShort(deltas.delta_short);
 			}
 
-			if (kinds.is_marked(UpdateKinds::DefaultUpdate)) {
-				task_queue.ExecuteImmediately(get_filtered_actors);
+			const bool long_update = kinds.is_marked(UpdateKinds::LongUpdate);
+			if (long_update) {
+				Log::Info("{}"sv, UpdateTimingSummary()); // Every long update. Main thread phases lag behind by however long their tasks take to run.
+			}
 
-				// Log::Info("Default update with {} actors"sv, pack.actor_count);
+			if (!kinds.is_marked(UpdateKinds::DefaultUpdate)) {
+				if (long_update) {
+					(void)PostTask(ZeroInvalidHandles);
+				}
+				return activity;
+			}
+			uncomputed += deltas.delta_default;
+			static UpdateTrace::recorder trace_recorder{};
+			UpdateTrace::record* const trace = SyncTrace(trace_recorder);
+
+			// At most one frame is ever gathering, so one is gathered (or neither), and the other is free to gather into unless still applying
+			update_frame* gathered = nullptr;
+			update_frame* idle = nullptr;
+			bool gathering = false;
+			for (update_frame& frame : frames) {
+				switch (frame.state.load(std::memory_order_acquire)) {
+				case update_frame::Gathered: gathered = &frame; break;
+				case update_frame::Free: idle = &frame; break;
+				case update_frame::Gathering: gathering = true; break;
+				default: break;
+				}
+			}
 
-				if (pack.actor_count != 0) {
-					if (locker.GetExclusive()->swap_allocate_move(handles, actptrs, pack)) {
-						task_queue.ExecuteImmediately(init_news_and_get_main);
-					}
-					else {
-						task_queue.ExecuteImmediately(get_main);
-					}
+			bool apply = false;
+			if (gathered) {
+				const auto locked = TimedExclusive(UpdatePhase::ComputeLockWait);
+				apply = ComputeFrame(*locked, *gathered, uncomputed, trace);
+				uncomputed = 0ms;
+			}
 
-					const auto locked = locker.GetExclusive();
+			// Only after the compute released the lock, so the gather never waits on it on the main thread, and can't reorder rows under the frame being computed
+			bool long_posted = false;
+			if (idle and !gathering) {
+				idle->state.store(update_frame::Gathering, std::memory_order_relaxed);
+				if (PostTask([idle, long_update] { GatherFrame(*idle, long_update); })) {
+					long_posted = long_update;
+				} else {
+					idle->state.store(update_frame::Free, std::memory_order_relaxed);
+				}
+			}
+			if (long_update and !long_posted) {
+				(void)PostTask(ZeroInvalidHandles);
+			}
+			if (trace and !trace->empty() and !trace_recorder.write(*trace)) { // Outside the lock
+				trace_wanted.store(false, std::memory_order_relaxed);
+			}
 
-					pack.need_ranks = FearEnabled;
-					Fear::Update(deltas.delta_default, locked->all_fears(), locked->all_equips(), mains, actptrs, pack);
-					if (FearEnabled) { // Only affect factions if our Fear is used
-						task_queue.AddTask(set_ranks);
+			if (gathered) {
+				ObserveFrame(*gathered, activity);
+				activity.cost = std::chrono::ceil<milliseconds>((Timing::clock::now() - start) + gathered->gather_cost);
+				gathered->state.store(update_frame::Applying, std::memory_order_relaxed);
+				if (!apply or !PostTask([gathered] { ApplyFrame(*gathered); })) {
+					if (apply and gathered->apply_ranks) {
+						locker.GetExclusive()->forget_applied_ranks(); // Never given after all
 					}
-
-					if (locked->player_is_blocked()) {
-						locked->player_rules().Update(locked->equipstate(0), PlayerRules::GetDayDelta(pack.now), pack.player_tension, pack.follower);
-						pack.player_willpower = locked->player_rules().Exp().get();
-						if (DebuffsEnabled) {
-							task_queue.AddTask(set_debuffs);
-						}
+					if (apply and gathered->apply_debuffs) {
+						debuffs_stale.store(true, std::memory_order_relaxed);
 					}
+					gathered->release_actors();
+					gathered->state.store(update_frame::Free, std::memory_order_release);
 				}
-
-				task_queue.RunTasks(); // Don't need the lock for post-tasks
-			}
-
-
-			for (auto& ptr : actptrs) {
-				ptr.reset(); // Let go of the shared pointers
 			}
-
+			return activity;
 		}
 
 
@@ -471,21 +841,24 @@ namespace Data {
 
 
 		bool Save(SKSE::SerializationInterface& intfc) noexcept {
-			if (!intfc.OpenRecord(SerializationType, SerializationVersion)) {
+			const auto fmt = static_cast<ActorRecords::format>(save_format.load(std::memory_order_relaxed));
+			if (!intfc.OpenRecord(SerializationType, ActorRecords::RecordVersion(fmt))) {
 				return false;
 			}
-			return locker.GetExclusive()->Save(intfc) and Fear::Save(intfc) and PlayerRules::Save(intfc);
+			const auto locked = locker.GetExclusive();
+			DrainEquips(*locked);
+			return locked->Save(intfc, fmt) and Fear::Save(intfc) and PlayerRules::Save(intfc);
 		}
 
 		bool Load(SKSE::SerializationInterface& intfc, u32 version) noexcept {
-			if (version != SerializationVersion) {
-				Log::Error("Serialization version out of date. Read <{}>, expected <{}>. Deserialization aborted."sv, version, SerializationVersion);
+			if ((version == 0) or (version > SerializationVersion)) { // Older versions are migrated
+				Log::Error("Serialization version unknown. Read <{}>, expected up to <{}>. Deserialization aborted."sv, version, SerializationVersion);
 				return false;
 			}
-			return locker.GetExclusive()->Load(intfc) and Fear::Load(intfc) and PlayerRules::Load(intfc);
+			return locker.GetExclusive()->Load(intfc, version) and Fear::Load(intfc) and PlayerRules::Load(intfc);
 		}
 
-		void Revert() noexcept { locker.GetExclusive()->clear(); Fear::Revert(); PlayerRules::Revert(); }
+		void Revert() noexcept { DiscardEquips(); locker.GetExclusive()->clear(); Fear::Revert(); PlayerRules::Revert(); detection_cache_stale.store(true, std::memory_order_relaxed); shown_recent_dodges.store(-1, std::memory_order_relaxed); debuffs_stale.store(true, std::memory_order_relaxed); }
 
 	}
 
@@ -928,8 +1301,16 @@ namespace Data {
 	// Fear Papyrus functions
 	namespace Functions {
 
+		// Takes act's row out of cold first, if it waits there, so lookups under the shared lock find it
+		static void TakeCold(RE::Actor* act) noexcept {
+			if (locker.GetShared()->has_cold(act)) {
+				(void)locker.GetExclusive()->find_or_take(act);
+			}
+		}
+
 		static float GetFear(StaticFunc, RE::Actor* act) {
 			if (act) {
+				TakeCold(act);
 				const auto locked = locker.GetShared();
 				if (auto idx = locked->find_index(act); locked->is_valid(idx)) {
 					// Log::Info("GetFear returning {} fear for {:08X}"sv, locked->fear(idx).fear.get(), act->formID);
@@ -943,6 +1324,7 @@ namespace Data {
 		}
 		static float GetThrillseeking(StaticFunc, RE::Actor* act) {
 			if (act) {
+				TakeCold(act);
 				const auto locked = locker.GetShared();
 				if (auto idx = locked->find_index(act); locked->is_valid(idx)) {
 					return locked->fear(idx).thrillseeking;
@@ -952,6 +1334,7 @@ namespace Data {
 		}
 		static bool GetIsThrillseeker(StaticFunc, RE::Actor* act) {
 			if (act) {
+				TakeCold(act);
 				const auto locked = locker.GetShared();
 				if (auto idx = locked->find_index(act); locked->is_valid(idx)) {
 					return locked->fear(idx).thrillseeking >= 0.5f;
@@ -961,6 +1344,7 @@ namespace Data {
 		}
 		static float GetFearsFemale(StaticFunc, RE::Actor* act) {
 			if (act) {
+				TakeCold(act);
 				const auto locked = locker.GetShared();
 				if (auto idx = locked->find_index(act); locked->is_valid(idx)) {
 					return locked->fear(idx).fears_female;
@@ -970,6 +1354,7 @@ namespace Data {
 		}
 		static float GetFearsMale(StaticFunc, RE::Actor* act) {
 			if (act) {
+				TakeCold(act);
 				const auto locked = locker.GetShared();
 				if (auto idx = locked->find_index(act); locked->is_valid(idx)) {
 					return locked->fear(idx).fears_male;
@@ -979,6 +1364,7 @@ namespace Data {
 		}
 		static float GetLastRestDay(StaticFunc, RE::Actor* act) {
 			if (act) {
+				TakeCold(act);
 				const auto locked = locker.GetShared();
 				if (auto idx = locked->find_index(act); locked->is_valid(idx)) {
 					return locked->fear(idx).last_rest_day.value_or(-1.0f);
@@ -988,6 +1374,7 @@ namespace Data {
 		}
 		static string GetLastRestDayStr(StaticFunc, RE::Actor* act) {
 			if (act) {
+				TakeCold(act);
 				const auto locked = locker.GetShared();
 				if (auto idx = locked->find_index(act); locked->is_valid(idx) and locked->fear(idx).last_rest_day.has_value()) {
 					return StringUtils::GetTimeString(locked->fear(idx).last_rest_day.value());
@@ -997,6 +1384,7 @@ namespace Data {
 		}
 		static float GetDaysSinceRest(StaticFunc, RE::Actor* act) {
 			if (act) {
+				TakeCold(act);
 				const auto locked = locker.GetShared();
 				if (auto idx = locked->find_index(act); locked->is_valid(idx) and locked->fear(idx).last_rest_day.has_value()) {
 					return GameDataUtils::DaysPassed() - locked->fear(idx).last_rest_day.value();
@@ -1008,7 +1396,7 @@ namespace Data {
 		static float SetFear(StaticFunc, RE::Actor* act, const float value) {
 			if (act) {
 				const auto locked = locker.GetExclusive();
-				if (auto idx = locked->find_index(act); locked->is_valid(idx)) {
+				if (auto idx = locked->find_or_take(act); locked->is_valid(idx)) {
 					locked->fear(idx).fear = (value * 0.01f);
 					if (::Fear::FormsFilled()) {
 						act->AddToFaction(::Fear::Faction(::Fear::FAC::Fear), locked->fear(idx).FearRank());
@@ -1021,7 +1409,7 @@ namespace Data {
 		static float SetThrillseeking(StaticFunc, RE::Actor* act, const float value) {
 			if (act) {
 				const auto locked = locker.GetExclusive();
-				if (auto idx = locked->find_index(act); locked->is_valid(idx)) {
+				if (auto idx = locked->find_or_take(act); locked->is_valid(idx)) {
 					locked->fear(idx).thrillseeking = value;
 					if (::Fear::FormsFilled()) {
 						act->AddToFaction(::Fear::Faction(::Fear::FAC::Thrillseeking), locked->fear(idx).ThrillseekingRank());
@@ -1035,7 +1423,7 @@ namespace Data {
 		static float SetFearsFemale(StaticFunc, RE::Actor* act, const float value) {
 			if (act) {
 				const auto locked = locker.GetExclusive();
-				if (auto idx = locked->find_index(act); locked->is_valid(idx)) {
+				if (auto idx = locked->find_or_take(act); locked->is_valid(idx)) {
 					locked->fear(idx).fears_female = value;
 					if (::Fear::FormsFilled()) {
 						act->AddToFaction(::Fear::Faction(::Fear::FAC::FearsFemale), locked->fear(idx).FearsFemaleRank());
@@ -1048,7 +1436,7 @@ namespace Data {
 		static float SetFearsMale(StaticFunc, RE::Actor* act, const float value) {
 			if (act) {
 				const auto locked = locker.GetExclusive();
-				if (auto idx = locked->find_index(act); locked->is_valid(idx)) {
+				if (auto idx = locked->find_or_take(act); locked->is_valid(idx)) {
 					locked->fear(idx).fears_male = value;
 					if (::Fear::FormsFilled()) {
 						act->AddToFaction(::Fear::Faction(::Fear::FAC::FearsMale), locked->fear(idx).FearsMaleRank());
@@ -1269,26 +1657,37 @@ namespace Data {
 					if (is_player and player_is_blocked) {
 						locked->player_rules().Rested();
 					}
-					FearInfo& fear = locked->fear(idx);
+					const fear_columns::ref fear = locked->fear(idx);
 					fear.last_rest_day = GameDataUtils::DaysPassed();
-					if (!fear.is_female and !is_player and player_is_blocked and intfc.IsValid() and act != intfc.PassiveActor()) { // Brawler is male non-player and non-passive
+					if (!fear.is_female() and !is_player and player_is_blocked and intfc.IsValid() and act != intfc.PassiveActor()) { // Brawler is male non-player and non-passive
 						PlayerRules::BrawlerHitDefender(locked->player_rules(), intfc.Tags(), fear.fear.get());
 					}
 				}
 			}
 		} 
 
+		// Equip data readers apply queued equip events first, but only take the exclusive lock if there are any
+		static void DrainPendingEquips() noexcept {
+			if (!Shared::equip_queue.empty()) {
+				Shared::DrainEquips(*locker.GetExclusive());
+			}
+		}
+
 		static float GetExposure(StaticFunc, RE::Actor* act) {
 			if (act) {
+				DrainPendingEquips();
+				TakeCold(act);
 				const auto locked = locker.GetShared();
 				if (auto idx = locked->find_index(act); locked->is_valid(idx)) {
-					return locked->equipstate(idx).GetExposure();
+					return locked->exposure(idx);
 				}
 			}
 			return -1.0f;
 		}
 		static bool GetIsNaked(StaticFunc, RE::Actor* act) {
 			if (act) {
+				DrainPendingEquips();
+				TakeCold(act);
 				const auto locked = locker.GetShared();
 				if (auto idx = locked->find_index(act); locked->is_valid(idx)) {
 					return locked->equipstate(idx).IsNaked();
@@ -1297,6 +1696,61 @@ namespace Data {
 			return false;
 		}
 
+		static void SetDetectionBudget(StaticFunc, i32 budget_us) {
+			Shared::detection_budget_us.store(static_cast<u32>(std::max(budget_us, 0)), std::memory_order_relaxed);
+		}
+		static i32 GetDetectionBudget(StaticFunc) { return to_s32(Shared::detection_budget_us.load(std::memory_order_relaxed)); }
+		// Extra threads for Fear updates of many actors. 0 keeps them all on the update thread.
+		static void SetFearWorkers(StaticFunc, i32 count) {
+			Fear::fear_workers.store(static_cast<u32>(std::clamp(count, 0, static_cast<i32>(SyncTypes::worker_pool::MaxWorkers))), std::memory_order_relaxed);
+		}
+		static i32 GetFearWorkers(StaticFunc) { return to_s32(Fear::fear_workers.load(std::memory_order_relaxed)); }
+		// Records every default update's inputs and outputs to <Project>_trace.bin in the log folder, for replaying outside the game. Starting again truncates it.
+		static void SetUpdateTrace(StaticFunc, bool enabled) { Shared::trace_wanted.store(enabled, std::memory_order_relaxed); }
+		static bool GetUpdateTrace(StaticFunc) { return Shared::trace_wanted.load(std::memory_order_relaxed); }
+		// How saves store actors: 0 as plain columns, 1 encoded (smaller, fear values kept to 1/65535), 2 encoded and compressed. Loads read any of them.
+		static void SetSaveFormat(StaticFunc, i32 format) {
+			Shared::save_format.store(static_cast<u32>(std::clamp(format, 0, static_cast<i32>(ActorRecords::format::Total) - 1)), std::memory_order_relaxed);
+		}
+		static i32 GetSaveFormat(StaticFunc) { return to_s32(Shared::save_format.load(std::memory_order_relaxed)); }
+		// Long updates an actor can go ungathered before its data is moved out of the per-update arrays, until it shows up again. 0 keeps everyone in them.
+		static void SetColdAfter(StaticFunc, i32 long_updates) {
+			Shared::cold_after.store(static_cast<u32>(std::clamp(long_updates, 0, static_cast<i32>(std::numeric_limits<u8>::max()) - 1)), std::memory_order_relaxed);
+		}
+		static i32 GetColdAfter(StaticFunc) { return to_s32(Shared::cold_after.load(std::memory_order_relaxed)); }
+		// [hot, cold] actor counts
+		static vector<i32> GetActorCounts(StaticFunc) {
+			const auto locked = locker.GetShared();
+			return { to_s32(locked->size()), to_s32(locked->cold_count()) };
+		}
+		// [pairs, refreshed, left unknown, oldest age in updates, microseconds spent] of the last default update
+		static vector<i32> GetDetectionStats(StaticFunc) {
+			const auto& stats = Shared::detection_stats;
+			return {
+				to_s32(stats.pairs.load(std::memory_order_relaxed)),
+				to_s32(stats.refreshed.load(std::memory_order_relaxed)),
+				to_s32(stats.unknown.load(std::memory_order_relaxed)),
+				to_s32(stats.max_age.load(std::memory_order_relaxed)),
+				to_s32(stats.spent_us.load(std::memory_order_relaxed))
+			};
+		}
+
+		// Per-phase update timings, as one line per phase
+		static string GetUpdateTimings(StaticFunc) { return Shared::UpdateTimingSummary(); }
+		// Bucket counts of a phase's latency histogram. Bucket i counts runs that took [2^(i-1), 2^i) us, the first under 1us, and the last everything longer.
+		static vector<i32> GetUpdatePhaseHistogram(StaticFunc, i32 phase) {
+			if ((phase < 0) or (phase >= static_cast<i32>(Shared::UpdatePhase::Total))) {
+				return {};
+			}
+			const Timing::latency_histogram& hist = Shared::phase_times[static_cast<u32>(phase)];
+			vector<i32> ret(Timing::latency_histogram::BucketCount);
+			for (u32 idx = 0; idx < Timing::latency_histogram::BucketCount; ++idx) {
+				ret[idx] = to_s32(hist.bucket(idx));
+			}
+			return ret;
+		}
+		static void ResetUpdateTimings(StaticFunc) { Shared::ResetUpdateTimings(); }
+
 		static constexpr string_view shared_script_name = "FunctionsShared"sv;
 		static bool RegisterSharedFunctions(IVM* vm) {
 
@@ -1304,6 +1758,21 @@ namespace Data {
 			vm->RegisterFunction("NotifyBrawl", shared_script_name, NotifyBrawl);
 			vm->RegisterFunction("GetExposure", fear_script_name, GetExposure, true);
 			vm->RegisterFunction("GetIsNaked", fear_script_name, GetIsNaked, true);
+			vm->RegisterFunction("SetDetectionBudget", shared_script_name, SetDetectionBudget, true);
+			vm->RegisterFunction("GetDetectionBudget", shared_script_name, GetDetectionBudget, true);
+			vm->RegisterFunction("GetDetectionStats", shared_script_name, GetDetectionStats, true);
+			vm->RegisterFunction("SetFearWorkers", shared_script_name, SetFearWorkers, true);
+			vm->RegisterFunction("GetFearWorkers", shared_script_name, GetFearWorkers, true);
+			vm->RegisterFunction("SetUpdateTrace", shared_script_name, SetUpdateTrace, true);
+			vm->RegisterFunction("GetUpdateTrace", shared_script_name, GetUpdateTrace, true);
+			vm->RegisterFunction("SetSaveFormat", shared_script_name, SetSaveFormat, true);
+			vm->RegisterFunction("GetSaveFormat", shared_script_name, GetSaveFormat, true);
+			vm->RegisterFunction("SetColdAfter", shared_script_name, SetColdAfter, true);
+			vm->RegisterFunction("GetColdAfter", shared_script_name, GetColdAfter, true);
+			vm->RegisterFunction("GetActorCounts", shared_script_name, GetActorCounts, true);
+			vm->RegisterFunction("GetUpdateTimings", shared_script_name, GetUpdateTimings, true);
+			vm->RegisterFunction("GetUpdatePhaseHistogram", shared_script_name, GetUpdatePhaseHistogram, true);
+			vm->RegisterFunction("ResetUpdateTimings", shared_script_name, ResetUpdateTimings, true);
 
 			return true;
 		}
@@ -34,7 +34,7 @@ namespace Data {
 
 	namespace Shared {
 		static constexpr u32 SerializationType		{ 'FRDT' };
-		static constexpr u32 SerializationVersion	{ 1 };
+		static constexpr u32 SerializationVersion	{ 3 };	// Newest. 2 has columnar actor rows, 3 encoded ones (DataDefs/ActorRecords.h).
 
 		bool SetFearActive(const bool new_active) noexcept;
 
@@ -98,7 +98,15 @@ namespace Data {
 			milliseconds delta_default{ 0ms };
 			milliseconds delta_long{ 0ms };
 		};
-		void Update(const UpdateKinds kinds, const UpdateDeltas deltas) noexcept;
+		// What an update saw, for Periodic to pace the next ones by
+		struct UpdateActivity {
+			u32 actor_count{ 0 };		// Actors Fear ran on. 0 if it didn't run.
+			u32 in_combat{ 0 };			// How many of them were in combat
+			bool changed{ false };		// Whether the actors around or their combat states changed since the last time Fear ran
+			bool recent_dodges{ false };	// Whether the player has recent dodges left to decay, so short updates still matter
+			milliseconds cost{ 0ms };	// Time the default update took, on the update thread plus gathering on the main thread
+		};
+		UpdateActivity Update(const UpdateKinds kinds, const UpdateDeltas deltas) noexcept;
 
 
 		void InstallHooks();
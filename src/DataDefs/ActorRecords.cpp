@@ -0,0 +1,570 @@
+#include "ActorRecords.h"
+#include "Utils/SerializationUtils.h"
+
+#include <immintrin.h>
+
+namespace Data::ActorRecords {
+	using SerializationUtils::byte_writer;
+	using SerializationUtils::byte_reader;
+
+	// Fear block fields, in FearInfo's order: fear, thrillseeking, fears_female, fears_male, buildup_mod, last_rest_day, is_female, is_blocked
+	static constexpr array<u32, 8> FearFieldSizes{ 4, 4, 4, 4, 4, 4, 1, 1 };
+	static_assert(sizeof(sat01flt) == 4 and sizeof(sat0flt) == 4 and sizeof(optional_float) == 4);
+
+	// Bytes before field's column, per row
+	static constexpr u32 FieldOffset(const size_t field) noexcept {
+		u32 offset = 0;
+		for (size_t i = 0; i < field; ++i) {
+			offset += FearFieldSizes[i];
+		}
+		return offset;
+	}
+	static_assert(FieldOffset(FearFieldSizes.size()) == FearRowSize);
+
+	template<typename T>
+	static FORCEINLINE void get_field(const u8* block, const size_t count, const size_t field, const size_t idx, T& dst) noexcept {
+		std::memcpy(&dst, block + (FieldOffset(field) * count) + (idx * sizeof(T)), sizeof(T));
+	}
+	template<typename T>
+	static FORCEINLINE void set_field(u8* block, const size_t count, const size_t field, const size_t idx, const T& src) noexcept {
+		std::memcpy(block + (FieldOffset(field) * count) + (idx * sizeof(T)), &src, sizeof(T));
+	}
+	// Copies col[rows[i]] to consecutive Ts at dst
+	template<typename T>
+	static void gather(u8* dst, const lazy_vector<T>& col, const lazy_vector<u32>& rows) noexcept {
+		for (const u32 row : rows) {
+			std::memcpy(dst, &col[row], sizeof(T));
+			dst += sizeof(T);
+		}
+	}
+
+
+	FearInfo columns::fear(const size_t idx) const noexcept {
+		const u8* block = fear_block.data();
+		const size_t count = size();
+		FearInfo info{};
+		get_field(block, count, 0, idx, info.fear);
+		get_field(block, count, 1, idx, info.thrillseeking);
+		get_field(block, count, 2, idx, info.fears_female);
+		get_field(block, count, 3, idx, info.fears_male);
+		get_field(block, count, 4, idx, info.buildup_mod);
+		get_field(block, count, 5, idx, info.last_rest_day);
+		get_field(block, count, 6, idx, info.is_female);
+		get_field(block, count, 7, idx, info.is_blocked);
+		info.in_brawl = false; // Not serialized, brawls end on game load anyway
+		return info;
+	}
+	void columns::set_fear(const size_t idx, const FearInfo& info) noexcept {
+		u8* block = fear_block.data();
+		const size_t count = size();
+		set_field(block, count, 0, idx, info.fear);
+		set_field(block, count, 1, idx, info.thrillseeking);
+		set_field(block, count, 2, idx, info.fears_female);
+		set_field(block, count, 3, idx, info.fears_male);
+		set_field(block, count, 4, idx, info.buildup_mod);
+		set_field(block, count, 5, idx, info.last_rest_day);
+		set_field(block, count, 6, idx, info.is_female);
+		set_field(block, count, 7, idx, info.is_blocked);
+	}
+	EquipState columns::equips(const size_t idx) const noexcept {
+		EquipState eqs{};
+		std::memcpy(&eqs, equip_block.data() + (idx * EquipRowSize), EquipRowSize);
+		return eqs;
+	}
+	void columns::set_equips(const size_t idx, const EquipState& eqs) noexcept {
+		std::memcpy(equip_block.data() + (idx * EquipRowSize), &eqs, EquipRowSize);
+	}
+
+
+	// Rows to save, those with a formID
+	static bool ValidRows(const lazy_vector<RE::FormID>& formIDs, lazy_vector<u32>& rows) noexcept {
+		if (!rows.reserve(formIDs.size())) {
+			Log::Critical("Failed to initialize serialization bookkeeping! (out of memory?)"sv);
+			return false;
+		}
+		for (u32 i = 0, end = static_cast<u32>(formIDs.size()); i < end; ++i) {
+			if (formIDs[i] != 0) {
+				rows.append(i);
+			}
+		}
+		return true;
+	}
+
+
+	static bool WriteColumns(SKSE::SerializationInterface& intfc, const lazy_vector<RE::FormID>& formIDs, const fear_columns& fears, const lazy_vector<EquipState>& equips, const lazy_vector<u32>& rows) noexcept {
+		const size_t count = rows.size();
+		if (count > (std::numeric_limits<u32>::max() / EquipRowSize)) { // Every block must fit one WriteRecordData()
+			Log::Critical("Too many actors to serialize ({})!"sv, count);
+			return false;
+		}
+
+		columns staged{};
+		if (!staged.resize(count)) {
+			Log::Critical("Failed to initialize serialization bookkeeping! (out of memory?)"sv);
+			return false;
+		}
+		gather(reinterpret_cast<u8*>(staged.formIDs.data()), formIDs, rows);
+
+		// Column by column, so each is one sequential read of fear_columns
+		u8* block = staged.fear_block.data();
+		gather(block + (FieldOffset(0) * count), fears.fear, rows);
+		gather(block + (FieldOffset(1) * count), fears.thrillseeking, rows);
+		gather(block + (FieldOffset(2) * count), fears.fears_female, rows);
+		gather(block + (FieldOffset(3) * count), fears.fears_male, rows);
+		gather(block + (FieldOffset(4) * count), fears.buildup_mod, rows);
+		gather(block + (FieldOffset(5) * count), fears.last_rest_day, rows);
+		for (u8* female = block + (FieldOffset(6) * count); const u32 row : rows) {
+			*(female++) = static_cast<u8>((fears.flags[row] & fear_columns::Female) != 0);
+		}
+		gather(block + (FieldOffset(7) * count), fears.is_blocked, rows);
+
+		for (size_t i = 0; i < count; ++i) {
+			staged.set_equips(i, equips[rows[i]]);
+		}
+
+		if (!intfc.WriteRecordData(static_cast<u32>(count))) {
+			Log::Critical("Failed to serialize actor count!"sv);
+			return false;
+		}
+		if ((count != 0) and (
+			!intfc.WriteRecordData(staged.formIDs.data(), static_cast<u32>(count * sizeof(RE::FormID)))
+			or !intfc.WriteRecordData(staged.fear_block.data(), static_cast<u32>(count * FearRowSize))
+			or !intfc.WriteRecordData(staged.equip_block.data(), static_cast<u32>(count * EquipRowSize))))
+		{
+			Log::Critical("Failed to serialize data for {} actors!"sv, count);
+			return false;
+		}
+		return true;
+	}
+
+	static bool ReadColumns(SKSE::SerializationInterface& intfc, columns& out) noexcept {
+		u32 count;
+		if (intfc.ReadRecordData(count) != sizeof(count)) {
+			Log::Critical("Failed to deserialize actor count!"sv);
+			return false;
+		}
+		if (count > (std::numeric_limits<u32>::max() / EquipRowSize)) {
+			Log::Critical("Deserialized actor count {} is corrupt!"sv, count);
+			return false;
+		}
+		if (!out.resize(count)) {
+			Log::Critical("Not enough memory to deserialize data!"sv);
+			return false;
+		}
+		const auto read_block = [&intfc](void* dst, const u32 bytes) { return intfc.ReadRecordData(dst, bytes) == bytes; };
+		if ((count != 0) and (
+			!read_block(out.formIDs.data(), static_cast<u32>(count * sizeof(RE::FormID)))
+			or !read_block(out.fear_block.data(), count * FearRowSize)
+			or !read_block(out.equip_block.data(), count * EquipRowSize)))
+		{
+			Log::Critical("Failed to deserialize data for {} actors!"sv, count);
+			return false;
+		}
+		return true;
+	}
+
+	static bool ReadV1(SKSE::SerializationInterface& intfc, columns& out) noexcept {
+		size_t data_size;
+		if (!intfc.ReadRecordData(data_size)) {
+			Log::Critical("Failed to deserialize actor count!"sv);
+			return false;
+		}
+		if (!out.resize(data_size)) {
+			Log::Critical("Not enough memory to deserialize data!"sv);
+			return false;
+		}
+		for (size_t i = 0; i < data_size; ++i) {
+			RE::FormID formID{};
+			FearInfo ars;
+			EquipState eqs;
+			if (!intfc.ReadRecordData(formID) or !ars.Load(intfc) or !eqs.Load(intfc)) {
+				Log::Critical("Failed to deserialize actor data (potential unresolved formID <{:08X}>)!"sv, formID);
+				return false;
+			}
+			out.formIDs[i] = formID;
+			out.set_fear(i, ars);
+			out.set_equips(i, eqs);
+		}
+		return true;
+	}
+
+
+	// Encoded rows
+
+	using HRCounts = EquipState::HRCounts;
+	enum : u32 {
+		HurdleCount = static_cast<u32>(std::tuple_size_v<decltype(HRCounts::counts)>),
+		LeftHandBit = HurdleCount,
+		RightHandBit = HurdleCount + 1,
+		// Worn slots varint and flags, hurdles and hands varint and bytes
+		EncodedEquipsBound = (5 + 32) + (5 + HurdleCount + 2),
+		// formID varint, 4 fixed point and 2 float fields, and the equips. Flag bits are covered by the 1 per row.
+		EncodedRowBound = 5 + (4 * sizeof(u16)) + (2 * sizeof(float)) + 1 + EncodedEquipsBound,
+		ColdRowBound = FearRowSize + EncodedEquipsBound
+	};
+	static_assert(RightHandBit < 32);
+	static_assert(sizeof(EquipState::slots) == 32 and sizeof(HRCounts::counts) == HurdleCount);
+
+	static FORCEINLINE u16 quantize(const float val) noexcept { return static_cast<u16>((val * 65535.0f) + 0.5f); } // Rounds, since val is never negative
+	static FORCEINLINE float dequantize(const u16 val) noexcept { return static_cast<float>(val) / 65535.0f; }
+
+	template<typename Fn>
+	static FORCEINLINE void for_each_bit(u32 mask, Fn&& fn) noexcept {
+		while (mask != 0) {
+			fn(static_cast<u32>(std::countr_zero(mask)));
+			mask &= mask - 1;
+		}
+	}
+
+	// Bit i set if byte i of eqs isn't 0. 4 SSE2 compares instead of a loop per byte.
+	static FORCEINLINE u64 NonzeroBytes(const EquipState& eqs) noexcept {
+		static_assert(sizeof(EquipState) == 64);
+		const __m128i zero = _mm_setzero_si128();
+		const auto* src = reinterpret_cast<const __m128i*>(&eqs);
+		u64 zeros = 0;
+		for (u32 i = 0; i < 4; ++i) {
+			zeros |= static_cast<u64>(static_cast<u16>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(src + i), zero)))) << (i * 16);
+		}
+		return ~zeros;
+	}
+	static_assert((offsetof(EquipState, hr) == 32) and (offsetof(EquipState, hands) == 60)); // Where NonzeroBytes() bits are taken from
+
+	static void EncodeEquips(byte_writer& out, const EquipState& eqs) noexcept {
+		const u64 nonzero = NonzeroBytes(eqs);
+		const u32 worn = static_cast<u32>(nonzero);
+		out.put_varint(worn);
+		for_each_bit(worn, [&](const u32 slot) { out.put(eqs.slots[slot].f); });
+
+		const u32 extra = static_cast<u32>((nonzero >> 32) & ((1ull << HurdleCount) - 1)) | (static_cast<u32>((nonzero >> 60) & 0b11) << LeftHandBit);
+		out.put_varint(extra);
+		for_each_bit(extra, [&](const u32 bit) {
+			switch (bit) {
+			case LeftHandBit: { out.put(eqs.hands.left); return; }
+			case RightHandBit: { out.put(eqs.hands.right); return; }
+			default: { out.put(eqs.hr.counts[bit]); return; }
+			}
+		});
+	}
+	static bool DecodeEquips(byte_reader& in, EquipState& eqs) noexcept {
+		for_each_bit(in.get_varint(), [&](const u32 slot) { eqs.slots[slot].f = in.get<u8>(); });
+		const u32 extra = in.get_varint();
+		if (extra >= (1u << (RightHandBit + 1))) {
+			return false;
+		}
+		for_each_bit(extra, [&](const u32 bit) {
+			switch (bit) {
+			case LeftHandBit: { eqs.hands.left = in.get<u8>(); return; }
+			case RightHandBit: { eqs.hands.right = in.get<u8>(); return; }
+			default: { eqs.hr.counts[bit] = in.get<satu8>(); return; }
+			}
+		});
+		eqs.hr.update_empty_flag();
+		return in.ok();
+	}
+
+	static bool WriteEncoded(SKSE::SerializationInterface& intfc, const lazy_vector<RE::FormID>& formIDs, const fear_columns& fears, const lazy_vector<EquipState>& equips, lazy_vector<u32>& rows, const bool compress) noexcept {
+		const size_t count = rows.size();
+		if (count > ((std::numeric_limits<u32>::max() - 1) / EquipRowSize)) {
+			Log::Critical("Too many actors to serialize ({})!"sv, count);
+			return false;
+		}
+		// Sorted by formID, for small deltas. Sorting (formID, row) keys is much faster than rows compared through formIDs.
+		lazy_vector<u64> keys{};
+		if (!keys.reserve(count)) {
+			Log::Critical("Failed to initialize serialization bookkeeping! (out of memory?)"sv);
+			return false;
+		}
+		for (const u32 row : rows) {
+			keys.append((static_cast<u64>(formIDs[row]) << 32) | row);
+		}
+		std::sort(keys.begin(), keys.end());
+		for (size_t i = 0; i < count; ++i) {
+			rows[i] = static_cast<u32>(keys[i]);
+		}
+
+		lazy_vector<u8> raw{};
+		if (!raw.resize((count * EncodedRowBound) + 1)) {
+			Log::Critical("Failed to initialize serialization bookkeeping! (out of memory?)"sv);
+			return false;
+		}
+		byte_writer out{ raw.data(), raw.size() };
+		RE::FormID last = 0;
+		for (const u32 row : rows) {
+			out.put_varint(formIDs[row] - last);
+			last = formIDs[row];
+		}
+		for (const auto* col : { &fears.fear, &fears.thrillseeking, &fears.fears_female, &fears.fears_male }) {
+			for (const u32 row : rows) {
+				out.put(quantize((*col)[row]));
+			}
+		}
+		for (const u32 row : rows) {
+			out.put(fears.buildup_mod[row]);
+		}
+		for (const u32 row : rows) {
+			out.put(fears.last_rest_day[row]);
+		}
+		for (size_t i = 0; i < count; i += 4) { // 2 bits per row, female and blocked
+			u8 bits = 0;
+			for (size_t j = i, end = std::min(i + 4, count); j < end; ++j) {
+				const u32 row = rows[j];
+				bits |= static_cast<u8>((((fears.flags[row] & fear_columns::Female) != 0) | (fears.is_blocked[row] << 1)) << ((j - i) * 2));
+			}
+			out.put(bits);
+		}
+		for (const u32 row : rows) {
+			EncodeEquips(out, equips[row]);
+		}
+		if (!out.ok()) {
+			Log::Critical("Failed to encode data for {} actors!"sv, count);
+			return false;
+		}
+
+		encoded_header header{ .count = static_cast<u32>(count), .raw_size = static_cast<u32>(out.size()), .stored_size = static_cast<u32>(out.size()) };
+		const u8* stored = raw.data();
+		lazy_vector<u8> compressed{};
+		if (compress and compressed.resize(SerializationUtils::CompressBound(out.size()))) { // Stored encoded only, if memory is short
+			if (const size_t size = SerializationUtils::Compress(raw.data(), out.size(), compressed.data(), compressed.size()); (size != 0) and (size < out.size())) {
+				stored = compressed.data();
+				header.stored_size = static_cast<u32>(size);
+				header.flags |= encoded_header::Compressed;
+			}
+		}
+
+		if (!intfc.WriteRecordData(header) or ((header.stored_size != 0) and !intfc.WriteRecordData(stored, header.stored_size))) {
+			Log::Critical("Failed to serialize data for {} actors!"sv, count);
+			return false;
+		}
+		return true;
+	}
+
+	static bool ReadEncoded(SKSE::SerializationInterface& intfc, columns& out) noexcept {
+		encoded_header header;
+		if (intfc.ReadRecordData(header) != sizeof(header)) {
+			Log::Critical("Failed to deserialize actor count!"sv);
+			return false;
+		}
+		const bool compressed = header.flags & encoded_header::Compressed;
+		if ((header.count > ((std::numeric_limits<u32>::max() - 1) / EquipRowSize)) or (header.raw_size > ((static_cast<size_t>(header.count) * EncodedRowBound) + 1))
+			or (compressed ? (header.stored_size > SerializationUtils::CompressBound(header.raw_size)) : (header.stored_size != header.raw_size)))
+		{
+			Log::Critical("Deserialized header of {} actors is corrupt!"sv, header.count);
+			return false;
+		}
+
+		lazy_vector<u8> stored{};
+		lazy_vector<u8> raw{};
+		if (!stored.resize(header.stored_size) or (compressed and !raw.resize(header.raw_size)) or !out.resize(header.count)) {
+			Log::Critical("Not enough memory to deserialize data!"sv);
+			return false;
+		}
+		if ((header.stored_size != 0) and (intfc.ReadRecordData(stored.data(), header.stored_size) != header.stored_size)) {
+			Log::Critical("Failed to deserialize data for {} actors!"sv, header.count);
+			return false;
+		}
+		if (compressed and !SerializationUtils::Decompress(stored.data(), stored.size(), raw.data(), raw.size())) {
+			Log::Critical("Failed to decompress data for {} actors!"sv, header.count);
+			return false;
+		}
+
+		const size_t count = header.count;
+		byte_reader in{ compressed ? raw.data() : stored.data(), header.raw_size };
+		RE::FormID last = 0;
+		for (size_t i = 0; i < count; ++i) {
+			last += in.get_varint();
+			out.formIDs[i] = last;
+		}
+		u8* block = out.fear_block.data();
+		for (size_t field = 0; field < 4; ++field) {
+			for (size_t i = 0; i < count; ++i) {
+				set_field(block, count, field, i, sat01flt{ dequantize(in.get<u16>()) });
+			}
+		}
+		for (size_t i = 0; i < count; ++i) {
+			set_field(block, count, 4, i, in.get<sat0flt>());
+		}
+		for (size_t i = 0; i < count; ++i) {
+			set_field(block, count, 5, i, in.get<optional_float>());
+		}
+		for (size_t i = 0; i < count; i += 4) {
+			const u8 bits = in.get<u8>();
+			for (size_t j = i, end = std::min(i + 4, count); j < end; ++j) {
+				const u32 shift = static_cast<u32>(j - i) * 2;
+				set_field(block, count, 6, j, static_cast<bool>((bits >> shift) & 1));
+				set_field(block, count, 7, j, static_cast<bool>((bits >> (shift + 1)) & 1));
+			}
+		}
+		for (size_t i = 0; i < count; ++i) {
+			EquipState eqs{};
+			if (!DecodeEquips(in, eqs)) {
+				break;
+			}
+			out.set_equips(i, eqs);
+		}
+		if (!in.ok() or (in.remaining() != 0)) {
+			Log::Critical("Failed to decode data for {} actors!"sv, count);
+			return false;
+		}
+		return true;
+	}
+
+
+	// Cold rows
+
+	bool cold_rows::assign(SKSE::SerializationInterface& intfc, const columns& saved) noexcept {
+		clear();
+		const size_t saved_count = saved.size();
+		if (!reserve(saved_count)) {
+			clear();
+			Log::Critical("Not enough memory to deserialize data!"sv);
+			return false;
+		}
+		for (size_t i = 0; i < saved_count; ++i) {
+			if (RE::FormID formID = saved.formIDs[i]; intfc.ResolveFormID(formID, formID) and !add(formID, saved.fear(i), saved.equips(i))) { // Duplicates would be saved again next to the first, so add() drops them
+				clear();
+				Log::Critical("Not enough memory to deserialize data!"sv);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool cold_rows::add(const RE::FormID formID, const FearInfo& info, const EquipState& eqs) noexcept {
+		if ((formID == 0) or (find(formID) != size())) {
+			return true;
+		}
+		const size_t at = bytes.size();
+		if (!bytes.resize(at + ColdRowBound)) { // Room for the largest row, given back below
+			return false;
+		}
+		byte_writer out{ bytes.data() + at, ColdRowBound };
+		out.put(info.fear);
+		out.put(info.thrillseeking);
+		out.put(info.fears_female);
+		out.put(info.fears_male);
+		out.put(info.buildup_mod);
+		out.put(info.last_rest_day);
+		out.put(info.is_female);
+		out.put(info.is_blocked);
+		EncodeEquips(out, eqs);
+		(void)bytes.resize(at + out.size());
+
+		index.insert_or_assign(formID, static_cast<u32>(size()));
+		formIDs.append(formID);
+		offsets.append(static_cast<u32>(at));
+		return true;
+	}
+
+	FearInfo cold_rows::fear(const size_t row) const noexcept {
+		byte_reader in{ bytes.data() + offsets[row], FearRowSize };
+		FearInfo info{};
+		info.fear = in.get<sat01flt>();
+		info.thrillseeking = in.get<sat01flt>();
+		info.fears_female = in.get<sat01flt>();
+		info.fears_male = in.get<sat01flt>();
+		info.buildup_mod = in.get<sat0flt>();
+		info.last_rest_day = in.get<optional_float>();
+		info.is_female = in.get<bool>();
+		info.is_blocked = in.get<bool>();
+		info.in_brawl = false; // Not kept, as it isn't saved either
+		return info;
+	}
+
+	EquipState cold_rows::equips(const size_t row) const noexcept {
+		const size_t begin = offsets[row] + FearRowSize;
+		const size_t end = ((row + 1) < size()) ? offsets[row + 1] : bytes.size();
+		byte_reader in{ bytes.data() + begin, end - begin };
+		EquipState eqs{};
+		(void)DecodeEquips(in, eqs); // Encoded by add(), so can't be corrupt
+		return eqs;
+	}
+
+	void cold_rows::compact() noexcept {
+		const size_t total = size();
+		if ((total - count()) <= (total / 2)) {
+			return;
+		}
+		size_t kept = 0;
+		u32 at = 0;
+		for (size_t i = 0; i < total; ++i) {
+			const u32 end = ((i + 1) < total) ? offsets[i + 1] : static_cast<u32>(bytes.size()); // Before offsets[i + 1] is overwritten, which only happens once i + 1 is past
+			if (formIDs[i] != 0) {
+				if (kept != i) {
+					std::memmove(bytes.data() + at, bytes.data() + offsets[i], end - offsets[i]);
+					formIDs[kept] = formIDs[i];
+					index.insert_or_assign(formIDs[kept], static_cast<u32>(kept)); // Only ever reassigns, so can't fail
+				}
+				const u32 len = end - offsets[i];
+				offsets[kept] = at;
+				at += len;
+				++kept;
+			}
+		}
+		formIDs.resize(kept);
+		offsets.resize(kept);
+		bytes.resize(at);
+		sweep_next = 0;
+	}
+
+
+	static bool WriteRows(SKSE::SerializationInterface& intfc, const lazy_vector<RE::FormID>& formIDs, const fear_columns& fears, const lazy_vector<EquipState>& equips, const format fmt) noexcept {
+		lazy_vector<u32> rows{};
+		if (!ValidRows(formIDs, rows)) {
+			return false;
+		}
+		switch (fmt) {
+		case format::Columns: { return WriteColumns(intfc, formIDs, fears, equips, rows); }
+		case format::Encoded: { return WriteEncoded(intfc, formIDs, fears, equips, rows, false); }
+		case format::EncodedCompressed: { return WriteEncoded(intfc, formIDs, fears, equips, rows, true); }
+		default: {
+			Log::Critical("Unknown actor record format {}!"sv, std::to_underlying(fmt));
+			return false;
+		}
+		}
+	}
+
+	bool Write(SKSE::SerializationInterface& intfc, const lazy_vector<RE::FormID>& formIDs, const fear_columns& fears, const lazy_vector<EquipState>& equips, const cold_rows& cold, const format fmt) noexcept {
+		if (cold.empty()) {
+			return WriteRows(intfc, formIDs, fears, equips, fmt);
+		}
+		// Cold rows go after copies of the hot ones, holes and all, since those have formID 0 like rows not to save
+		const size_t total = formIDs.size() + cold.size();
+		lazy_vector<RE::FormID> all_formIDs{};
+		fear_columns all_fears{};
+		lazy_vector<EquipState> all_equips{};
+		if (!all_formIDs.reserve(total) or !all_fears.reserve(total) or !all_equips.reserve(total)) {
+			Log::Critical("Failed to initialize serialization bookkeeping! (out of memory?)"sv);
+			return false;
+		}
+		for (const auto* part : { &formIDs, &cold.formIDs }) {
+			if (!part->empty()) {
+				all_formIDs.append_range_copy(part->begin(), part->end());
+			}
+		}
+		for (size_t i = 0, end = fears.size(); i < end; ++i) {
+			all_fears.append(fears.row(i));
+		}
+		if (!equips.empty()) {
+			all_equips.append_range_copy(equips.begin(), equips.end());
+		}
+		for (size_t row = 0, end = cold.size(); row < end; ++row) { // Holes unpack too, and get skipped for their formID
+			all_fears.append(cold.fear(row));
+			all_equips.append(cold.equips(row));
+		}
+		return WriteRows(intfc, all_formIDs, all_fears, all_equips, fmt);
+	}
+
+	bool Read(SKSE::SerializationInterface& intfc, const u32 version, columns& out) noexcept {
+		out.clear();
+		switch (version) {
+		case 1: { return ReadV1(intfc, out); }
+		case 2: { return ReadColumns(intfc, out); }
+		case 3: { return ReadEncoded(intfc, out); }
+		default: {
+			Log::Critical("Unknown actor record version {}!"sv, version);
+			return false;
+		}
+		}
+	}
+
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include "FearInfo.h"
+#include "EquipState.h"
+#include "Types/HandleIndex.h"
+
+namespace Data::ActorRecords {
+
+	// The actor rows of the Data::Shared co-save record, kept as columns.
+	// Version 2 writes the row count, then each column as one block: formIDs, the fear block and the equip block. Save and load cost follows bytes, not actors.
+	// Version 1 wrote formID, FearInfo and EquipState per actor, 3 calls each way. ReadV1() migrates it into the same columns.
+
+	enum : u32 {
+		FearRowSize = 26,	// What FearInfo::Save() writes
+		EquipRowSize = 62	// What EquipState::Save() writes
+	};
+	static_assert(sizeof(FearInfo) - sizeof(FearInfo::in_brawl) - sizeof(FearInfo::pad) == FearRowSize);
+	static_assert(sizeof(EquipState) - sizeof(EquipState::pad) == EquipRowSize);
+
+	struct columns {
+		lazy_vector<RE::FormID> formIDs{};	// As saved, unresolved
+		lazy_vector<u8> fear_block{};		// FearInfo's saved fields, one after the other, each for all rows
+		lazy_vector<u8> equip_block{};		// EquipState rows of EquipRowSize
+
+		size_t size() const noexcept { return formIDs.size(); }
+		bool resize(const size_t count) noexcept { return formIDs.resize(count) and fear_block.resize(count * FearRowSize) and equip_block.resize(count * EquipRowSize); }
+		void clear() noexcept { formIDs.clear(); fear_block.clear(); equip_block.clear(); }
+
+		FearInfo fear(const size_t idx) const noexcept;
+		void set_fear(const size_t idx, const FearInfo& info) noexcept;
+		EquipState equips(const size_t idx) const noexcept;
+		void set_equips(const size_t idx, const EquipState& eqs) noexcept;
+	};
+
+	// Version 3 encodes the rows instead, sorted by formID, into one block after an encoded_header:
+	// formIDs as varint deltas, the [0, 1] fear fields as 16 bit fixed point, the other 2 as floats, the 2 flags as 2 bits,
+	// and per EquipState a mask of worn slots and their flags, then a mask of nonzero hurdle counts and hands and their bytes.
+	// The block can also go through SerializationUtils::Compress().
+	enum class format : u32 {
+		Columns,			// Version 2
+		Encoded,			// Version 3
+		EncodedCompressed,	// Version 3
+		Total
+	};
+	constexpr u32 RecordVersion(const format fmt) noexcept { return (fmt == format::Columns) ? 2 : 3; }
+
+	struct encoded_header {
+		enum flag_bits : u8 {
+			Compressed = 1 << 0
+		};
+
+		u32 count{};
+		u32 raw_size{};		// Of the encoded block
+		u32 stored_size{};	// What follows. raw_size unless Compressed.
+		u8 flags{};
+		char pad[3]{};
+	};
+	static_assert(std::is_trivially_copyable_v<encoded_header> and sizeof(encoded_header) == 16);
+
+	// Rows of actors kept out of multivector's hot columns, found by formID. Loaded rows wait here until their actor is gathered, and rows of actors unseen for a while are moved here.
+	// Each row is packed into bytes: FearInfo's saved fields as they are (FearRowSize), then its EquipState as version 3 encodes it, so nothing is lost and a typical row takes about a third of a hot one.
+	// Taking a row leaves a hole with formID 0 behind, which compact() removes once holes are most of the table.
+	struct cold_rows {
+		lazy_vector<RE::FormID> formIDs{};	// Resolved to the current load order
+		lazy_vector<u32> offsets{};			// Where each row starts in bytes. It ends where the next starts.
+		lazy_vector<u8> bytes{};
+		HandleIndex::handle_index index{};	// formID -> row, for rows not taken
+		size_t sweep_next{};				// Where the next validity sweep starts
+
+		// Replaces the rows with those of saved whose formID resolves
+		bool assign(SKSE::SerializationInterface& intfc, const columns& saved) noexcept;
+		// Row bookkeeping only. bytes grow as add() needs, since rows vary in size.
+		bool reserve(const size_t extra_count) noexcept {
+			const size_t newcap = size() + extra_count;
+			return formIDs.reserve(newcap) and offsets.reserve(newcap) and index.reserve(count() + extra_count);
+		}
+		// Needs reserve() first. A formID already here keeps its old row. False, adding nothing, if bytes couldn't grow.
+		[[nodiscard]] bool add(const RE::FormID formID, const FearInfo& info, const EquipState& eqs) noexcept;
+		FearInfo fear(const size_t row) const noexcept;
+		EquipState equips(const size_t row) const noexcept;
+		// Row of formID not taken yet, or size()
+		size_t find(const RE::FormID formID) const noexcept {
+			const u32 row = index.find(formID);
+			return (row != HandleIndex::handle_index::NotFound) ? row : size();
+		}
+		// Frees everything once the last row is taken
+		void take(const size_t row) noexcept {
+			index.erase(std::exchange(formIDs[row], 0));
+			if (empty()) {
+				clear();
+			}
+		}
+		// Drops the holes, if they are most of the table
+		void compact() noexcept;
+		void clear() noexcept { formIDs.clear(); offsets.clear(); bytes.clear(); index = {}; sweep_next = 0; }
+		size_t size() const noexcept { return formIDs.size(); }
+		size_t count() const noexcept { return index.size(); }
+		bool empty() const noexcept { return index.size() == 0; }
+	};
+
+	// Writes rows whose formID isn't 0 and the cold ones, as RecordVersion(fmt). 4 WriteRecordData() calls whatever the count, 2 if encoded.
+	bool Write(SKSE::SerializationInterface& intfc, const lazy_vector<RE::FormID>& formIDs, const fear_columns& fears, const lazy_vector<EquipState>& equips, const cold_rows& cold, const format fmt) noexcept;
+	// Reads rows as written by version
+	bool Read(SKSE::SerializationInterface& intfc, const u32 version, columns& out) noexcept;
+
+}
@@ -9,7 +9,7 @@ namespace Data {
 	
 
 	// Expects dereferencable act
-	__forceinline bool IsValidKeepable(RE::Actor* act) noexcept {
+	FORCEINLINE bool IsValidKeepable(RE::Actor* act) noexcept {
 		bool ret = !act->IsDead();
 		const auto flags = act->formFlags;
 		ret &= (flags & RE::TESObjectREFR::RecordFlags::kInitiallyDisabled) == 0;
@@ -18,13 +18,13 @@ namespace Data {
 		
 	}
 	// Expects dereferencable act
-	__forceinline bool IsValidAddable(RE::Actor* act) noexcept {
+	FORCEINLINE bool IsValidAddable(RE::Actor* act) noexcept {
 		bool ret = act->race and Vanilla::IsNPCRace(act->race) and !act->IsChild();
 		return ret and IsValidKeepable(act);
 	}
 
 	// Does not dereference
-	__forceinline bool IsPlayer(RE::Actor* act) noexcept { return act == Vanilla::Player(); }
+	FORCEINLINE bool IsPlayer(RE::Actor* act) noexcept { return act == Vanilla::Player(); }
 
 
 	using namespace LazyVector;
@@ -56,14 +56,39 @@ namespace Data {
 
 	namespace UpdateTypes {
 
-		enum : size_t { MaxUpdateCount = 32 };
+		enum : size_t { MaxUpdateCount = 256 }; // Player plus up to 255 high process actors
+
+		// Square bit matrix of who sees whom among the actors of an update, plus its transpose, so mutual seeing is a word-wide AND.
+		// Rows take as many u64 words as the update's actor count needs and are packed back to back, so up to 64 actors every row is a single word.
+		class seeing_matrix {
+		public:
+			using word = u64;
+			static constexpr u32 WordBits = 64;
+			static constexpr u32 MaxWords = static_cast<u32>(MaxUpdateCount) / WordBits;
+
+			constexpr void reset(const u32 actor_count) noexcept {
+				words = (actor_count + (WordBits - 1)) / WordBits;
+				std::fill_n(seeing.begin(), actor_count * words, 0ull);
+				std::fill_n(seen_by.begin(), actor_count * words, 0ull);
+			}
+			constexpr u32 word_count() const noexcept { return words; }
+
+			// i sees j
+			FORCEINLINE constexpr void set_if_val(const u32 i, const u32 j, const bool val) noexcept {
+				seeing[(i * words) + (j / WordBits)] |= static_cast<word>(val) << (j % WordBits);
+				seen_by[(j * words) + (i / WordBits)] |= static_cast<word>(val) << (i % WordBits);
+			}
+			[[nodiscard]] FORCEINLINE constexpr bool sees(const u32 i, const u32 j) const noexcept { return (seeing[(i * words) + (j / WordBits)] >> (j % WordBits)) & 1; }
+
+			// Bit j of the row is set if i sees j
+			[[nodiscard]] FORCEINLINE constexpr const word* seeing_row(const u32 i) const noexcept { return seeing.data() + (i * words); }
+			// Bit j of the row is set if j sees i
+			[[nodiscard]] FORCEINLINE constexpr const word* seen_by_row(const u32 i) const noexcept { return seen_by.data() + (i * words); }
 
-		struct flags32 {
-			__forceinline constexpr void set_if_val(const u32 i, const bool val) noexcept { f |= static_cast<u32>(val << i); }
-			[[nodiscard]] __forceinline constexpr bool operator[](const u32 i) const noexcept { return (f >> i) & 1; }
-			__forceinline constexpr void clear() noexcept { f = 0; }
 		private:
-			u32 f{ 0 };
+			array<word, MaxUpdateCount * MaxWords> seeing{};
+			array<word, MaxUpdateCount * MaxWords> seen_by{};
+			u32 words{ 0 };
 		};
 
 		struct main_out { // For fear
@@ -72,14 +97,12 @@ namespace Data {
 				combat = act->IsInCombat();
 			}
 
-			flags32 seeing{};
 			u8 hppcnt{};
 			bool combat{};
-			char pad[2];
 		};
-		static_assert(std::is_trivially_copyable_v<main_out> and sizeof(main_out) == 8);
+		static_assert(std::is_trivially_copyable_v<main_out> and sizeof(main_out) == 2);
 
-		struct ranks_and_oneofs { // Put these in a struct to ensure the one-of stuff all end up in the remaining half cacheline after ranks' 1.5
+		struct ranks_and_oneofs { // Put these in a struct to ensure the one-of stuff all end up in the remaining part of the last cacheline after ranks' 12
 			constexpr void reset() noexcept {
 				actor_count = 0;
 				unregistered_count = 0;
@@ -94,9 +117,21 @@ namespace Data {
 			i32 mag{};					// "Magnitude" to set Recent Dodges Spell description to
 			bool follower{};			// True iff player has follower
 			bool need_ranks{};			// 
-			char pad[6];
+			char pad[38];
+		};
+		static_assert(std::is_trivially_copyable_v<ranks_and_oneofs> and sizeof(ranks_and_oneofs) == 832);
+
+		// Fear, Thrillseeking and Thrillseeker ranks, as last given to an actor's factions. UnknownRank if never given, or forgotten, so the next update writes it.
+		using applied_ranks = array<i8, 3>;
+		inline constexpr i8 UnknownRank = std::numeric_limits<i8>::min(); // Not a rank Fear ever gives
+		inline constexpr applied_ranks UnknownRanks{ UnknownRank, UnknownRank, UnknownRank };
+
+		struct rank_write { // One faction rank to give one actor of an update
+			u16 actor;		// Index into the update's actors
+			u8 faction;		// Index into applied_ranks
+			i8 rank;
 		};
-		static_assert(std::is_trivially_copyable_v<ranks_and_oneofs> and sizeof(ranks_and_oneofs) == 128);
+		static_assert(std::is_trivially_copyable_v<rank_write> and sizeof(rank_write) == 4);
 
 	}
 
@@ -0,0 +1,140 @@
+#pragma once
+#include "BaseTypes.h"
+#include "Types/HandleIndex.h"
+
+#include <chrono>
+
+
+namespace Data {
+
+	// Remembers who saw whom across default updates, so each update only has to ask the engine about some of the pairs.
+	// Every pair keeps its last detection result and an age, in updates, since it was last asked. remap() carries pairs over by handle from the previous update, and refresh() re-asks as many as fit a time budget:
+	// first pairs involving priority actors (player, combat), then pairs never asked about (new actors), then the rest round-robin, so the oldest get picked up next time.
+	// Only for the main thread tasks of Data::Shared::Update().
+	class detection_cache {
+	public:
+		enum : u32 {
+			MaxUpdateCount = UpdateTypes::MaxUpdateCount,
+			MaxAge = 0x7F,	// Also marks pairs never asked about
+			SeesBit = 0x80
+		};
+
+		struct stats {
+			u32 pairs{ 0 };			// Pairs in the update, self-pairs excluded
+			u32 refreshed{ 0 };		// Pairs asked about this update
+			u32 unknown{ 0 };		// Pairs left never asked about, which count as not seeing
+			u32 max_age{ 0 };		// Oldest pair left, in updates
+			std::chrono::microseconds spent{ 0 };
+		};
+
+		// Lays the cache out for this update's actors. Pairs between actors of the previous update keep their result and get one update older, the rest start unknown.
+		void remap(const trivial_handle* handles, const u32 count) noexcept {
+			u8* const next = (current == 0) ? pairs_b.data() : pairs_a.data();
+			const u8* const prev = (current == 0) ? pairs_a.data() : pairs_b.data();
+
+			array<u32, MaxUpdateCount> prev_idxs;
+			for (u32 i = 0; i < count; ++i) {
+				prev_idxs[i] = (prev_count == 0) ? HandleIndex::handle_index::NotFound : lookup.find(handles[i].native_handle());
+			}
+			for (u32 i = 0; i < count; ++i) {
+				u8* const row = next + (i * count);
+				if (const u32 pi = prev_idxs[i]; pi == HandleIndex::handle_index::NotFound) {
+					std::memset(row, MaxAge, count);
+				} else {
+					const u8* const prev_row = prev + (pi * prev_count);
+					for (u32 j = 0; j < count; ++j) {
+						const u32 pj = prev_idxs[j];
+						row[j] = (pj == HandleIndex::handle_index::NotFound) ? u8{ MaxAge } : older(prev_row[pj]);
+					}
+				}
+			}
+
+			lookup.clear();
+			for (u32 i = 0; i < count; ++i) {
+				(void)lookup.insert_or_assign(handles[i].native_handle(), i); // Failing only means a cold start for that actor next time
+			}
+			current ^= 1;
+			prev_count = count;
+		}
+
+		// Asks detect(i, j) (does i see j) about pairs in priority order until budget runs out, and writes every pair into out. At least one pair is always asked, and a zero budget asks them all.
+		template<typename Detect, typename IsPriority>
+		stats refresh(Detect&& detect, IsPriority&& is_priority, const std::chrono::microseconds budget, UpdateTypes::seeing_matrix& out) noexcept {
+			using clock = std::chrono::steady_clock;
+
+			const u32 count = prev_count;
+			u8* const cur = (current == 0) ? pairs_a.data() : pairs_b.data();
+			const auto start = clock::now();
+			const auto deadline = (budget.count() > 0) ? (start + budget) : clock::time_point::max();
+
+			stats result{};
+			result.pairs = (count * count) - count;
+			bool in_budget = true;
+			auto ask = [&](const u32 i, const u32 j) {
+				cur[(i * count) + j] = static_cast<u8>(detect(i, j) ? SeesBit : 0); // Age 0 marks asked this update, since remap() ages everything to at least 1
+				++result.refreshed;
+				in_budget = clock::now() < deadline;
+			};
+
+			for (u32 i = 0; in_budget and (i < count); ++i) {
+				const bool prio_i = is_priority(i);
+				for (u32 j = 0; in_budget and (j < count); ++j) {
+					if ((i != j) and (prio_i or is_priority(j))) {
+						ask(i, j);
+					}
+				}
+			}
+			for (u32 p = 0, end = count * count; in_budget and (p < end); ++p) {
+				if (((cur[p] & MaxAge) == MaxAge) and ((p / count) != (p % count))) {
+					ask(p / count, p % count);
+				}
+			}
+			if (const u32 end = count * count; end != 0) {
+				u32 p = cursor % end;
+				for (u32 visited = 0; in_budget and (visited < end); ++visited, p = (p + 1 == end) ? 0 : p + 1) {
+					if (((cur[p] & MaxAge) != 0) and ((p / count) != (p % count))) {
+						ask(p / count, p % count);
+					}
+				}
+				cursor = p;
+			}
+			result.spent = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start);
+
+			out.reset(count);
+			for (u32 i = 0; i < count; ++i) {
+				const u8* const row = cur + (i * count);
+				for (u32 j = 0; j < count; ++j) {
+					if (i != j) {
+						const u32 age = row[j] & MaxAge;
+						result.unknown += age == MaxAge;
+						result.max_age = std::max(result.max_age, age);
+						out.set_if_val(i, j, (row[j] & SeesBit) != 0);
+					}
+				}
+			}
+			return result;
+		}
+
+		void clear() noexcept {
+			lookup.clear();
+			prev_count = 0;
+			cursor = 0;
+		}
+
+	private:
+		// Each pair is a byte: the seeing result in the top bit and the age in the rest. Rows are packed with the update's actor count as stride.
+		// Two layouts, the current one and the one being remapped into.
+		array<u8, MaxUpdateCount * MaxUpdateCount> pairs_a{};
+		array<u8, MaxUpdateCount * MaxUpdateCount> pairs_b{};
+		HandleIndex::handle_index lookup{};	// Handles of the current layout to their index
+		u32 prev_count{ 0 };
+		u32 current{ 0 };
+		u32 cursor{ 0 };	// Round-robin position, as a flat pair index
+
+		static constexpr u8 older(const u8 pair) noexcept {
+			const u8 age = pair & MaxAge;
+			return static_cast<u8>((pair & SeesBit) | ((age < (MaxAge - 1)) ? (age + 1) : (MaxAge - 1))); // Known pairs never age into unknown
+		}
+	};
+
+}
@@ -1,11 +1,10 @@
 #pragma once
 #include "Types/LazyVector.h"
+#include "Types/SmallLazyVector.h"
 #include "Forms/FearForms.h"	// Keywords
 #include "Forms/HurdlesForms.h"	// Keywords
 
-#include <intrin0.inl.h>
-#pragma intrinsic(_BitScanReverse) // ~13 cycles to go over 32bits (bsr and mask-unset, on ~16 set bits). Same for tzcnt. lzcnt is ~10% slower. bsr is guaranteed to be available.
-// #pragma intrinsic(_BitScanForward) // Same as bsr.
+// Slot masks are walked highest bit first with std::bit_width(), which is bsr (or lzcnt where available). ~13 cycles to go over 32bits (bsr and mask-unset, on ~16 set bits).
 
 namespace Data {
 
@@ -52,6 +51,7 @@ namespace Data {
 		using ArmorType = RE::BIPED_MODEL::ArmorType;
 		using WeaponType = RE::WeaponTypes::WEAPON_TYPE;
 		using AV = RE::ActorValue;
+		using CopiedKeywords = LazyVector::small_lazy_vector<RE::BGSKeyword*, 32>; // Armors rarely have more than a handful of keywords, so equip processing stays off the heap
 
 		// Type and FEAR keywords of the armor in a specific slot
 		struct SlotFlags {
@@ -71,55 +71,55 @@ namespace Data {
 				ArmorTypeOffset = static_cast<u8>(FRKwd::Total),
 				ArmorTypeIndexOffset = ArmorTypeOffset + 1,
 
-				LightMask = 1ui8 << (static_cast<u8>(ArmorType::kLightArmor) + ArmorTypeOffset),
-				HeavyMask = 1ui8 << (static_cast<u8>(ArmorType::kHeavyArmor) + ArmorTypeOffset),
-				ClothingMask = 1ui8 << (static_cast<u8>(ArmorType::kClothing) + ArmorTypeOffset),
+				LightMask = u8{ 1 } << (static_cast<u8>(ArmorType::kLightArmor) + ArmorTypeOffset),
+				HeavyMask = u8{ 1 } << (static_cast<u8>(ArmorType::kHeavyArmor) + ArmorTypeOffset),
+				ClothingMask = u8{ 1 } << (static_cast<u8>(ArmorType::kClothing) + ArmorTypeOffset),
 
-				TypeMask = 0b1110'0000ui8,
-				KwdsMask = 0b0001'1111ui8,
-				SoleMask = 0b0001'0000ui8,
+				TypeMask = u8{ 0b1110'0000 },
+				KwdsMask = u8{ 0b0001'1111 },
+				SoleMask = u8{ 0b0001'0000 },
 				TierKwdMask = static_cast<u8>(KwdsMask & ~SoleMask),
 			};
 
-			__forceinline constexpr u8 raw() const noexcept { return f; }
+			FORCEINLINE constexpr u8 raw() const noexcept { return f; }
 
-			__forceinline constexpr bool is(const FRKwd flag) const noexcept { return f & static_cast<u8>(1ui8 << static_cast<u8>(flag)); }
-			__forceinline constexpr bool is(const ArmorType type) const noexcept { return f & static_cast<u8>(1ui8 << (static_cast<u8>(type) + ArmorTypeOffset)); }
+			FORCEINLINE constexpr bool is(const FRKwd flag) const noexcept { return f & static_cast<u8>(u8{ 1 } << static_cast<u8>(flag)); }
+			FORCEINLINE constexpr bool is(const ArmorType type) const noexcept { return f & static_cast<u8>(u8{ 1 } << (static_cast<u8>(type) + ArmorTypeOffset)); }
 
-			__forceinline constexpr bool worn() const noexcept { return f & TypeMask; }
-			__forceinline constexpr bool not_worn() const noexcept { return (f & TypeMask) == 0; }
+			FORCEINLINE constexpr bool worn() const noexcept { return f & TypeMask; }
+			FORCEINLINE constexpr bool not_worn() const noexcept { return (f & TypeMask) == 0; }
 
-			__forceinline constexpr u8 type() const noexcept { return f & TypeMask; }
-			__forceinline constexpr u8 type_index() const noexcept { return f >> ArmorTypeIndexOffset; }
-			__forceinline constexpr bool type_valid() const noexcept { return is_valid_type(f & TypeMask); }
-			__forceinline constexpr u8 tiers() const noexcept { return f & TierKwdMask; }
+			FORCEINLINE constexpr u8 type() const noexcept { return f & TypeMask; }
+			FORCEINLINE constexpr u8 type_index() const noexcept { return f >> ArmorTypeIndexOffset; }
+			FORCEINLINE constexpr bool type_valid() const noexcept { return is_valid_type(f & TypeMask); }
+			FORCEINLINE constexpr u8 tiers() const noexcept { return f & TierKwdMask; }
 
-			__forceinline constexpr bool light() const noexcept { return f & LightMask; }
-			__forceinline constexpr bool heavy() const noexcept { return f & HeavyMask; }
-			__forceinline constexpr bool clothing() const noexcept { return f & ClothingMask; }
-			__forceinline constexpr bool not_light() const noexcept { return (f & LightMask) == 0; }
-			__forceinline constexpr bool not_heavy() const noexcept { return (f & HeavyMask) == 0; }
-			__forceinline constexpr bool not_clothing() const noexcept { return (f & ClothingMask) == 0; }
+			FORCEINLINE constexpr bool light() const noexcept { return f & LightMask; }
+			FORCEINLINE constexpr bool heavy() const noexcept { return f & HeavyMask; }
+			FORCEINLINE constexpr bool clothing() const noexcept { return f & ClothingMask; }
+			FORCEINLINE constexpr bool not_light() const noexcept { return (f & LightMask) == 0; }
+			FORCEINLINE constexpr bool not_heavy() const noexcept { return (f & HeavyMask) == 0; }
+			FORCEINLINE constexpr bool not_clothing() const noexcept { return (f & ClothingMask) == 0; }
 
 			template<ArmorType type>
-			__forceinline constexpr bool not_type() const noexcept { return (f & static_cast<u8>(1ui8 << (static_cast<u8>(type) + ArmorTypeOffset))) == 0; }
+			FORCEINLINE constexpr bool not_type() const noexcept { return (f & static_cast<u8>(u8{ 1 } << (static_cast<u8>(type) + ArmorTypeOffset))) == 0; }
 
-			__forceinline constexpr bool nosoles() const noexcept { return f & SoleMask; }
-			__forceinline constexpr bool soles() const noexcept { return (f & SoleMask) == 0; }
+			FORCEINLINE constexpr bool nosoles() const noexcept { return f & SoleMask; }
+			FORCEINLINE constexpr bool soles() const noexcept { return (f & SoleMask) == 0; }
 
-			__forceinline constexpr void set(const FRKwd flag) noexcept { f |= static_cast<u8>(1ui8 << static_cast<u8>(flag)); }
-			__forceinline constexpr void set(const ArmorType type) noexcept {
+			FORCEINLINE constexpr void set(const FRKwd flag) noexcept { f |= static_cast<u8>(u8{ 1 } << static_cast<u8>(flag)); }
+			FORCEINLINE constexpr void set(const ArmorType type) noexcept {
 				f &= KwdsMask; // Unset all armor types
 				f |= static_cast<u8>(1 << (static_cast<u8>(type) + ArmorTypeOffset)); // Set the new one
 			}
 
-			__forceinline constexpr void unset(const FRKwd flag) noexcept { f &= ~static_cast<u8>(1ui8 << static_cast<u8>(flag)); }
+			FORCEINLINE constexpr void unset(const FRKwd flag) noexcept { f &= ~static_cast<u8>(u8{ 1 } << static_cast<u8>(flag)); }
 
-			__forceinline constexpr void accumulate(const SlotFlags other) noexcept { f |= other.f; }
+			FORCEINLINE constexpr void accumulate(const SlotFlags other) noexcept { f |= other.f; }
 
-			__forceinline constexpr void clear() noexcept { f = 0; }
+			FORCEINLINE constexpr void clear() noexcept { f = 0; }
 
-			__forceinline static constexpr bool is_valid_type(const u8 type) noexcept {
+			FORCEINLINE static constexpr bool is_valid_type(const u8 type) noexcept {
 				const u32 x1 = type - 1;	//  This unsets the lowest set bit and sets all the ones lower than it. eg.	1100->1011,		0001->0000,		1000->0111,			0000->1111 (underflow)
 				const u32 x2 = type ^ x1;//  This keeps the bit unset before, the bits set before, and no else. eg.	1100^1011=0111,	0001^0000=0001,	1000->0111=1111,	0000^1111=1111
 				return x1 < x2;				//  If power of 2, ^ result will always be greater than -1 result because bits are never lost. 0 won't pass because it won't provide bits to ^ to break the ==.
@@ -131,12 +131,12 @@ namespace Data {
 		// Count of each Hurdle keyword of equipped armors
 		struct HRCounts {
 		public:
-			__forceinline constexpr bool has(const HRKwd id) const noexcept { return counts[static_cast<size_t>(id)] != 0; }
-			__forceinline constexpr bool count(const HRKwd id) const noexcept { return counts[static_cast<size_t>(id)]; }
-			__forceinline constexpr void add(const HRKwd id) noexcept { counts[static_cast<size_t>(id)]++; }
-			__forceinline constexpr void remove(const HRKwd id) noexcept { counts[static_cast<size_t>(id)]--; }
-			__forceinline constexpr bool has_any_10_13() const noexcept { return counts[static_cast<size_t>(HRKwd::Hurdle_10)] bitor counts[static_cast<size_t>(HRKwd::Hurdle_13)]; }
-			__forceinline constexpr bool empty() const noexcept { return empty_flag; }
+			FORCEINLINE constexpr bool has(const HRKwd id) const noexcept { return counts[static_cast<size_t>(id)] != 0; }
+			FORCEINLINE constexpr bool count(const HRKwd id) const noexcept { return counts[static_cast<size_t>(id)]; }
+			FORCEINLINE constexpr void add(const HRKwd id) noexcept { counts[static_cast<size_t>(id)]++; }
+			FORCEINLINE constexpr void remove(const HRKwd id) noexcept { counts[static_cast<size_t>(id)]--; }
+			FORCEINLINE constexpr bool has_any_10_13() const noexcept { return counts[static_cast<size_t>(HRKwd::Hurdle_10)] bitor counts[static_cast<size_t>(HRKwd::Hurdle_13)]; }
+			FORCEINLINE constexpr bool empty() const noexcept { return empty_flag; }
 
 			void update_empty_flag() noexcept {
 				//  These all get inlined to 7 instructions (movzx, or, sete). The only cost is getting the array in a cacheline, which duh.
@@ -166,34 +166,34 @@ namespace Data {
 				AVOffset = static_cast<u8>(WeaponType::kTotal) + 1 // Just add 1 to bring ActorValue::kNone to 10. Unsigned overflow is defined.
 			};
 
-			__forceinline constexpr bool left_is(const WeaponType type) const noexcept { return left == static_cast<u8>(type); }
-			__forceinline constexpr bool left_is(const AV av) const noexcept { return left == (static_cast<u8>(av) + AVOffset); }
+			FORCEINLINE constexpr bool left_is(const WeaponType type) const noexcept { return left == static_cast<u8>(type); }
+			FORCEINLINE constexpr bool left_is(const AV av) const noexcept { return left == (static_cast<u8>(av) + AVOffset); }
 
-			__forceinline constexpr bool left_is_weapon() const noexcept { return (left != 0) & (left < AVOffset); }
-			__forceinline constexpr bool left_is_spell() const noexcept { return left >= AVOffset; }
+			FORCEINLINE constexpr bool left_is_weapon() const noexcept { return (left != 0) & (left < AVOffset); }
+			FORCEINLINE constexpr bool left_is_spell() const noexcept { return left >= AVOffset; }
 
-			__forceinline constexpr void left_set(const WeaponType type) noexcept { left = static_cast<u8>(type); }
-			__forceinline constexpr void left_set(const AV av) noexcept { left = static_cast<u8>(av) + AVOffset; }
+			FORCEINLINE constexpr void left_set(const WeaponType type) noexcept { left = static_cast<u8>(type); }
+			FORCEINLINE constexpr void left_set(const AV av) noexcept { left = static_cast<u8>(av) + AVOffset; }
 
-			__forceinline constexpr void left_unset() noexcept { left = 0; }
+			FORCEINLINE constexpr void left_unset() noexcept { left = 0; }
 
 
-			__forceinline constexpr bool right_is(const WeaponType type) const noexcept { return right == static_cast<u8>(type); }
-			__forceinline constexpr bool right_is(const AV av) const noexcept { return right == (static_cast<u8>(av) + AVOffset); }
+			FORCEINLINE constexpr bool right_is(const WeaponType type) const noexcept { return right == static_cast<u8>(type); }
+			FORCEINLINE constexpr bool right_is(const AV av) const noexcept { return right == (static_cast<u8>(av) + AVOffset); }
 
-			__forceinline constexpr bool right_is_weapon() const noexcept { return (right != 0) & (right < AVOffset); }
-			__forceinline constexpr bool right_is_spell() const noexcept { return right >= AVOffset; }
+			FORCEINLINE constexpr bool right_is_weapon() const noexcept { return (right != 0) & (right < AVOffset); }
+			FORCEINLINE constexpr bool right_is_spell() const noexcept { return right >= AVOffset; }
 
-			__forceinline constexpr void right_set(const WeaponType type) noexcept { right = static_cast<u8>(type); }
-			__forceinline constexpr void right_set(const AV av) noexcept { right = static_cast<u8>(av) + AVOffset; }
+			FORCEINLINE constexpr void right_set(const WeaponType type) noexcept { right = static_cast<u8>(type); }
+			FORCEINLINE constexpr void right_set(const AV av) noexcept { right = static_cast<u8>(av) + AVOffset; }
 
-			__forceinline constexpr void right_unset() noexcept { right = 0; }
+			FORCEINLINE constexpr void right_unset() noexcept { right = 0; }
 
-			__forceinline constexpr bool any_weapon() const noexcept { return left_is_weapon() | right_is_weapon(); }
-			__forceinline constexpr bool any_spell() const noexcept { return (left | right) >= AVOffset; }
+			FORCEINLINE constexpr bool any_weapon() const noexcept { return left_is_weapon() | right_is_weapon(); }
+			FORCEINLINE constexpr bool any_spell() const noexcept { return (left | right) >= AVOffset; }
 
 
-			__forceinline constexpr void clear() noexcept { left = 0;  right = 0; }
+			FORCEINLINE constexpr void clear() noexcept { left = 0;  right = 0; }
 
 			u8 left{};
 			u8 right{};
@@ -271,19 +271,19 @@ namespace Data {
 		struct ArmorEquippedFlags {
 			struct HRFlags {
 			public:
-				__forceinline constexpr bool has(const HRKwd kwd) const noexcept { return f & (1ui32 << static_cast<u8>(kwd)); }
-				__forceinline constexpr void set(const HRKwd kwd) noexcept { f |= (1ui32 << static_cast<u8>(kwd)); }
-				__forceinline constexpr void unset(const HRKwd kwd) noexcept { f &= ~(1ui32 << static_cast<u8>(kwd)); }
+				FORCEINLINE constexpr bool has(const HRKwd kwd) const noexcept { return f & (1u << static_cast<u8>(kwd)); }
+				FORCEINLINE constexpr void set(const HRKwd kwd) noexcept { f |= (1u << static_cast<u8>(kwd)); }
+				FORCEINLINE constexpr void unset(const HRKwd kwd) noexcept { f &= ~(1u << static_cast<u8>(kwd)); }
 
-				__forceinline constexpr bool any() const noexcept { return f != 0; }
+				FORCEINLINE constexpr bool any() const noexcept { return f != 0; }
 
 				template<HRKwd kwd> requires (kwd < HRKwd::Total)
-				__forceinline constexpr bool has() const noexcept {
-					enum : u32 { hrmask = 1ui32 << static_cast<u8>(kwd) };
+				FORCEINLINE constexpr bool has() const noexcept {
+					enum : u32 { hrmask = 1u << static_cast<u8>(kwd) };
 					return f & hrmask;
 				}
 
-				__forceinline constexpr void clear() noexcept { f = 0; }
+				FORCEINLINE constexpr void clear() noexcept { f = 0; }
 
 				u32 f{};
 			};
@@ -291,32 +291,32 @@ namespace Data {
 
 			struct CoverFlags {
 			public:
-				static constexpr u32 BodyMask = (1ui32 << static_cast<u8>(Slot::kBody));
-				static constexpr u32 HeadMask = (1ui32 << static_cast<u8>(Slot::kCirclet));
-				static constexpr u32 HandsMask = (1ui32 << static_cast<u8>(Slot::kHands));
-				static constexpr u32 FeetMask = (1ui32 << static_cast<u8>(Slot::kFeet));
+				static constexpr u32 BodyMask = (1u << static_cast<u8>(Slot::kBody));
+				static constexpr u32 HeadMask = (1u << static_cast<u8>(Slot::kCirclet));
+				static constexpr u32 HandsMask = (1u << static_cast<u8>(Slot::kHands));
+				static constexpr u32 FeetMask = (1u << static_cast<u8>(Slot::kFeet));
 				static constexpr u32 AnyBasicMask = (BodyMask | HeadMask | HandsMask | FeetMask);
 				static constexpr u32 NotBasicMask = ~AnyBasicMask;
 
-				__forceinline constexpr void set(const u32 slots) noexcept { f = slots; }
-				__forceinline constexpr bool has(const Slot s) const noexcept { return f & (1ui32 << static_cast<u32>(s)); }
-				__forceinline constexpr void set(const Slot s) noexcept { f |= (1ui32 << static_cast<u32>(s)); }
-				__forceinline constexpr void unset(const Slot s) noexcept { f &= ~(1ui32 << static_cast<u32>(s)); }
+				FORCEINLINE constexpr void set(const u32 slots) noexcept { f = slots; }
+				FORCEINLINE constexpr bool has(const Slot s) const noexcept { return f & (1u << static_cast<u32>(s)); }
+				FORCEINLINE constexpr void set(const Slot s) noexcept { f |= (1u << static_cast<u32>(s)); }
+				FORCEINLINE constexpr void unset(const Slot s) noexcept { f &= ~(1u << static_cast<u32>(s)); }
 
-				__forceinline constexpr bool any_basic() const noexcept { return f & AnyBasicMask; }
-				__forceinline constexpr bool not_basic() const noexcept { return (f & AnyBasicMask) == 0; }
-				__forceinline constexpr bool any() const noexcept { return f > 0; }
+				FORCEINLINE constexpr bool any_basic() const noexcept { return f & AnyBasicMask; }
+				FORCEINLINE constexpr bool not_basic() const noexcept { return (f & AnyBasicMask) == 0; }
+				FORCEINLINE constexpr bool any() const noexcept { return f > 0; }
 
-				__forceinline constexpr bool feet() const noexcept { return f & FeetMask; }
-				__forceinline constexpr bool not_feet() const noexcept { return (f & FeetMask) == 0; }
+				FORCEINLINE constexpr bool feet() const noexcept { return f & FeetMask; }
+				FORCEINLINE constexpr bool not_feet() const noexcept { return (f & FeetMask) == 0; }
 
-				__forceinline constexpr void clear() noexcept { f = 0; }
+				FORCEINLINE constexpr void clear() noexcept { f = 0; }
 
 				u32 f{};
 			};
 			static_assert(std::is_trivially_copyable_v<CoverFlags> and sizeof(CoverFlags) == 4);
 
-			__forceinline constexpr bool empty() const noexcept { return (hr.f == 0) bitand (slots.f == 0); }
+			FORCEINLINE constexpr bool empty() const noexcept { return (hr.f == 0) bitand (slots.f == 0); }
 
 			HRFlags hr{};
 			CoverFlags slots{};
@@ -342,18 +342,18 @@ namespace Data {
 			constexpr HandEquippedFlags(const WeaponType type) noexcept : f(static_cast<u8>(type)) {}
 			constexpr HandEquippedFlags(const AV av) noexcept : f(static_cast<u8>(av) + AVOffset) {}
 
-			__forceinline constexpr bool is(const WeaponType type) const noexcept { return f == static_cast<u8>(type); }
-			__forceinline constexpr bool is(const AV av) const noexcept { return f == (static_cast<u8>(av) + AVOffset); }
+			FORCEINLINE constexpr bool is(const WeaponType type) const noexcept { return f == static_cast<u8>(type); }
+			FORCEINLINE constexpr bool is(const AV av) const noexcept { return f == (static_cast<u8>(av) + AVOffset); }
 
-			__forceinline constexpr bool is_weapon() const noexcept { return (f != 0) & (f < AVOffset); }
-			__forceinline constexpr bool is_spell() const noexcept { return f >= AVOffset; }
+			FORCEINLINE constexpr bool is_weapon() const noexcept { return (f != 0) & (f < AVOffset); }
+			FORCEINLINE constexpr bool is_spell() const noexcept { return f >= AVOffset; }
 
-			__forceinline constexpr bool empty() const noexcept { return f == 0; }
+			FORCEINLINE constexpr bool empty() const noexcept { return f == 0; }
 
-			__forceinline constexpr void set(const WeaponType type) noexcept { f = static_cast<u8>(type); }
-			__forceinline constexpr void set(const AV av) noexcept { f = static_cast<u8>(av) + AVOffset; }
+			FORCEINLINE constexpr void set(const WeaponType type) noexcept { f = static_cast<u8>(type); }
+			FORCEINLINE constexpr void set(const AV av) noexcept { f = static_cast<u8>(av) + AVOffset; }
 
-			__forceinline constexpr void clear() noexcept { f = 0; }
+			FORCEINLINE constexpr void clear() noexcept { f = 0; }
 
 			u8 f{};
 		};
@@ -397,11 +397,12 @@ namespace Data {
 		float GetExposure() const noexcept {
 			const u8 slot32 = slots[static_cast<u64>(RE::BIPED_MODEL::BipedObjectSlot::kBody)].f;
 
-			static constexpr u8 TYPEMASK = 0b1110'0000ui8;
-			static constexpr u8 KYWDMASK = 0b0000'1111ui8; // Ignore nosoles, if somehow set.
+			static constexpr u8 TYPEMASK = u8{ 0b1110'0000 };
+			static constexpr u8 KYWDMASK = u8{ 0b0000'1111 }; // Ignore nosoles, if somehow set.
 
-			unsigned long kwdindex; // NonArmor:3   Torn:2   LowQual:1   MidQual:0   None:unspecified
-			const bool anykwd = _BitScanReverse(&kwdindex, (slot32 & KYWDMASK)); // false if all 0
+			const u32 kwdbits = slot32 & KYWDMASK;
+			const bool anykwd = kwdbits != 0;
+			const u32 kwdindex = static_cast<u32>(std::bit_width(kwdbits)) - 1; // NonArmor:3   Torn:2   LowQual:1   MidQual:0   None:unspecified
 
 			/*	if not worn: ((0 * ...) + (1 * 4)) * 0.25f = 1.0f
 				if worn and
@@ -429,7 +430,7 @@ namespace Data {
 
 		ArmorEquippedFlags ProcessArmorEquip(const RE::TESObjectARMO* armor) noexcept {
 			// Copy data, first thing
-			const lazy_vector<RE::BGSKeyword*> copiedKwds{ armor->keywords, armor->numKeywords };
+			const CopiedKeywords copiedKwds{ armor->keywords, armor->numKeywords };
 			const auto biped = armor->bipedModelData;
 
 			ArmorEquippedFlags changes{};
@@ -439,21 +440,21 @@ namespace Data {
 
 				newflags.set(biped.armorType.get()); // Set armor type
 
-				for (const auto match : ::Fear::KwdsToIdx(copiedKwds)) {
+				for (const auto match : ::Fear::KwdsToIdx(copiedKwds.data(), static_cast<u32>(copiedKwds.size()))) {
 					newflags.set(match); // Set Fear keyword flags
 				}
 
 				changes.slots.set(occupiedslots);
 				changes.flags = newflags;
 
-				unsigned long index;
-				while (_BitScanReverse(&index, occupiedslots)) {
-					occupiedslots ^= (1 << index); // Unset it. Can use ^ instead of &= ~... because we know occupiedslots has that bit set so ^ will unset it.
+				while (occupiedslots != 0) {
+					const u32 index = static_cast<u32>(std::bit_width(occupiedslots)) - 1;
+					occupiedslots ^= (1u << index); // Unset it. Can use ^ instead of &= ~... because we know occupiedslots has that bit set so ^ will unset it.
 					slots[index] = newflags; // Update flags on that slot
 				}
 			}
 
-			for (const auto match : Hurdles::KwdsToIdx(copiedKwds)) {
+			for (const auto match : Hurdles::KwdsToIdx(copiedKwds.data(), static_cast<u32>(copiedKwds.size()))) {
 				hr.add(match); // Set Hurdles keyword flags
 				changes.hr.set(match);
 			}
@@ -462,18 +463,18 @@ namespace Data {
 		}
 		void ProcessArmorUnequip(const RE::TESObjectARMO* armor) noexcept {
 			// Copy data, first thing
-			const lazy_vector<RE::BGSKeyword*> copiedKwds{ armor->keywords, armor->numKeywords };
+			const CopiedKeywords copiedKwds{ armor->keywords, armor->numKeywords };
 			const auto biped = armor->bipedModelData;
 
 			if (u32 occupiedslots = biped.bipedObjectSlots.underlying(); occupiedslots > 0) {
-				unsigned long index;
-				while (_BitScanReverse(&index, occupiedslots)) {
-					occupiedslots ^= (1 << index); // Unset it. Can use ^ instead of &= ~... because we know occupiedslots has that bit set so ^ will unset it.
+				while (occupiedslots != 0) {
+					const u32 index = static_cast<u32>(std::bit_width(occupiedslots)) - 1;
+					occupiedslots ^= (1u << index); // Unset it. Can use ^ instead of &= ~... because we know occupiedslots has that bit set so ^ will unset it.
 					slots[index].clear(); // Clear flags on that slot
 				}
 			}
 
-			for (const auto match : Hurdles::KwdsToIdx(copiedKwds)) {
+			for (const auto match : Hurdles::KwdsToIdx(copiedKwds.data(), static_cast<u32>(copiedKwds.size()))) {
 				hr.remove(match); // Set Hurdles keyword flags
 			}
 		}
@@ -20,10 +20,13 @@ namespace Data {
 
 		i8 FearRank() const noexcept { return scalef0100(fear); }
 		i8 ThrillseekingRank() const noexcept { return scalef0100(thrillseeking); }
-		i8 ThrillseekerRank() const noexcept { return static_cast<i8>((thrillseeking > 0.5f) * 3) - 2; }
+		i8 ThrillseekerRank() const noexcept { return ThrillseekerRankOf(thrillseeking); }
 		i8 FearsFemaleRank() const noexcept { return scalef0100(fears_female); }
 		i8 FearsMaleRank() const noexcept { return scalef0100(fears_male); }
 
+		static FORCEINLINE constexpr i8 scalef0100(const sat01flt val) noexcept { return static_cast<i8>(val * 100.0f); }
+		static FORCEINLINE constexpr i8 ThrillseekerRankOf(const sat01flt thrillseeking) noexcept { return static_cast<i8>((thrillseeking > 0.5f) * 3) - 2; }
+
 
 		void InitData(RE::Actor* act, const bool allow_writes) noexcept {
 			static RNG::gamerand gen{ RNG::random_state() };
@@ -102,11 +105,112 @@ namespace Data {
 		bool is_blocked{};					// 1
 		bool in_brawl{};					// 1
 		char pad[5];						// 31
+	};
+	static_assert(sizeof(FearInfo) == 32);
+
+
+	// FearInfo stored as columns, one per hot field, so Fear::Update streams just the fields it reads instead of whole 32 byte rows.
+	// is_female and in_brawl are packed in one byte per actor (flags). is_blocked is only read outside updates, so it sits alone as the cold remainder.
+	// FearInfo stays the row type for initialization and serialization, through row()/set_row()/append().
+	struct fear_columns {
+	public:
+		enum flag_bits : u8 {
+			Female = 1 << 0,
+			InBrawl = 1 << 1
+		};
+
+		// One actor's fields across the columns. Const if taken from a const fear_columns.
+		template<bool Const>
+		struct basic_ref {
+			template<typename T> using ref_t = std::conditional_t<Const, const T&, T&>;
+
+			ref_t<sat01flt> fear;
+			ref_t<sat01flt> thrillseeking;
+			ref_t<sat01flt> fears_female;
+			ref_t<sat01flt> fears_male;
+			ref_t<sat0flt> buildup_mod;
+			ref_t<optional_float> last_rest_day;
+			ref_t<u8> flags;
+			ref_t<bool> is_blocked;
+
+			constexpr bool is_female() const noexcept { return flags & Female; }
+			constexpr bool in_brawl() const noexcept { return flags & InBrawl; }
+			constexpr void set_in_brawl(const bool val) const noexcept requires (!Const) { flags = static_cast<u8>((flags & ~InBrawl) | (val * InBrawl)); }
+
+			i8 FearRank() const noexcept { return FearInfo::scalef0100(fear); }
+			i8 ThrillseekingRank() const noexcept { return FearInfo::scalef0100(thrillseeking); }
+			i8 ThrillseekerRank() const noexcept { return FearInfo::ThrillseekerRankOf(thrillseeking); }
+			i8 FearsFemaleRank() const noexcept { return FearInfo::scalef0100(fears_female); }
+			i8 FearsMaleRank() const noexcept { return FearInfo::scalef0100(fears_male); }
+		};
+		using ref = basic_ref<false>;
+		using const_ref = basic_ref<true>;
+
+		constexpr ref operator[](const size_t idx) noexcept { return { fear[idx], thrillseeking[idx], fears_female[idx], fears_male[idx], buildup_mod[idx], last_rest_day[idx], flags[idx], is_blocked[idx] }; }
+		constexpr const_ref operator[](const size_t idx) const noexcept { return { fear[idx], thrillseeking[idx], fears_female[idx], fears_male[idx], buildup_mod[idx], last_rest_day[idx], flags[idx], is_blocked[idx] }; }
+
+		constexpr size_t size() const noexcept { return fear.size(); }
+
+		FearInfo row(const size_t idx) const noexcept {
+			FearInfo info{};
+			info.fear = fear[idx];
+			info.thrillseeking = thrillseeking[idx];
+			info.fears_female = fears_female[idx];
+			info.fears_male = fears_male[idx];
+			info.buildup_mod = buildup_mod[idx];
+			info.last_rest_day = last_rest_day[idx];
+			info.is_female = flags[idx] & Female;
+			info.in_brawl = flags[idx] & InBrawl;
+			info.is_blocked = is_blocked[idx];
+			return info;
+		}
+		void set_row(const size_t idx, const FearInfo& info) noexcept {
+			fear[idx] = info.fear;
+			thrillseeking[idx] = info.thrillseeking;
+			fears_female[idx] = info.fears_female;
+			fears_male[idx] = info.fears_male;
+			buildup_mod[idx] = info.buildup_mod;
+			last_rest_day[idx] = info.last_rest_day;
+			flags[idx] = static_cast<u8>((info.is_female * Female) | (info.in_brawl * InBrawl));
+			is_blocked[idx] = info.is_blocked;
+		}
+
+		constexpr bool reserve(const size_t newcap) noexcept { return all([newcap](auto& col) { return col.reserve(newcap); }); }
+		constexpr bool resize(const size_t newsize) noexcept { return all([newsize](auto& col) { return col.resize(newsize); }); }
+		constexpr void clear() noexcept { all([](auto& col) { col.clear(); return true; }); }
+
+		// Unchecked, like lazy_vector::append()
+		void append(const FearInfo& info) noexcept {
+			all([](auto& col) { col.append(); return true; });
+			set_row(size() - 1, info);
+		}
+		constexpr void erase(const size_t idx) noexcept { all([idx](auto& col) { col.erase(idx); return true; }); }
+		constexpr void swap(const size_t idx1, const size_t idx2) noexcept { all([idx1, idx2](auto& col) { std::swap(col[idx1], col[idx2]); return true; }); }
+		constexpr void copy_row(const size_t dst, const size_t src) noexcept { all([dst, src](auto& col) { col[dst] = col[src]; return true; }); }
+		// [src, src + count) to [dst, dst + count). Ranges must not overlap.
+		void copy_rows(const size_t dst, const size_t src, const size_t count) noexcept {
+			all([dst, src, count](auto& col) { std::memcpy(col.begin() + dst, col.begin() + src, count * sizeof(col[0])); return true; });
+		}
+
+		// Hot
+		lazy_vector<sat01flt> fear{};			// How afraid the character is.
+		lazy_vector<sat01flt> thrillseeking{};	// How much the character likes the thrill.
+		lazy_vector<sat01flt> fears_female{};	// How much the character fears females.
+		lazy_vector<sat01flt> fears_male{};		// How much the character fears males.
+		lazy_vector<sat0flt> buildup_mod{};
+		lazy_vector<optional_float> last_rest_day{};	// Days passed from game start to the character's last full rest. has_value() == false if never rested (newly spawned NPCs).
+		lazy_vector<u8> flags{};				// flag_bits
+		// Cold
+		lazy_vector<bool> is_blocked{};
 
 	private:
-		static __forceinline constexpr i8 scalef0100(const sat01flt val) noexcept { return static_cast<i8>(val * 100.0f); }
+		// Applies fn to every column, stopping at the first false
+		template<typename Fn>
+		constexpr bool all(Fn&& fn) noexcept {
+			return fn(fear) and fn(thrillseeking) and fn(fears_female) and fn(fears_male) and fn(buildup_mod) and fn(last_rest_day) and fn(flags) and fn(is_blocked);
+		}
 	};
-	static_assert(sizeof(FearInfo) == 32);
+	static_assert(std::is_trivially_copyable_v<sat01flt> and std::is_trivially_copyable_v<sat0flt> and std::is_trivially_copyable_v<optional_float>); // copy_rows() memcpys
 
 
 
@@ -0,0 +1,304 @@
+#include "FearKernel.h"
+#include "Utils/PrimitiveUtils.h"
+#include "Utils/RNG.h"
+
+#include <immintrin.h>
+
+namespace Data::Fear::Kernel {
+
+	params Paced(const float hostile, const float interior, const milliseconds delta) noexcept {
+		const float ticks = std::min(static_cast<float>(delta.count()) / static_cast<float>(TickInterval.count()), MaxTicks);
+		return params{ .hostile = hostile, .interior = interior, .ticks = ticks, .step = 1.0f - std::exp2(-ticks) }; // Exactly 0.5 at 1 tick
+	}
+
+
+	void RunScalar(lanes& l, const u32 begin, const u32 end, const params p) noexcept {
+		for (u32 i = begin; i < end; ++i) {
+			const float days_since_rest = l.days_since_rest[i];
+
+			float buildup = std::max(days_since_rest, (i == 0) ? days_since_rest : 7.0f); // NPC cap at a week, because they most go without for long times
+			if (buildup > 1.0f) {
+				buildup = std::sqrt(buildup); // Introduce diminishing growth above 1. Let before be linear.
+			}
+			buildup *= std::sqrt(l.buildup_mod[i]);
+
+			float gain = 0.0f;
+			float loss = 0.0f;
+
+			// Factor in HP ratio (-)
+			const float hppcnt = l.hppcnt[i];
+			loss += (4.0f - (0.0004f * hppcnt * hppcnt)) * p.hostile;	// 0 to 4 exponentially as HP decreases, increased by 50% if in hostile location
+			// Factor in combat state (-)
+			loss += l.combat[i] * p.interior;	// 0 not in combat, 1 in combat outside, 2 in combat inside
+
+			// Factor in seen by (+)
+			const float thrill_mod = l.thrill_mod[i], fears_male = l.fears_male[i], fears_female = l.fears_female[i];
+			gain += thrill_mod * fears_male * std::sqrt(l.seen_by_m[i]);
+			gain += thrill_mod * fears_female * std::sqrt(l.seen_by_f[i]);
+			// Factor in seeing (+/-)
+			const float seeing_m_scaled = std::sqrt(l.seeing_exposure_m[i]);
+			const float seeing_f_scaled = std::sqrt(l.seeing_exposure_f[i]);
+			const bool dislike_m = fears_male < 0.5f;
+			const bool dislike_f = fears_female < 0.5f;
+			gain += !dislike_m ? (seeing_m_scaled * fears_male) : 0.0f;
+			gain += !dislike_f ? (seeing_f_scaled * fears_female) : 0.0f;
+			loss += (dislike_m and (dislike_f or (seeing_f_scaled == 0.0f))) ? (seeing_m_scaled * (1.0f - fears_male)) : 0.0f;
+			loss += (dislike_f and (dislike_m or (seeing_m_scaled == 0.0f))) ? (seeing_f_scaled * (1.0f - fears_female)) : 0.0f;
+
+			/*
+				Like?		Always gain.
+				Dislike?	Loss if not seeing anyone liked.
+				If not seeing anything of a category, that should result in 0 gain or loss.
+
+				seeF	seeM	likeF	likeM	resF/resM
+				0		0		0		0		0/0 (no presence is noop)
+				0		0		0		1		0/0
+				0		0		1		0		0/0
+				0		0		1		1		0/0
+
+				1		0		0		0		L/0
+				0		1		0		0		0/L
+				1		1		0		0		L/L
+
+				1		0		0		1		L/0
+				1		0		1		0		G/0
+				1		0		1		1		G/0
+				
+				0		1		0		1		0/G
+				0		1		1		0		0/L
+				0		1		1		1		0/G
+
+				1		1		0		1		0/G
+				1		1		1		0		G/0
+				1		1		1		1		G/G
+			*/
+
+			// Pick base value based on buildup, scale gains and losses according to buildup, and calculate target (unclamped) fear
+			const float base = 0.5f - (0.5f / std::sqrt(days_since_rest + 1.0f)); // ~.15 at 1 day, ~.21 at 2, ~.32 at a week, ~.37 at 2, ~.41 at a month, ~.43 at 6
+			const float gainmod = gain * buildup; // Increase with buildup
+			const float lossmod = loss / (buildup + FLT_MIN); // Decrease with buildup. Avoid division by 0 by flat-out adding the min positive float value.
+			const float target_fear = base + gainmod + lossmod;
+
+			// Move halfway towards new fear per tick
+			const float old_fear = l.old_fear[i];
+			l.buildup[i] = buildup;
+			l.new_fear[i] = old_fear + (p.step * (target_fear - old_fear)); // 0.5 step:	1:50%,  2:75%,  3:87.5%,  4:93.75%,  5:96.875%
+		}
+	}
+
+
+	static FORCEINLINE __m128 select(const __m128 mask, const __m128 a, const __m128 b) noexcept { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); } // mask ? a : b, per lane. Just SSE2 so no blendv.
+
+	void RunSIMD(lanes& l, const u32 begin, const u32 end, const params p) noexcept {
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 four = _mm_set1_ps(4.0f);
+		const __m128 hp_scale = _mm_set1_ps(0.0004f);
+		const __m128 flt_min = _mm_set1_ps(FLT_MIN);
+		const __m128 hostile = _mm_set1_ps(p.hostile);
+		const __m128 interior = _mm_set1_ps(p.interior);
+		const __m128 npc_floor = _mm_set1_ps(7.0f);
+		const __m128 first_floor = _mm_setr_ps(-INFINITY, 7.0f, 7.0f, 7.0f); // Player is lane 0 of the first block, and gets no floor
+		const __m128 step = _mm_set1_ps(p.step);
+
+		for (u32 i = begin; i < end; i += lanes::Width) {
+			const __m128 days_since_rest = _mm_load_ps(&l.days_since_rest[i]);
+
+			__m128 buildup = _mm_max_ps(days_since_rest, (i == 0) ? first_floor : npc_floor);
+			buildup = select(_mm_cmpgt_ps(buildup, one), _mm_sqrt_ps(buildup), buildup);
+			buildup = _mm_mul_ps(buildup, _mm_sqrt_ps(_mm_load_ps(&l.buildup_mod[i])));
+
+			const __m128 hppcnt = _mm_load_ps(&l.hppcnt[i]);
+			__m128 loss = _mm_add_ps(zero, _mm_mul_ps(_mm_sub_ps(four, _mm_mul_ps(_mm_mul_ps(hp_scale, hppcnt), hppcnt)), hostile));
+			loss = _mm_add_ps(loss, _mm_mul_ps(_mm_load_ps(&l.combat[i]), interior));
+
+			const __m128 thrill_mod = _mm_load_ps(&l.thrill_mod[i]);
+			const __m128 fears_male = _mm_load_ps(&l.fears_male[i]);
+			const __m128 fears_female = _mm_load_ps(&l.fears_female[i]);
+			__m128 gain = _mm_add_ps(zero, _mm_mul_ps(_mm_mul_ps(thrill_mod, fears_male), _mm_sqrt_ps(_mm_load_ps(&l.seen_by_m[i]))));
+			gain = _mm_add_ps(gain, _mm_mul_ps(_mm_mul_ps(thrill_mod, fears_female), _mm_sqrt_ps(_mm_load_ps(&l.seen_by_f[i]))));
+
+			const __m128 seeing_m_scaled = _mm_sqrt_ps(_mm_load_ps(&l.seeing_exposure_m[i]));
+			const __m128 seeing_f_scaled = _mm_sqrt_ps(_mm_load_ps(&l.seeing_exposure_f[i]));
+			const __m128 dislike_m = _mm_cmplt_ps(fears_male, half);
+			const __m128 dislike_f = _mm_cmplt_ps(fears_female, half);
+			gain = _mm_add_ps(gain, _mm_andnot_ps(dislike_m, _mm_mul_ps(seeing_m_scaled, fears_male)));
+			gain = _mm_add_ps(gain, _mm_andnot_ps(dislike_f, _mm_mul_ps(seeing_f_scaled, fears_female)));
+			loss = _mm_add_ps(loss, _mm_and_ps(_mm_and_ps(dislike_m, _mm_or_ps(dislike_f, _mm_cmpeq_ps(seeing_f_scaled, zero))), _mm_mul_ps(seeing_m_scaled, _mm_sub_ps(one, fears_male))));
+			loss = _mm_add_ps(loss, _mm_and_ps(_mm_and_ps(dislike_f, _mm_or_ps(dislike_m, _mm_cmpeq_ps(seeing_m_scaled, zero))), _mm_mul_ps(seeing_f_scaled, _mm_sub_ps(one, fears_female))));
+
+			const __m128 base = _mm_sub_ps(half, _mm_div_ps(half, _mm_sqrt_ps(_mm_add_ps(days_since_rest, one))));
+			const __m128 target_fear = _mm_add_ps(_mm_add_ps(base, _mm_mul_ps(gain, buildup)), _mm_div_ps(loss, _mm_add_ps(buildup, flt_min)));
+
+			const __m128 old_fear = _mm_load_ps(&l.old_fear[i]);
+			_mm_store_ps(&l.buildup[i], buildup);
+			_mm_store_ps(&l.new_fear[i], _mm_add_ps(old_fear, _mm_mul_ps(step, _mm_sub_ps(target_fear, old_fear))));
+		}
+	}
+
+
+	alignas(16) static constexpr array<array<u32, lanes::Width>, 16> NibbleMasks = [] {
+		array<array<u32, lanes::Width>, 16> masks{};
+		for (u32 nibble = 0; nibble < 16; ++nibble) {
+			for (u32 lane = 0; lane < lanes::Width; ++lane) {
+				masks[nibble][lane] = ((nibble >> lane) & 1) ? ~0u : 0u;
+			}
+		}
+		return masks;
+	}();
+	static_assert(lanes::Width == 4);
+
+	void SeeingExposures(const lanes& l, const UpdateTypes::seeing_matrix& seeing, const u32 i, float& sum_m, float& sum_f) noexcept {
+		using UpdateTypes::seeing_matrix;
+
+		__m128 acc_m = _mm_setzero_ps();
+		__m128 acc_f = _mm_setzero_ps();
+		const seeing_matrix::word* const row = seeing.seeing_row(i);
+		for (u32 w = 0, words = seeing.word_count(); w < words; ++w) {
+			const seeing_matrix::word self_out = (w == (i / seeing_matrix::WordBits)) ? ~(1ull << (i % seeing_matrix::WordBits)) : ~0ull;
+			u32 j = w * seeing_matrix::WordBits;
+			for (seeing_matrix::word bits = row[w] & self_out; bits != 0; bits >>= lanes::Width, j += lanes::Width) { // Bits past actor_count are never set, so padding lanes always get masked out
+				const __m128 mask = _mm_castsi128_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(NibbleMasks[bits & 0xF].data())));
+				acc_m = _mm_add_ps(acc_m, _mm_and_ps(mask, _mm_load_ps(&l.exposure_m[j])));
+				acc_f = _mm_add_ps(acc_f, _mm_and_ps(mask, _mm_load_ps(&l.exposure_f[j])));
+			}
+		}
+		// Horizontal adds. Lanes pair up the same way every time, so the sums only depend on who is seen.
+		const __m128 pairs = _mm_add_ps(_mm_unpacklo_ps(acc_m, acc_f), _mm_unpackhi_ps(acc_m, acc_f)); // m0+m2, f0+f2, m1+m3, f1+f3
+		const __m128 sums = _mm_add_ps(pairs, _mm_movehl_ps(pairs, pairs)); // m, f in the low 2 lanes
+		sum_m = _mm_cvtss_f32(sums);
+		sum_f = _mm_cvtss_f32(_mm_shuffle_ps(sums, sums, _MM_SHUFFLE(1, 1, 1, 1)));
+	}
+
+
+	results Compute(lanes& l,
+					fear_columns& infos,
+					const lazy_vector<float>& exposures,
+					const array<UpdateTypes::main_out, lanes::Capacity>& mains,
+					const UpdateTypes::seeing_matrix& seeing,
+					const array<trivial_handle, lanes::Capacity>& handles,
+					UpdateTypes::ranks_and_oneofs& pack,
+					const params p,
+					const u32 update_index,
+					SyncTypes::worker_pool* pool) noexcept
+	{
+		using UpdateTypes::seeing_matrix;
+		using PrimitiveUtils::mask_float;
+
+		const u32 actor_count = pack.actor_count;
+		const bool need_ranks = pack.need_ranks;
+		const float now = pack.now;
+
+		// Stream the columns. The seeing loop only ever touches flags and exposures of the others.
+		sat01flt* const fear_col = infos.fear.data();
+		sat01flt* const thrill_col = infos.thrillseeking.data();
+		const sat01flt* const fears_female_col = infos.fears_female.data();
+		const sat01flt* const fears_male_col = infos.fears_male.data();
+		sat0flt* const buildup_col = infos.buildup_mod.data();
+		const optional_float* const rest_col = infos.last_rest_day.data();
+		const u8* const flags_col = infos.flags.data();
+
+		// Who is male, as bits laid out like the seeing rows, so mutual seeing counts are a popcount per word.
+		// And what seeing each actor adds, split by sex into columns, so seeing sums are masked adds over them.
+		const u32 words = seeing.word_count();
+		array<seeing_matrix::word, seeing_matrix::MaxWords> male_bits{};
+		for (u32 j = 0; j < actor_count; ++j) {
+			const u8 flags_j = flags_col[j];
+			const bool male = !(flags_j & fear_columns::Female);
+			male_bits[j / seeing_matrix::WordBits] |= static_cast<seeing_matrix::word>(male) << (j % seeing_matrix::WordBits);
+			const float exp_base = exposures[j] + static_cast<bool>(flags_j & fear_columns::InBrawl); // Seeing someone in scene just adds 1-2 instead of 0-1, based on exposure.
+			const float exp_m = mask_float(exp_base, male);
+			l.exposure_m[j] = exp_m;
+			l.exposure_f[j] = exp_base - exp_m; // If exp_m is 0, then female, so base. If exp_m is base, then male, so 0. Trades a mask calculation for a subtraction.
+		}
+
+		// Everything from here is per actor, reading only the shared columns above and writing only its own rows, so any split of [0, actor_count) gives the same results
+		array<u32, lanes::Capacity> seen_counts; // Mutual seeing counts for the thrillseeking rolls
+		auto update_range = [&](const u32 begin, const u32 end) {
+			// Gather each actor's inputs into lanes. Seeing reduces to word ops on the seeing rows.
+			for (u32 i = begin; i < end; ++i) {
+				l.days_since_rest[i] = now - rest_col[i].value_or(0.0f); // Treat rest-less as 0.0f
+				l.buildup_mod[i] = buildup_col[i].get();
+				buildup_col[i] -= p.ticks; // Remove 1 per tick. For reference, dodging adds 1.
+				l.hppcnt[i] = mains[i].hppcnt;
+				l.combat[i] = mains[i].combat;
+
+				// Calculate seen by and seeing stuff
+				u32 seen_by_m = 0;
+				u32 seen_by_f = 0;
+				const seeing_matrix::word* const sees_row = seeing.seeing_row(i);
+				const seeing_matrix::word* const seen_row = seeing.seen_by_row(i);
+				for (u32 w = 0; w < words; ++w) {
+					const seeing_matrix::word self_out = (w == (i / seeing_matrix::WordBits)) ? ~(1ull << (i % seeing_matrix::WordBits)) : ~0ull;
+					const seeing_matrix::word mutual = sees_row[w] & self_out & seen_row[w];
+					seen_by_m += static_cast<u32>(std::popcount(mutual & male_bits[w]));
+					seen_by_f += static_cast<u32>(std::popcount(mutual & ~male_bits[w])); // Bits past actor_count are never set, so no need to mask them out
+				}
+				float seeing_exposure_m, seeing_exposure_f;
+				SeeingExposures(l, seeing, i, seeing_exposure_m, seeing_exposure_f);
+				const u32 inscene = static_cast<bool>(flags_col[i] & fear_columns::InBrawl); // Ensure single read
+				seen_by_m <<= inscene; // Consider being seen twice as effective if in scene
+				seen_by_f <<= inscene;
+				seen_counts[i] = seen_by_m + seen_by_f;
+				l.seen_by_m[i] = static_cast<float>(seen_by_m);
+				l.seen_by_f[i] = static_cast<float>(seen_by_f);
+				l.seeing_exposure_m[i] = seeing_exposure_m;
+				l.seeing_exposure_f[i] = seeing_exposure_f;
+				l.thrill_mod[i] = exposures[i] * thrill_col[i];
+				l.fears_male[i] = fears_male_col[i];
+				l.fears_female[i] = fears_female_col[i];
+				l.old_fear[i] = fear_col[i];
+			}
+
+			RunSIMD(l, begin, end, p);
+
+			for (u32 i = begin; i < end; ++i) {
+				// Maybe increase thrillseeking, AFTER the old value has been used for calculations
+				const bool inc_thrill = RNG::hashf01(handles[i].native_handle(), update_index) < (exposures[i] * (seen_counts[i] >> 4) * p.ticks); // So, seen count / 16 (or * 0.0625), scaled from 0 to self depending on exposure, per tick
+				thrill_col[i] += mask_float(0.01f, inc_thrill); // Add a fixed amount of thrillseeking. Prevents rapid growth for excessive streakers but behaves just like a curve in the long run.
+
+				fear_col[i] = l.new_fear[i]; // fear saturates in [0,1]
+
+				if (need_ranks) { // Maybe will change once or twice per playthough. It's basically asking if the user uses OD's FEAR reqork. So, basically always predicted.
+					auto& ranks = pack.ranks[i];
+					ranks[0] = FearInfo::scalef0100(fear_col[i]);
+					ranks[1] = FearInfo::scalef0100(thrill_col[i]);
+					ranks[2] = FearInfo::ThrillseekerRankOf(thrill_col[i]);
+				}
+			}
+		};
+		if (pool) {
+			pool->run(actor_count, lanes::Width * 4, update_range); // 16 floats, so ranges don't share cachelines of the columns
+		} else {
+			update_range(0, actor_count);
+		}
+
+		return results{ .most_afraid_idx = MostAfraid(l, actor_count), .player_tension = l.buildup[0] };
+	}
+
+	u32 MostAfraid(const lanes& l, const u32 count) noexcept {
+		float highest_fear = 0.0f;
+		u32 most_afraid_idx = 0;
+		for (u32 i = 0; i < count; ++i) {
+			const float fear = l.new_fear[i]; // Use unclamped for some potential tie-breaking
+			most_afraid_idx += static_cast<u32>((i - most_afraid_idx) bitand PrimitiveUtils::bool_extend<u32>(fear >= highest_fear));
+			highest_fear = std::max(highest_fear, fear);
+		}
+		return most_afraid_idx;
+	}
+
+
+	u32 UlpDistance(const float a, const float b) noexcept {
+		if (std::isnan(a) or std::isnan(b)) {
+			return std::numeric_limits<u32>::max();
+		}
+		auto ordered = [](const float f) { // Maps floats onto integers in the same order, so adjacent floats are 1 apart and -0 meets +0
+			const i32 bits = std::bit_cast<i32>(f);
+			return static_cast<i64>((bits < 0) ? (std::numeric_limits<i32>::min() - bits) : bits);
+		};
+		const i64 diff = ordered(a) - ordered(b);
+		return static_cast<u32>(std::min<i64>((diff < 0) ? -diff : diff, std::numeric_limits<u32>::max()));
+	}
+
+}
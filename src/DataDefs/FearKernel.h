@@ -0,0 +1,89 @@
+#pragma once
+#include "BaseTypes.h"
+#include "FearInfo.h"
+#include "Types/SyncTypes.h"
+#include <chrono>
+
+namespace Data::Fear::Kernel {
+	using std::chrono::milliseconds;
+
+	// Per-actor inputs and outputs of the Fear math, one column each, so the SIMD version can work on Width actors at a time.
+	// Columns are padded to a multiple of Width. Lanes past the actor count hold leftovers, get computed anyway, and are never read back.
+	struct lanes {
+		enum : u32 {
+			Width = 4,	// SSE floats per register
+			Capacity = UpdateTypes::MaxUpdateCount
+		};
+		static_assert((Capacity % Width) == 0);
+		using column = array<float, Capacity>;
+
+		// In
+		alignas(16) column days_since_rest{};
+		alignas(16) column buildup_mod{};	// Before sqrt
+		alignas(16) column hppcnt{};
+		alignas(16) column combat{};		// 0 or 1
+		alignas(16) column seen_by_m{};		// Mutual seeing counts, doubled if in scene
+		alignas(16) column seen_by_f{};
+		alignas(16) column seeing_exposure_m{};
+		alignas(16) column seeing_exposure_f{};
+		alignas(16) column thrill_mod{};	// Exposure times thrillseeking
+		alignas(16) column fears_male{};
+		alignas(16) column fears_female{};
+		alignas(16) column old_fear{};
+		alignas(16) column exposure_m{};	// What seeing each actor adds to the seeing sums of the males-seen and the females-seen sides. 0 on the other side.
+		alignas(16) column exposure_f{};
+		// Out
+		alignas(16) column buildup{};
+		alignas(16) column new_fear{};	// Unclamped
+	};
+
+	// The default update interval the Fear math was tuned at. An update of delta moves fear, decays buildup_mod and rolls thrillseeking as if it were delta / TickInterval of them,
+	// so how fast those go per second doesn't depend on how often updates come.
+	inline constexpr milliseconds TickInterval{ 7000 };
+	inline constexpr float MaxTicks = 3.0f; // The longest interval updates back off to. More than that, and nothing was computed for a while, so don't catch up on it.
+
+	struct params {
+		float hostile;			// 1.0f or 1.5f
+		float interior;			// 1.0f or 2.0f
+		float ticks{ 1.0f };	// Update delta in TickIntervals, at most MaxTicks
+		float step{ 0.5f };		// Part of the way to the target fear moved, 1 - 0.5^ticks
+	};
+	// params of an update delta long
+	params Paced(const float hostile, const float interior, const milliseconds delta) noexcept;
+
+	// Reference version, one actor at a time, over [begin, end). Treats actor 0 as the player.
+	void RunScalar(lanes& l, const u32 begin, const u32 end, const params p) noexcept;
+	// Same math, Width actors at a time with SSE. begin must be a multiple of Width. Does the same operations in the same order, and SSE sqrt and division round like scalar ones, so results match RunScalar() to the bit.
+	// That takes the scalar side not being contracted into FMAs, which holds for MSVC x64 /fp:precise without /arch:AVX2 or /fp:contract (and GCC/Clang without -ffp-contract=fast). CheckFearKernel() asserts it.
+	void RunSIMD(lanes& l, const u32 begin, const u32 end, const params p) noexcept;
+
+	// Sums exposure_m and exposure_f over the actors i sees, as in the seeing row, leaving i out. Masks Width columns at a time by a nibble of the row, so the cost follows the highest actor seen rather than how many.
+	void SeeingExposures(const lanes& l, const UpdateTypes::seeing_matrix& seeing, const u32 i, float& sum_m, float& sum_f) noexcept;
+
+	// Actors from which Compute() is worth giving a pool. Below that, waking the workers costs more than they save.
+	inline constexpr u32 ParallelMinActors = 96;
+
+	struct results {
+		u32 most_afraid_idx;
+		float player_tension;
+	};
+	// A whole Fear update of pack.actor_count actors: gathers into l, runs the math, and writes fears, thrillseeking and (if pack.need_ranks) pack.ranks back. Treats [0] as the player.
+	// Each actor's thrillseeking roll comes from its own stream, keyed by its handle and update_index, so with a pool the actors can be split across threads and results stay the same to the bit.
+	results Compute(lanes& l,
+					fear_columns& infos,
+					const lazy_vector<float>& exposures,
+					const array<UpdateTypes::main_out, lanes::Capacity>& mains,
+					const UpdateTypes::seeing_matrix& seeing,
+					const array<trivial_handle, lanes::Capacity>& handles,
+					UpdateTypes::ranks_and_oneofs& pack,
+					const params p,
+					const u32 update_index,
+					SyncTypes::worker_pool* pool) noexcept;
+
+	// Index of the highest new_fear of the first count actors, the last of them on ties. 0 if none is over 0.
+	u32 MostAfraid(const lanes& l, const u32 count) noexcept;
+
+	// Units in the last place between two floats, for checking the two versions against each other. Max if either is NaN.
+	u32 UlpDistance(const float a, const float b) noexcept;
+
+}
@@ -0,0 +1,102 @@
+#include "KeywordRecords.h"
+
+namespace ExtraKeywords::Records {
+	using PairSet::pair_set;
+
+	bool Write(SKSE::SerializationInterface& intfc, const pair_set& pairs) noexcept {
+		const size_t form_count = pairs.key_count();
+		if (!intfc.WriteRecordData(static_cast<u32>(form_count))) {
+			Log::Critical("Failed to serialize ExtraKeywords form count!"sv);
+			return false;
+		}
+		lazy_vector<u32> staged{};
+		bool ok = true;
+		pairs.for_each_block([&](const u32 formID, const std::span<const u64> block) {
+			const size_t words = 2 + block.size();
+			if (!ok or !staged.resize(words)) {
+				ok = false;
+				return;
+			}
+			staged[0] = formID;
+			staged[1] = static_cast<u32>(block.size());
+			for (size_t i = 0; i < block.size(); ++i) {
+				staged[2 + i] = pair_set::value_of(block[i]);
+			}
+			if (!intfc.WriteRecordData(staged.data(), static_cast<u32>(words * sizeof(u32)))) {
+				Log::Critical("Failed to serialize {:08X}'s extra keywords!"sv, formID);
+				ok = false;
+			}
+		});
+		return ok;
+	}
+
+	static bool ReadV1(SKSE::SerializationInterface& intfc, lazy_vector<u64>& out) noexcept {
+		u64 form_count;
+		if (intfc.ReadRecordData(form_count) != sizeof(form_count)) {
+			Log::Critical("Failed to read size of ExtraKeywords data map!"sv);
+			return false;
+		}
+		for (u64 i = 0; i < form_count; ++i) {
+			RE::FormID formID;
+			u64 keyword_count;
+			if ((intfc.ReadRecordData(formID) != sizeof(formID)) or (intfc.ReadRecordData(keyword_count) != sizeof(keyword_count))) {
+				Log::Critical("Failed to deserialize ExtraKeywords form {} of {}!"sv, i, form_count);
+				return false;
+			}
+			if ((keyword_count > std::numeric_limits<u32>::max()) or !out.reserve(out.size() + keyword_count)) {
+				Log::Critical("Deserialized extra keyword count {} of {:08X} is corrupt!"sv, keyword_count, formID);
+				return false;
+			}
+			for (u64 k = 0; k < keyword_count; ++k) {
+				RE::FormID keyword;
+				if (intfc.ReadRecordData(keyword) != sizeof(keyword)) {
+					Log::Critical("Failed to read extra keyword formID for {:08X}!"sv, formID);
+					return false;
+				}
+				out.append(pair_set::make(formID, keyword));
+			}
+		}
+		return true;
+	}
+
+	static bool ReadBlocks(SKSE::SerializationInterface& intfc, lazy_vector<u64>& out) noexcept {
+		u32 form_count;
+		if (intfc.ReadRecordData(form_count) != sizeof(form_count)) {
+			Log::Critical("Failed to deserialize ExtraKeywords form count!"sv);
+			return false;
+		}
+		lazy_vector<u32> staged{};
+		for (u32 i = 0; i < form_count; ++i) {
+			array<u32, 2> header; // formID, keyword count
+			if (intfc.ReadRecordData(header) != sizeof(header)) {
+				Log::Critical("Failed to deserialize ExtraKeywords form {} of {}!"sv, i, form_count);
+				return false;
+			}
+			if ((header[1] > (std::numeric_limits<u32>::max() / sizeof(u32))) or !staged.resize(header[1]) or !out.reserve(out.size() + header[1])) {
+				Log::Critical("Deserialized extra keyword count {} of {:08X} is corrupt!"sv, header[1], header[0]);
+				return false;
+			}
+			const u32 bytes = header[1] * static_cast<u32>(sizeof(u32));
+			if ((bytes != 0) and (intfc.ReadRecordData(staged.data(), bytes) != bytes)) {
+				Log::Critical("Failed to deserialize {:08X}'s extra keywords!"sv, header[0]);
+				return false;
+			}
+			for (const u32 keyword : staged) {
+				out.append(pair_set::make(header[0], keyword));
+			}
+		}
+		return true;
+	}
+
+	bool Read(SKSE::SerializationInterface& intfc, const u32 version, lazy_vector<u64>& out) noexcept {
+		switch (version) {
+		case 1: { return ReadV1(intfc, out); }
+		case 2: { return ReadBlocks(intfc, out); }
+		default: {
+			Log::Critical("Unknown ExtraKeywords record version {}!"sv, version);
+			return false;
+		}
+		}
+	}
+
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include "Common.h"
+#include "Types/PairSet.h"
+
+namespace ExtraKeywords::Records {
+	using LazyVector::lazy_vector;
+
+	// The ExtraKeywords co-save record, pairs of (form formID, keyword formID).
+	// Version 2 writes the form count, then per form one block of its formID, its keyword count and its keywords, each a u32. One WriteRecordData() call per form.
+	// Version 1 wrote the form count and each form's keyword count as size_t, and every formID with its own call. Read() migrates it.
+
+	bool Write(SKSE::SerializationInterface& intfc, const PairSet::pair_set& pairs) noexcept;
+	// Appends the pairs as saved, unresolved, in saved order
+	bool Read(SKSE::SerializationInterface& intfc, const u32 version, lazy_vector<u64>& out) noexcept;
+
+}
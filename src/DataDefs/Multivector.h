@@ -1,9 +1,11 @@
 #pragma once
+#include "ActorRecords.h"
 #include "FearInfo.h"
 #include "PlayerRules.h"
 #include "EquipState.h"
 #include "Forms/VanillaForms.h"
 #include "Forms/RulesForms.h"
+#include "Types/HandleIndex.h"
 
 #include <ranges>
 
@@ -22,40 +24,79 @@ namespace Data {
 		constexpr ~multivector() noexcept = default;
 
 
-		constexpr size_t find_index(const trivial_handle hnd) const noexcept { return static_cast<size_t>(handles.find(hnd) - handles.begin()); }
+		constexpr size_t find_index(const trivial_handle hnd) const noexcept {
+			if (!index_valid) [[unlikely]] {
+				return static_cast<size_t>(handles.find(hnd) - handles.begin());
+			}
+			if (const u32 idx = index.find(hnd.native_handle()); (idx < handles.size()) and (handles[idx] == hnd)) { // Index can be stale for zeroed handles, so verify
+				return idx;
+			}
+			return handles.size();
+		}
 		constexpr bool is_valid(const size_t idx) const noexcept { return idx < size(); }
+		// Row of act, taking it from cold first if it waits there. size() if act has neither, or the row couldn't be added.
+		// Lookups of rows that may have gone cold must use this rather than find_index(), under the exclusive lock.
+		size_t find_or_take(const trivial_handle handle, RE::Actor* act) noexcept {
+			if (const size_t idx = find_index(handle); idx < size()) {
+				return idx;
+			}
+			if (has_cold(act) and reserve_all(1) and append_new(handle, act)) {
+				return size() - 1;
+			}
+			return size();
+		}
+		size_t find_or_take(RE::Actor* act) noexcept { return find_or_take(trivial_handle{ act }, act); }
+		// Whether act's row waits in cold, so shared lock holders know to call find_or_take() first
+		bool has_cold(const RE::Actor* act) const noexcept { return act and !cold.empty() and (cold.find(act->GetFormID()) < cold.size()); }
 
-		constexpr decltype(auto) fear(this auto& self, const size_t idx) noexcept { return self.fears[idx]; }
-		constexpr decltype(auto) equipstate(this auto& self, const size_t idx) noexcept { return self.equips[idx]; }
+		constexpr decltype(auto) fear(const size_t idx) noexcept { return fears[idx]; }
+		constexpr decltype(auto) fear(const size_t idx) const noexcept { return fears[idx]; }
+		constexpr decltype(auto) equipstate(const size_t idx) noexcept { return equips[idx]; }
+		constexpr decltype(auto) equipstate(const size_t idx) const noexcept { return equips[idx]; }
 
 		constexpr lazy_vector<trivial_handle>& all_handles() noexcept { return handles; }
-		constexpr lazy_vector<FearInfo>& all_fears() noexcept { return fears; }
+		constexpr fear_columns& all_fears() noexcept { return fears; }
 		constexpr const lazy_vector<EquipState>& all_equips() const noexcept { return equips; }
+		constexpr float exposure(const size_t idx) const noexcept { return exposures[idx]; }
+		constexpr const lazy_vector<float>& all_exposures() const noexcept { return exposures; }
+		constexpr UpdateTypes::applied_ranks& applied(const size_t idx) noexcept { return ranks[idx]; }
+		// Makes the next update write every rank again, to undo whatever else changed them
+		constexpr void forget_applied_ranks() noexcept { std::fill(ranks.begin(), ranks.end(), UpdateTypes::UnknownRanks); }
+
+		// Armor changes must go through these so the exposure column stays current
+		EquipState::ArmorEquippedFlags armor_equipped(const size_t idx, const RE::TESObjectARMO* armor) noexcept {
+			const auto flags = equips[idx].ProcessArmorEquip(armor);
+			exposures[idx] = equips[idx].GetExposure();
+			return flags;
+		}
+		EquipState& armor_unequipped(const size_t idx, const RE::TESObjectARMO* armor) noexcept {
+			equips[idx].ProcessArmorUnequip(armor);
+			exposures[idx] = equips[idx].GetExposure();
+			return equips[idx];
+		}
 
+		// Blocked rows are never cold, as Load() and demote_unseen() keep them hot, so this and player_is_blocked() need not look there
 		constexpr bool is_blocked(const trivial_handle hnd) const noexcept {
 			if (const size_t idx = find_index(hnd); idx < handles.size()) {
-				return fears[idx].is_blocked;
+				return fears.is_blocked[idx];
 			}
 			return false;
 		}
 		bool set_blocked(RE::Actor* act) noexcept {
 			const bool isplayer = act->IsPlayerRef();
 			const trivial_handle handle{ isplayer ? Vanilla::PlayerHandle() : act };
-			const size_t idx = find_index(handle);
+			const size_t idx = find_or_take(handle, act);
 			if (idx == size()) { // Not registered
-				if (!reserve_all(1)) {
+				if (!reserve_all(1) or !append_new(handle, act)) {
 					return false; // Couldn't allocate to register
 				}
-				handles.append(handle);
-				fears.append(act, true);
-				equips.append(act);
 			}
-			return fears[idx].is_blocked or (fears[idx].is_blocked = isplayer ? add_rulesplayer_spells(act) : add_rulesnpc_spells(act));
+			return fears.is_blocked[idx] or (fears.is_blocked[idx] = isplayer ? add_rulesplayer_spells(act) : add_rulesnpc_spells(act));
 		}
 		void unset_blocked(RE::Actor* act) noexcept {
 			const bool isplayer = act->IsPlayerRef();
-			if (const size_t idx = find_index(isplayer ? Vanilla::PlayerHandle() : act); idx < size()) {
-				fears[idx].is_blocked = false;
+			if (const size_t idx = find_or_take(isplayer ? Vanilla::PlayerHandle() : act, act); idx < size()) {
+				fears.is_blocked[idx] = false;
 				if (isplayer) {
 					remove_rules_player_spells(act);
 				} else {
@@ -63,13 +104,14 @@ namespace Data {
 				}
 			}
 		}
-		constexpr bool player_is_blocked() const noexcept {
+		bool player_is_blocked() const noexcept {
 			if (const auto idx = find_index(Vanilla::PlayerHandle()); idx < size()) {
-				return fears[idx].is_blocked;
+				return fears.is_blocked[idx];
 			}
 			return false;
 		}
-		constexpr auto& player_rules(this auto& self) noexcept { return self.prules; }
+		constexpr rules_info& player_rules() noexcept { return prules; }
+		constexpr const rules_info& player_rules() const noexcept { return prules; }
 
 
 		size_t has_or_add(RE::Actor* act) noexcept {
@@ -79,17 +121,22 @@ namespace Data {
 				return idx; // Existing
 			}
 			if (reserve_all(1)) {
-				handles.append(handle);
-				fears.append(act, true);
-				equips.append(act);
+				(void)append_new(handle, act);
 			}
 			return old_size; // Always return this here. If added, it is the index to it. If not, it is handles.size().
 		}
 
 		void erase(const size_t idx) noexcept {
+			index.erase(handles[idx].native_handle());
+			if (const size_t last = size() - 1; index_valid and (idx != last)) {
+				index.insert_or_assign(handles[last].native_handle(), static_cast<u32>(idx)); // Last gets moved to idx
+			}
 			handles.erase(idx);
 			fears.erase(idx);
 			equips.erase(idx);
+			exposures.erase(idx);
+			ranks.erase(idx);
+			unseen.erase(idx);
 		}
 
 		bool swap_allocate_move(array<trivial_handle, MaxUpdateCount>& handles_buffer, array<RE::ActorPtr, MaxUpdateCount>& ptrs_buffer, ranks_and_oneofs& pack) noexcept {
@@ -107,8 +154,8 @@ namespace Data {
 			auto tuple_comp = [](const auto& a, const auto& b) -> bool { return std::get<0>(a) < std::get<0>(b); };
 
 			// Find indexes and sort them with input
-			array<u32, 32> index_buffer{ [&]() {
-				array<u32, 32> idxs{};
+			array<u32, MaxUpdateCount> index_buffer{ [&]() {
+				array<u32, MaxUpdateCount> idxs{};
 				subrange ir{ idxs.begin(), idxs.begin() + actor_count };
 				std::transform(hnds.begin(), hnds.end(), ir.begin(), [this](const trivial_handle h) { return static_cast<u32>(find_index(h)); });	// Find indexes of all input handles
 				sort(zip(ir, hnds, ptrs), tuple_comp);	// Sort indexes and ptrs based on indexes only
@@ -142,7 +189,7 @@ namespace Data {
 					return swaps;
 				}() );
 
-				const auto smaller_end = [=] { // With input length at most 32, binary search will never beat this
+				const auto smaller_end = [=] { // Input is at most MaxUpdateCount long and the scan stops at the first bigger one, so binary search is not worth it
 					auto it = reg_idxs.begin();
 					while (*it < i_max) { // Guaranteed to break before it == end() because here we know at least the last element is not < i_max, so don't check
 						++it;
@@ -157,6 +204,8 @@ namespace Data {
 				sort(zip(reg_idxs, subrange{ hnds.begin(), hnds.begin() + registered_count }, subrange{ ptrs.begin(), ptrs.begin() + registered_count }), tuple_comp);
 			}
 
+			std::fill_n(unseen.begin(), registered_count, u8{ 0 });
+
 			// Let swaps always happen. Even if this fails, chances are most of the current actors will be in the next one, so the ordering isn't wasted.
 			if (unregistered_count != 0) {
 				const u32 oldsize = static_cast<u32>(handles.size());
@@ -171,14 +220,28 @@ namespace Data {
 				if (count_to_move != 0) {
 					const u32 dst_offset = newsize - count_to_move;
 					std::memcpy(handles.begin() + dst_offset, handles.begin() + src_offset, count_to_move * sizeof(trivial_handle));
-					std::memcpy(fears.begin() + dst_offset, fears.begin() + src_offset, count_to_move * sizeof(FearInfo));
+					fears.copy_rows(dst_offset, src_offset, count_to_move);
 					std::memcpy(equips.begin() + dst_offset, equips.begin() + src_offset, count_to_move * sizeof(EquipState));
+					std::memcpy(exposures.begin() + dst_offset, exposures.begin() + src_offset, count_to_move * sizeof(float));
+					std::memcpy(ranks.begin() + dst_offset, ranks.begin() + src_offset, count_to_move * sizeof(UpdateTypes::applied_ranks));
+					std::memcpy(unseen.begin() + dst_offset, unseen.begin() + src_offset, count_to_move * sizeof(u8));
+					for (u32 i = dst_offset; i < newsize; ++i) {
+						index_reserved(handles[i], i);
+					}
 				}
 				auto out_it = handles.begin() + src_offset;
 				for (auto in_it = (hnds.begin() + registered_count); in_it != hnds.end(); ++in_it, ++out_it) {
 					*out_it = *in_it; // Can initialize handles now. No need for main thread.
+					index_reserved(*in_it, static_cast<size_t>(out_it - handles.begin()));
 				}
-				return true; // Need to init in main
+				// Cold rows are taken as their actors show up, and need no init. Input i went to row i.
+				bool any_new = false;
+				for (u32 i = registered_count; i < actor_count; ++i) {
+					unseen[i] = 0;
+					restored[i] = !cold.empty() and take_cold(i, ptrs[i].get());
+					any_new |= !restored[i];
+				}
+				return any_new; // Need to init in main
 			} else {
 				return false; // No need to init in main
 			}
@@ -192,18 +255,20 @@ namespace Data {
 
 			// Log::Info("init_news initializing {} actors"sv, ptrs.size());
 
-			auto ars_it = fears.begin() + registered_count;
-			for (auto& ptr : ptrs) {
-				(ars_it++)->InitData(ptr.get(), allow_fear_writes);
-			}
-			auto eqp_it = equips.begin() + registered_count;
+			size_t ars_idx = registered_count;
 			for (auto& ptr : ptrs) {
-				(eqp_it++)->InitData(ptr.get());
+				if (!restored[ars_idx]) {
+					fears.set_row(ars_idx, FearInfo{ ptr.get(), allow_fear_writes });
+				}
+				++ars_idx;
 			}
-		}
-		void get_exposures(array<float, MaxUpdateCount>& exposures, const ranks_and_oneofs& pack) const noexcept {
-			for (u32 i = 0, end = pack.actor_count; i < end; ++i) {
-				exposures[i] = equips[i].GetExposure();
+			for (size_t idx = registered_count; auto& ptr : ptrs) {
+				if (!restored[idx]) {
+					equips[idx].InitData(ptr.get());
+					exposures[idx] = equips[idx].GetExposure();
+					ranks[idx] = UpdateTypes::UnknownRanks;
+				}
+				++idx;
 			}
 		}
 
@@ -236,10 +301,13 @@ namespace Data {
 			size_t idx_val = max;
 
 			if (handles[idx_inv].is_valid() and !advance_to_next_invalid(idx_inv)) {
+				if (!index_valid) {
+					reindex(); // Nothing moved, but try again to leave the scanning
+				}
 				return; // All handles are valid
 			}
 			if (!retreat_to_next_valid(idx_val)) {
-				clear();
+				clear_rows();
 				return; // All handles are invalid
 			}
 
@@ -247,35 +315,88 @@ namespace Data {
 
 			while (idx_inv < idx_val) {
 				handles[idx_inv] = handles[idx_val];
-				fears[idx_inv] = std::move(fears[idx_val]);
+				fears.copy_row(idx_inv, idx_val);
 				equips[idx_inv] = std::move(equips[idx_val]);
+				exposures[idx_inv] = exposures[idx_val];
+				ranks[idx_inv] = ranks[idx_val];
+				unseen[idx_inv] = unseen[idx_val];
 				advance_to_next_invalid(idx_inv);
 				retreat_to_next_valid(idx_val);
 			}
 
 			// Since everything below idx_inv has been filled, idx_val has retreated to the next highest valid, and idx_inv >= idx_val (loop broke), idx_val is now the index of the last element.
 			resize_all(idx_val + 1); // So add 1 to get the vectors size.
+			reindex(); // Most rows moved, and zeroed handles left stale entries behind
 		}
 
 
+		// Long updates only, before clear_zero_handles(). Moves the rows of actors not gathered for more than limit long updates to cold, and zeroes their handles so clear_zero_handles() drops them.
+		// 0 keeps every row hot. The player's and blocked actors' rows always stay hot, since rules bookkeeping looks them up directly.
+		void demote_unseen(const u32 limit) noexcept {
+			size_t due = 0;
+			for (u8& count : unseen) {
+				count += (count != std::numeric_limits<u8>::max());
+				due += (count > limit);
+			}
+			if ((limit == 0) or (due == 0) or !cold.reserve(due)) { // Stay hot if memory is short
+				return;
+			}
+			const trivial_handle player = Vanilla::PlayerHandle();
+			for (size_t i = 0, end = size(); i < end; ++i) {
+				if ((unseen[i] > limit) and !fears.is_blocked[i] and (handles[i] != player)) {
+					if (const RE::ActorPtr ptr = handles[i].get(); ptr and cold.add(ptr->GetFormID(), fears.row(i), equips[i])) { // Stays hot if memory is short
+						handles[i].reset();
+					}
+				}
+			}
+		}
+		// Long updates only. Drops up to budget cold rows of actors that died or were deleted since, the next ones each call, and compacts.
+		void sweep_cold(const size_t budget) noexcept {
+			cold.compact();
+			size_t row = cold.sweep_next;
+			for (size_t checked = 0, end = cold.size(); (checked < budget) and (checked < end); ++checked, ++row) {
+				if (row >= end) {
+					row = 0;
+				}
+				if (const RE::FormID formID = cold.formIDs[row]; formID != 0) {
+					if (RE::Actor* act = RE::TESForm::LookupByID<RE::Actor>(formID); !act or !IsValidKeepable(act)) {
+						cold.take(row);
+						if (cold.empty()) {
+							return; // take() cleared everything
+						}
+					}
+				}
+			}
+			cold.sweep_next = row;
+		}
+		size_t cold_count() const noexcept { return cold.count(); }
+
+
 		constexpr size_t size() const noexcept { return handles.size(); }
 		
-		constexpr void clear() noexcept {
-			handles.clear();
-			fears.clear();
-			equips.clear();
+		// Cold rows too. clear_rows() keeps them.
+		void clear() noexcept {
+			clear_rows();
+			cold.clear();
 		}
 
 		void swap(const size_t idx1, const size_t idx2) noexcept {
 			if (idx1 != idx2) {
 				handles[idx1].swap(handles[idx2]);
-				fears[idx1].Swap(fears[idx2]);
+				fears.swap(idx1, idx2);
 				equips[idx1].Swap(equips[idx2]);
+				std::swap(exposures[idx1], exposures[idx2]);
+				std::swap(ranks[idx1], ranks[idx2]);
+				std::swap(unseen[idx1], unseen[idx2]);
+				if (index_valid) {
+					index.insert_or_assign(handles[idx1].native_handle(), static_cast<u32>(idx1)); // Entries exist already so these can't fail
+					index.insert_or_assign(handles[idx2].native_handle(), static_cast<u32>(idx2));
+				}
 			}
 		}
 
 
-		bool Save(SKSE::SerializationInterface& intfc) const {
+		bool Save(SKSE::SerializationInterface& intfc, const ActorRecords::format fmt) const {
 			enum : RE::FormID { InvalidFormID = 0x0 };
 			const size_t cursize = handles.size();
 
@@ -284,30 +405,18 @@ namespace Data {
 				Log::Critical("Failed to initialize serialization bookkeeping! (out of memory?)"sv);
 				return false;
 			}
-			size_t valid_count = 0;
 			for (size_t i = 0; i < cursize; ++i) {
 				if (const RE::ActorPtr ptr = handles[i].get(); ptr and IsValidKeepable(ptr.get())) {
-					++valid_count;
 					formIDs.append(ptr->GetFormID());
 				} else {
 					formIDs.append(InvalidFormID);
 				}
 			}
 
-			if (!intfc.WriteRecordData(valid_count)) {
-				Log::Critical("Failed to serialize actor count!"sv);
+			if (!ActorRecords::Write(intfc, formIDs, fears, equips, cold, fmt)) {
 				return false;
 			}
 
-			for (size_t i = 0; i < cursize; ++i) {
-				if (const RE::FormID formID = formIDs[i]; formID != InvalidFormID) {
-					if (!intfc.WriteRecordData(formID) or !fears[i].Save(intfc) or !equips[i].Save(intfc)) {
-						Log::Critical("Failed to serialize data for formID <{:08X}>!"sv, formID);
-						return false;
-					}
-				}
-			}
-
 			if (!intfc.WriteRecordData(prules)) {
 				Log::Critical("Failed to serialize player rules data!"sv);
 				return false;
@@ -316,34 +425,25 @@ namespace Data {
 			Log::Info("Serialized actor data"sv);
 			return true;
 		}
-		bool Load(SKSE::SerializationInterface& intfc) {
+		// version is the Data::Shared record's. Older versions are migrated as they load.
+		// Rows only get their formIDs resolved here, since SKSE allows that only during load. They wait in cold until their actor is gathered or looked up.
+		bool Load(SKSE::SerializationInterface& intfc, const u32 version) {
 			clear();
 
-			size_t data_size;
-			if (!intfc.ReadRecordData(data_size)) {
-				Log::Critical("Failed to deserialize actor count!"sv);
-				return false;
-			}
-			lazy_vector<RE::FormID> formIDs{};
-			if (!handles.reserve(data_size) or !fears.reserve(data_size) or !equips.reserve(data_size)) {
-				Log::Critical("Not enough memory to deserialize data!"sv);
+			ActorRecords::columns saved{};
+			if (!ActorRecords::Read(intfc, version, saved) or !cold.assign(intfc, saved)) {
 				return false;
 			}
+			const size_t loaded = cold.count();
 
-			for (size_t i = 0; i < data_size; ++i) {
-				RE::FormID formID;
-				FearInfo ars;
-				EquipState eqs;
-				if (!intfc.ReadRecordData(formID) or !ars.Load(intfc) or !eqs.Load(intfc)) {
-					Log::Critical("Failed to deserialize actor data (potential unresolved formID <{:08X}>)!"sv, formID);
-					return false;
-				}
-				if (intfc.ResolveFormID(formID, formID)) { // Buffer always progressed, even if the formID is invalid in this load.
-					const RE::ActorHandle handle{ RE::TESForm::LookupByID<RE::Actor>(formID) }; // nullptr lookup just makes a 0 handle, which produces nullptr through .get(). No crashes, just check.
-					if (RE::ActorPtr ptr = handle.get(); ptr and IsValidAddable(ptr.get())) {
-						handles.append(handle);
-						fears.append(std::move(ars)); // Move unnecessary atm, since these are both trivially copyable, but in case it changes...
-						equips.append(std::move(eqs));
+			// Except the player's and blocked actors', which rules checks look up directly, as demote_unseen() keeps them hot too
+			if (RE::PlayerCharacter* player = Vanilla::Player(); player and has_cold(player) and reserve_all(1)) {
+				(void)append_new(Vanilla::PlayerHandle(), player);
+			}
+			for (size_t row = 0; row < cold.size(); ++row) { // Taking the last row clears cold, so check size() each time
+				if ((cold.formIDs[row] != 0) and cold.fear(row).is_blocked) {
+					if (RE::Actor* act = RE::TESForm::LookupByID<RE::Actor>(cold.formIDs[row]); act and reserve_all(1)) {
+						(void)append_new(trivial_handle{ act }, act);
 					}
 				}
 			}
@@ -353,27 +453,105 @@ namespace Data {
 				return false;
 			}
 
-			Log::Info("Deserialized data for {} actors. The remaining {}, serialized previously, are no longer valid."sv, handles.size(), (data_size - handles.size()));
+			Log::Info("Deserialized data for {} actors, {} kept cold until they show up. The remaining {}, serialized previously, did not resolve."sv, loaded, cold.count(), (saved.size() - loaded));
 			return true;
 		}
 
 	private:
+		// The index is reserved on its own, since its count can include stale entries of zeroed handles and its growth doesn't follow the columns'
 		constexpr bool reserve_all(const size_t extra_count) noexcept {
 			const size_t newcap = handles.size() + extra_count;
-			return (newcap <= handles.capacity()) or (handles.reserve(newcap) and fears.reserve(newcap) and equips.reserve(newcap));
+			return (!index_valid or index.reserve(index.size() + extra_count))
+				and ((newcap <= handles.capacity()) or (handles.reserve(newcap) and fears.reserve(newcap) and equips.reserve(newcap) and exposures.reserve(newcap) and ranks.reserve(newcap) and unseen.reserve(newcap)));
 		}
 		constexpr bool resize_all(const size_t newsize) noexcept {
-			return (newsize == size()) or (handles.resize(newsize) and fears.resize(newsize) and equips.resize(newsize));
+			return (newsize == size()) or (((newsize < size()) or !index_valid or index.reserve(index.size() + (newsize - size())))
+				and handles.resize(newsize) and fears.resize(newsize) and equips.resize(newsize) and exposures.resize(newsize) and ranks.resize(newsize) and unseen.resize(newsize));
+		}
+		// For inserts reserve_all() or resize_all() made room for, so failing means the reservation was wrong
+		void index_reserved(const trivial_handle hnd, const size_t row) noexcept {
+			if (index_valid and !index.insert_or_assign(hnd.native_handle(), static_cast<u32>(row))) [[unlikely]] {
+				Log::Critical("Handle index insert failed despite room reserved for it!"sv);
+			}
+		}
+		constexpr void clear_rows() noexcept {
+			index.clear();
+			index_valid = true; // Empty, so in sync
+			handles.clear();
+			fears.clear();
+			equips.clear();
+			exposures.clear();
+			ranks.clear();
+			unseen.clear();
+		}
+		// Fills row idx from act's cold row, if there is one
+		bool take_cold(const size_t idx, const RE::Actor* act) noexcept {
+			const size_t row = cold.find(act->GetFormID());
+			if (row == cold.size()) {
+				return false;
+			}
+			fears.set_row(idx, cold.fear(row));
+			equips[idx] = cold.equips(row);
+			exposures[idx] = equips[idx].GetExposure();
+			ranks[idx] = UpdateTypes::UnknownRanks; // Whatever was given last is likely still there, but writing them once more is cheap
+			cold.take(row);
+			return true;
+		}
+		// Needs reserve_all(1) first. False, adding nothing, if the index insert still failed.
+		[[nodiscard]] bool append_new(const trivial_handle handle, RE::Actor* act) noexcept {
+			if (index_valid and !index.insert_or_assign(handle.native_handle(), static_cast<u32>(size()))) [[unlikely]] {
+				Log::Critical("Handle index insert failed despite room reserved for it!"sv);
+				return false;
+			}
+			handles.append(handle);
+			if (const size_t row = cold.find(act->GetFormID()); row < cold.size()) {
+				fears.append(cold.fear(row));
+				equips.append(cold.equips(row));
+				cold.take(row);
+			} else {
+				fears.append(FearInfo{ act, true });
+				equips.append(act);
+			}
+			exposures.append(equips.back().GetExposure());
+			ranks.append(UpdateTypes::UnknownRanks);
+			unseen.append(u8{ 0 });
+			return true;
+		}
+		constexpr bool rebuild_index() noexcept {
+			index.clear();
+			if (!index.reserve(handles.size())) {
+				return false;
+			}
+			for (u32 i = 0, end = static_cast<u32>(handles.size()); i < end; ++i) {
+				index.insert_or_assign(handles[i].native_handle(), i);
+			}
+			return true;
+		}
+		// On failure the index is left empty, so lookups scan handles and inserts skip it until a later long update rebuilds it
+		void reindex() noexcept {
+			const bool was_valid = std::exchange(index_valid, rebuild_index());
+			if (was_valid and !index_valid) [[unlikely]] {
+				Log::Critical("Handle index rebuild of {} rows failed! Scanning for rows until it can be rebuilt."sv, handles.size());
+			} else if (!was_valid and index_valid) {
+				Log::Info("Handle index rebuilt after an earlier failure"sv);
+			}
 		}
 
 		lazy_vector<trivial_handle> handles{};
-		lazy_vector<FearInfo> fears{};
+		fear_columns fears{};
 		lazy_vector<EquipState> equips{};
+		lazy_vector<float> exposures{};	// equips[i].GetExposure(), refreshed whenever body armor can change
+		lazy_vector<UpdateTypes::applied_ranks> ranks{};	// Faction ranks last sent to the main thread, so updates only send changes
 		rules_info prules{};
-
-		static __forceinline bool add_rulesnpc_spells(RE::Actor* act) noexcept { return GameDataUtils::AddSpell(act, ::PlayerRules::Spell(::PlayerRules::SPL::PlayerRules), false); };
-		static __forceinline void remove_rules_npc_spells(RE::Actor* act) noexcept { act->RemoveSpell(::PlayerRules::Spell(::PlayerRules::SPL::PlayerRules)); };
-		static __forceinline bool add_rulesplayer_spells(RE::Actor* act) noexcept {
+		HandleIndex::handle_index index{}; // native handle -> row, kept in sync with handles
+		bool index_valid{ true };	// False after a failed rebuild, while find_index() scans handles instead
+		lazy_vector<u8> unseen{};	// Long updates since the actor was last gathered, saturating
+		ActorRecords::cold_rows cold{};	// Rows of actors loaded but not gathered since, or demoted by demote_unseen()
+		array<bool, MaxUpdateCount> restored{};	// Per update input, whether swap_allocate_move() took its row from cold, so init_news() skips it
+
+		static FORCEINLINE bool add_rulesnpc_spells(RE::Actor* act) noexcept { return GameDataUtils::AddSpell(act, ::PlayerRules::Spell(::PlayerRules::SPL::PlayerRules), false); };
+		static FORCEINLINE void remove_rules_npc_spells(RE::Actor* act) noexcept { act->RemoveSpell(::PlayerRules::Spell(::PlayerRules::SPL::PlayerRules)); };
+		static FORCEINLINE bool add_rulesplayer_spells(RE::Actor* act) noexcept {
 			if (add_rulesnpc_spells(act)) {
 				if (!GameDataUtils::AddSpell(act, ::PlayerRules::Spell(::PlayerRules::SPL::CrestLink), true)) {
 					remove_rules_npc_spells(act);
@@ -382,7 +560,7 @@ namespace Data {
 			}
 			return true;
 		};
-		static __forceinline void remove_rules_player_spells(RE::Actor* act) noexcept {
+		static FORCEINLINE void remove_rules_player_spells(RE::Actor* act) noexcept {
 			remove_rules_npc_spells(act);
 			act->RemoveSpell(::PlayerRules::Spell(::PlayerRules::SPL::PlayerRules));
 		};
@@ -7,10 +7,7 @@
 #include "Utils/RNG.h"			// Randomize rule selections
 #include "Utils/StringUtils.h"
 
-#include <immintrin.h>
-#pragma intrinsic(_pdep_u32)
-#pragma intrinsic(_tzcnt_u32)
-#pragma intrinsic(_BitScanForward)
+#include <immintrin.h> // _pdep_u32 (BMI2)
 
 namespace Data {
 
@@ -41,26 +38,26 @@ namespace Data {
 				NotObeying = static_cast<u8>(~Obeying),
 			};
 
-			__forceinline constexpr u8 raw() const noexcept { return f; }
+			FORCEINLINE constexpr u8 raw() const noexcept { return f; }
 
-			__forceinline constexpr bool periodic_active() const noexcept { return f & Periodic; }		// Bit 0
-			__forceinline constexpr bool periodic_inactive() const noexcept { return f & NotPeriodic; }	// Bit 0
-			__forceinline constexpr bool obeying() const noexcept { return f & Obeying; }				// Bit 1	slowest access
-			__forceinline constexpr bool periodic_inactive_or_obeyed() const noexcept {
+			FORCEINLINE constexpr bool periodic_active() const noexcept { return f & Periodic; }		// Bit 0
+			FORCEINLINE constexpr bool periodic_inactive() const noexcept { return f & NotPeriodic; }	// Bit 0
+			FORCEINLINE constexpr bool obeying() const noexcept { return f & Obeying; }				// Bit 1	slowest access
+			FORCEINLINE constexpr bool periodic_inactive_or_obeyed() const noexcept {
 				return (f & Obeying) | (not static_cast<bool>(f & Periodic)); // Return true if obeying or periodic not active
 			}
 
-			__forceinline constexpr void set_periodic() noexcept { f |= Periodic; }						// Set bit 0
-			__forceinline constexpr void set_obeying() noexcept { f |= Obeying; }						// Set bit 1
-			__forceinline constexpr void set_obeying(const bool val) noexcept {					// Set bit 1 to val
+			FORCEINLINE constexpr void set_periodic() noexcept { f |= Periodic; }						// Set bit 0
+			FORCEINLINE constexpr void set_obeying() noexcept { f |= Obeying; }						// Set bit 1
+			FORCEINLINE constexpr void set_obeying(const bool val) noexcept {					// Set bit 1 to val
 				f &= NotObeying;
 				f |= static_cast<u8>(val << 1);
 			}
 
-			__forceinline constexpr void unset_periodic() noexcept { f &= NotPeriodic; }				// Unset bit 0
-			__forceinline constexpr void unset_obeying() noexcept { f &= NotObeying; }					// Unset bit 1
+			FORCEINLINE constexpr void unset_periodic() noexcept { f &= NotPeriodic; }				// Unset bit 0
+			FORCEINLINE constexpr void unset_obeying() noexcept { f &= NotObeying; }					// Unset bit 1
 
-			__forceinline constexpr void andeq_obeying(const bool val) noexcept {
+			FORCEINLINE constexpr void andeq_obeying(const bool val) noexcept {
 				f &= static_cast<u8>(NotObeying + val + val); // Same code as * or <<
 				// false:	f &= 1111'1101, clearing bit 1
 				// true:		f &= 1111'1111, leaving f unchanged
@@ -78,13 +75,13 @@ namespace Data {
 				NotFlat = static_cast<u8>(~Flat),
 				AnyActive = static_cast<u8>(Flat | Periodic),
 			};
-			__forceinline constexpr bool flat_active() const noexcept { return f & Flat; }		// Bit 2
-			__forceinline constexpr bool flat_inactive() const noexcept { return f & NotFlat; }	// Not bit 2
-			__forceinline constexpr void set_flat() noexcept { f |= Flat; }						// Set bit 2
-			__forceinline constexpr void unset_flat() noexcept { f &= NotFlat; }				// Unset bit 2
+			FORCEINLINE constexpr bool flat_active() const noexcept { return f & Flat; }		// Bit 2
+			FORCEINLINE constexpr bool flat_inactive() const noexcept { return f & NotFlat; }	// Not bit 2
+			FORCEINLINE constexpr void set_flat() noexcept { f |= Flat; }						// Set bit 2
+			FORCEINLINE constexpr void unset_flat() noexcept { f &= NotFlat; }				// Unset bit 2
 
-			__forceinline constexpr u8 actives() const noexcept { return f & AnyActive; }
-			__forceinline constexpr bool any_inactive() const noexcept { return (f & AnyActive) != AnyActive; }
+			FORCEINLINE constexpr u8 actives() const noexcept { return f & AnyActive; }
+			FORCEINLINE constexpr bool any_inactive() const noexcept { return (f & AnyActive) != AnyActive; }
 
 			// u8 f{};
 			// 0000 0fop
@@ -101,17 +98,17 @@ namespace Data {
 				FullyActiveValue = static_cast<u8>(static_cast<u8>(Periodic) | static_cast<u8>(Flat) | static_cast<u8>(MaxTier))
 			};
 
-			__forceinline constexpr u8 tier() const noexcept { return f >> 3; }
-			__forceinline constexpr void set_tier(const u8 val) noexcept {
+			FORCEINLINE constexpr u8 tier() const noexcept { return f >> 3; }
+			FORCEINLINE constexpr void set_tier(const u8 val) noexcept {
 				f &= NotTier;						// Unset
 				f |= static_cast<u8>(val << 3);	// Set new
 			}
-			__forceinline constexpr bool can_upgrade() const noexcept {
+			FORCEINLINE constexpr bool can_upgrade() const noexcept {
 				const u8 cur = f & Tier;
 				return (cur != 0) bitand (cur < MaxTier);
 			}
 			// Returns true if the tier after upgrading isn't maxed and can be upgraded again. Returns false otherwise.
-			__forceinline constexpr bool upgrade() noexcept {
+			FORCEINLINE constexpr bool upgrade() noexcept {
 				const u8 newtier = static_cast<u8>(f & Tier) << 1; // Calc new
 				f &= NotTier;	// Unset
 				f |= newtier;	// Set new
@@ -131,19 +128,19 @@ namespace Data {
 				ActiveMask = static_cast<u32>(1 << T::Total) - 1,
 				ObeyingMask = static_cast<u32>(ActiveMask << 16),
 			};
-			__forceinline constexpr u32 raw() const noexcept { return f; }
-			__forceinline constexpr u16 actives() const noexcept { return f & ActiveMask; }
-			__forceinline constexpr u16 inactives() const noexcept { return static_cast<u32>(~f) & ActiveMask; }
-			__forceinline constexpr u16 obeyeds() const noexcept { return f >> 16; }
+			FORCEINLINE constexpr u32 raw() const noexcept { return f; }
+			FORCEINLINE constexpr u16 actives() const noexcept { return f & ActiveMask; }
+			FORCEINLINE constexpr u16 inactives() const noexcept { return static_cast<u32>(~f) & ActiveMask; }
+			FORCEINLINE constexpr u16 obeyeds() const noexcept { return f >> 16; }
 
-			__forceinline constexpr u8 active_count() const noexcept { return static_cast<u8>(std::popcount(actives())); }
-			__forceinline constexpr u8 inactive_count() const noexcept { return static_cast<u8>(std::popcount(inactives())); }
+			FORCEINLINE constexpr u8 active_count() const noexcept { return static_cast<u8>(std::popcount(actives())); }
+			FORCEINLINE constexpr u8 inactive_count() const noexcept { return static_cast<u8>(std::popcount(inactives())); }
 
-			__forceinline constexpr bool allowed() const noexcept { return actives() == obeyeds(); }
-			__forceinline constexpr bool any_inactive() const noexcept { return actives() != ActiveMask; }
+			FORCEINLINE constexpr bool allowed() const noexcept { return actives() == obeyeds(); }
+			FORCEINLINE constexpr bool any_inactive() const noexcept { return actives() != ActiveMask; }
 
-			__forceinline constexpr bool id_active(const T id) const noexcept { return f & static_cast<u32>(1 << id); }
-			__forceinline constexpr bool id_obeyed(const T id) const noexcept { return f & static_cast<u32>(1 << (id + 16)); }
+			FORCEINLINE constexpr bool id_active(const T id) const noexcept { return f & static_cast<u32>(1 << id); }
+			FORCEINLINE constexpr bool id_obeyed(const T id) const noexcept { return f & static_cast<u32>(1 << (id + 16)); }
 
 			constexpr bool activate_random_check_full(RNG::gamerand& gen) noexcept {
 				const u32 availables = inactive_count();
@@ -155,15 +152,15 @@ namespace Data {
 				f |= _pdep_u32(1ul << pick, inactives()); // 1ul invokes the 32bit version of shl, which masks n to 5 bits.
 				return availables > 1;
 			}
-			__forceinline constexpr void set_id(const T id) noexcept { f |= static_cast<u32>(1 << id); }
-			__forceinline constexpr void set_obeyed(const T id) noexcept { f |= static_cast<u32>(id_active(id) << (id + 16)); }
-			__forceinline constexpr void set_obeyed(const T id, const bool val) noexcept {
+			FORCEINLINE constexpr void set_id(const T id) noexcept { f |= static_cast<u32>(1 << id); }
+			FORCEINLINE constexpr void set_obeyed(const T id) noexcept { f |= static_cast<u32>(id_active(id) << (id + 16)); }
+			FORCEINLINE constexpr void set_obeyed(const T id, const bool val) noexcept {
 				const u32 sanitized = (val & id_active(id)) << (id + 16);
 				f |= sanitized;
 			}
 
-			__forceinline constexpr void unset_id(const T id) noexcept { f &= ~static_cast<u32>(1 << id); unset_obeyed(id); }
-			__forceinline constexpr void unset_obeyed(const T id) noexcept { f &= ~static_cast<u32>(1 << (id + 16)); }
+			FORCEINLINE constexpr void unset_id(const T id) noexcept { f &= ~static_cast<u32>(1 << id); unset_obeyed(id); }
+			FORCEINLINE constexpr void unset_obeyed(const T id) noexcept { f &= ~static_cast<u32>(1 << (id + 16)); }
 
 			u32 f{};
 		};
@@ -219,7 +216,7 @@ namespace Data {
 				case NoSplF: { data[NoSpells].set_flat(); break; }
 				case NoSolesP: { data[NoSolesOnly].set_periodic(); data[NoSolesOnly].set_obeying(flagpack.soleless_or_barefoot()); break; }
 				case NoSolesF: { data[NoSolesOnly].set_flat(); break; }
-				default: { __assume(0); }
+				default: { std::unreachable(); }
 				}
 				return count > 1; // Being here means at least 1 action was available
 			}
@@ -364,7 +361,7 @@ namespace Data {
 					data[ClothingRestricted].set_obeying(flagpack.clothing().not_worn() bitor (data[ClothingRestricted].tier() <= flagpack.clothing().tiers()));
 					break;
 				}
-				default: { __assume(0); }
+				default: { std::unreachable(); }
 				}
 				return ret; // Being here at means least 1 action was available
 			}
@@ -438,14 +435,15 @@ namespace Data {
 				Total
 			};
 
-			__forceinline constexpr bool any_inactive() const noexcept { return data.any_inactive(); }
-			__forceinline constexpr bool allowed() const noexcept { return data.allowed(); }
+			FORCEINLINE constexpr bool any_inactive() const noexcept { return data.any_inactive(); }
+			FORCEINLINE constexpr bool allowed() const noexcept { return data.allowed(); }
 
 			constexpr bool activate_random_check_full(RNG::gamerand& gen, const AnalyzedBasicSlots flagpack, const EquipState::HRCounts& hr) noexcept {
 				const u16 olds = data.actives();
 				const bool ret = data.activate_random_check_full(gen);
-				unsigned long idx;
-				const u8 scanmask = bool_extend(_BitScanForward(&idx, static_cast<u32>(olds ^ data.actives()))); // Up to 1 bit was set so XORing will isolate it.
+				const u32 activated = static_cast<u32>(olds ^ data.actives()); // Up to 1 bit was set so XORing will isolate it.
+				const u32 idx = static_cast<u32>(std::countr_zero(activated));
+				const u8 scanmask = bool_extend(activated != 0);
 				const ID newid = static_cast<ID>((static_cast<u8>(idx) & (scanmask)) | (static_cast<u8>(Total) & static_cast<u8>(~scanmask))); // If scanmask != 0, some rule was activated.
 				switch (newid) {
 				case WearHR_1:
@@ -460,7 +458,7 @@ namespace Data {
 				case WearHR_10_13:	{ data.set_obeyed(newid, hr.has_any_10_13()); break; }
 				case WearNoSoles:	{ data.set_obeyed(WearNoSoles, flagpack.no_soles_worn()); break; }
 				case Total:			{ break; } // Nothing added
-				default:			{ __assume(0); }
+				default:			{ std::unreachable(); }
 				}
 				return ret;
 			}
@@ -593,7 +591,7 @@ namespace Data {
 					data[ClothingRestricted].set_obeying(flagpack.clothing().not_worn() bitor (data[ClothingRestricted].tier() <= flagpack.clothing().tiers()));
 					break;
 				}
-				default: { __assume(0); }
+				default: { std::unreachable(); }
 				}
 				return ret; // Being here at means least 1 action was available
 			}
@@ -626,16 +624,16 @@ namespace Data {
 				Dodge,	// Papyrus
 			};
 
-			__forceinline constexpr bool active() const noexcept { return target; }
-			__forceinline constexpr bool allowed() const noexcept { return remaining == 0; }
+			FORCEINLINE constexpr bool active() const noexcept { return target; }
+			FORCEINLINE constexpr bool allowed() const noexcept { return remaining == 0; }
 
 			constexpr bool activate_check_full() noexcept {
 				target += u8{ 2 } & bool_extend(target < 200);
 				return target < 200;
 			}
 
-			__forceinline constexpr void dodged() noexcept { --remaining; }
-			__forceinline constexpr void update(const bool day_passed) noexcept { remaining += (target - remaining) * day_passed; }
+			FORCEINLINE constexpr void dodged() noexcept { --remaining; }
+			FORCEINLINE constexpr void update(const bool day_passed) noexcept { remaining += (target - remaining) * day_passed; }
 
 			u8 target{};		// Active if != 0
 			satu8 remaining{};
@@ -662,18 +660,18 @@ namespace Data {
 				Total
 			};
 
-			__forceinline constexpr bool any_inactive() const noexcept { return data.any_inactive(); }
-			__forceinline constexpr bool allowed() const noexcept { return data.allowed(); }
+			FORCEINLINE constexpr bool any_inactive() const noexcept { return data.any_inactive(); }
+			FORCEINLINE constexpr bool allowed() const noexcept { return data.allowed(); }
 
 			constexpr bool activate_random_check_full(RNG::gamerand& gen) noexcept { return data.activate_random_check_full(gen); }
 
-			__forceinline constexpr void brawled(const ID id) noexcept { data.set_obeyed(id); }
-			__forceinline constexpr void unfairbrawl() noexcept { data.set_obeyed(DoUnfairBrawl); }
-			__forceinline constexpr void rawbrawl() noexcept { data.set_obeyed(DoRawBrawl); }
-			__forceinline constexpr void angrybrawl() noexcept { data.set_obeyed(DoAngryBrawl); }
-			__forceinline constexpr void merrybrawl() noexcept { data.set_obeyed(DoMerryBrawl); }
+			FORCEINLINE constexpr void brawled(const ID id) noexcept { data.set_obeyed(id); }
+			FORCEINLINE constexpr void unfairbrawl() noexcept { data.set_obeyed(DoUnfairBrawl); }
+			FORCEINLINE constexpr void rawbrawl() noexcept { data.set_obeyed(DoRawBrawl); }
+			FORCEINLINE constexpr void angrybrawl() noexcept { data.set_obeyed(DoAngryBrawl); }
+			FORCEINLINE constexpr void merrybrawl() noexcept { data.set_obeyed(DoMerryBrawl); }
 
-			__forceinline constexpr void update(const bool day_passed) noexcept { data.f &= (bool_extend(not day_passed) << 16); }
+			FORCEINLINE constexpr void update(const bool day_passed) noexcept { data.f &= (bool_extend(not day_passed) << 16); }
 
 			packed_aopairs<ID> data;
 		};
@@ -687,8 +685,8 @@ namespace Data {
 				Total
 			};
 
-			__forceinline constexpr bool any_inactive() const noexcept { return data.periodic_inactive() | data.flat_inactive(); }
-			__forceinline constexpr bool allowed() const noexcept { return data.periodic_inactive() bitor data.obeying(); }
+			FORCEINLINE constexpr bool any_inactive() const noexcept { return data.periodic_inactive() | data.flat_inactive(); }
+			FORCEINLINE constexpr bool allowed() const noexcept { return data.periodic_inactive() bitor data.obeying(); }
 
 			constexpr bool activate_random_check_full(RNG::gamerand& gen, const bool follower) noexcept {
 				static_assert(Total == 2, "MiscPunishers::activate_random_check_full() needs updating because number of rules has changed");
@@ -715,16 +713,16 @@ namespace Data {
 				case NoFastA: { data.set_flat(); data.set_tier(1); break; }
 				case NoFastU: { const u8 oldtier = data.tier(); ret |= (oldtier < 9); data.set_tier(oldtier + 1); break; }
 				case HaveFlA: { data.set_periodic(); data.set_obeying(follower); break; }
-				default: { __assume(0); }
+				default: { std::unreachable(); }
 				}
 				return ret; // Being here means at least 1 action was available
 			}
 
-			__forceinline constexpr bool nofasttravel_active() const noexcept { return data.flat_active(); }
-			__forceinline constexpr i32 nofasttravel_penalty() const noexcept { return static_cast<i32>(data.tier() & bool_extend(nofasttravel_active())); }
+			FORCEINLINE constexpr bool nofasttravel_active() const noexcept { return data.flat_active(); }
+			FORCEINLINE constexpr i32 nofasttravel_penalty() const noexcept { return static_cast<i32>(data.tier() & bool_extend(nofasttravel_active())); }
 
-			__forceinline constexpr void set_havefollower_inactive() noexcept { data.unset_periodic(); }
-			__forceinline constexpr void set_havefollower_obeying(const bool val) noexcept { data.set_obeying(val); }
+			FORCEINLINE constexpr void set_havefollower_inactive() noexcept { data.unset_periodic(); }
+			FORCEINLINE constexpr void set_havefollower_obeying(const bool val) noexcept { data.set_obeying(val); }
 
 		private:
 			packed_poftier data{};	// Periodic = HaveFollower, Obeying = HaveFollower obeying, Flat = NoFastTravel, Tier = NoFastTravel penalty
@@ -750,21 +748,21 @@ namespace Data {
 				DifficultyMaskedMax = 100 << 1,
 			};
 
-			__forceinline constexpr bool active() const noexcept { return fd & DifficultyMask; }
-			__forceinline constexpr bool remove_on_completion() const noexcept { return (fd & DifficultyMask) > DifficultyMaskedMax; }
-			__forceinline constexpr u8 difficulty() const noexcept { return fd >> 1; }
-			__forceinline constexpr u16 remaining() const noexcept { return static_cast<u16>((fd & 1) << 8) | static_cast<u16>(fr); }
-			__forceinline constexpr u16 goal() const noexcept { return static_cast<u16>(fd >> 1) * GoalMultiplier; }
-			__forceinline constexpr u16 progress() const noexcept { return goal() - remaining(); }
+			FORCEINLINE constexpr bool active() const noexcept { return fd & DifficultyMask; }
+			FORCEINLINE constexpr bool remove_on_completion() const noexcept { return (fd & DifficultyMask) > DifficultyMaskedMax; }
+			FORCEINLINE constexpr u8 difficulty() const noexcept { return fd >> 1; }
+			FORCEINLINE constexpr u16 remaining() const noexcept { return static_cast<u16>((fd & 1) << 8) | static_cast<u16>(fr); }
+			FORCEINLINE constexpr u16 goal() const noexcept { return static_cast<u16>(fd >> 1) * GoalMultiplier; }
+			FORCEINLINE constexpr u16 progress() const noexcept { return goal() - remaining(); }
 
-			__forceinline constexpr void set_remove_on_completion(const bool val) noexcept {
+			FORCEINLINE constexpr void set_remove_on_completion(const bool val) noexcept {
 				fd |= static_cast<u8>(DifficultyMask & bool_extend(val));
 			}
-			__forceinline constexpr void set_difficulty(const sat1100u8 val) noexcept {
+			FORCEINLINE constexpr void set_difficulty(const sat1100u8 val) noexcept {
 				fd &= static_cast<u8>(~DifficultyMask);
 				fd |= static_cast<u8>(static_cast<u8>(val.get()) << 1);
 			}
-			__forceinline constexpr void set_remaining(const sat0500u16 val) noexcept {
+			FORCEINLINE constexpr void set_remaining(const sat0500u16 val) noexcept {
 				fd &= DifficultyMask;
 				fd |= static_cast<u8>((val.get() >> 8) & 1);
 				fr = static_cast<u8>(val.get() & 0b1111'1111);
@@ -808,7 +806,7 @@ namespace Data {
 				}
 				return false;
 			}
-			__forceinline constexpr bool set_inactive() noexcept {
+			FORCEINLINE constexpr bool set_inactive() noexcept {
 				const bool old = active();
 				fd &= 1;
 				return old;
@@ -837,22 +835,22 @@ namespace Data {
 				RoCMask = 0b1000'0000,
 			};
 
-			__forceinline constexpr bool active() const noexcept { return fd & DifficultyMask; }
-			__forceinline constexpr bool remove_on_completion() const noexcept { return fd >> 7; } // Better code than fd & RoCMask
-			__forceinline constexpr u8 difficulty() const noexcept { return fd & DifficultyMask; }
-			__forceinline constexpr u8 goal() const noexcept { return (fd & DifficultyMask) * GoalMultiplier; }
-			__forceinline constexpr u8 remaining() const noexcept { return fr; }
-			__forceinline constexpr u8 progress() const noexcept { return goal() - remaining(); }
+			FORCEINLINE constexpr bool active() const noexcept { return fd & DifficultyMask; }
+			FORCEINLINE constexpr bool remove_on_completion() const noexcept { return fd >> 7; } // Better code than fd & RoCMask
+			FORCEINLINE constexpr u8 difficulty() const noexcept { return fd & DifficultyMask; }
+			FORCEINLINE constexpr u8 goal() const noexcept { return (fd & DifficultyMask) * GoalMultiplier; }
+			FORCEINLINE constexpr u8 remaining() const noexcept { return fr; }
+			FORCEINLINE constexpr u8 progress() const noexcept { return goal() - remaining(); }
 
-			__forceinline constexpr void set_remove_on_completion(const bool val) noexcept {
+			FORCEINLINE constexpr void set_remove_on_completion(const bool val) noexcept {
 				fd &= DifficultyMask;
 				fd |= static_cast<u8>(static_cast<u8>(val) << 7);
 			}
-			__forceinline constexpr void set_difficulty(const sat1100u8 val) noexcept {
+			FORCEINLINE constexpr void set_difficulty(const sat1100u8 val) noexcept {
 				fd &= RoCMask;
 				fd |= val.get(); // No masking needed. Invariantly capped to 100 so MSB is never set.
 			}
-			__forceinline constexpr void set_remaining(const sat0200u8 val) noexcept {
+			FORCEINLINE constexpr void set_remaining(const sat0200u8 val) noexcept {
 				fr = val.get();
 			}
 
@@ -889,7 +887,7 @@ namespace Data {
 				}
 				return false;
 			}
-			__forceinline constexpr bool set_inactive() noexcept {
+			FORCEINLINE constexpr bool set_inactive() noexcept {
 				const bool old = active();
 				fd &= RoCMask; // Not sure if RoC value needs to be preserved but w/e
 				return old;
@@ -919,21 +917,21 @@ namespace Data {
 				RemainingMask = GoalMask,
 			};
 
-			__forceinline constexpr bool active() const noexcept { return fd & ActiveMask; }
-			__forceinline constexpr bool remove_on_completion() const noexcept { return fr & RoCMask; }
-			__forceinline constexpr u8 goal() const noexcept { return fd & GoalMask; }
-			__forceinline constexpr u8 remaining() const noexcept { return fr & RemainingMask; }
-			__forceinline constexpr u8 progress() const noexcept { return goal() - remaining(); }
+			FORCEINLINE constexpr bool active() const noexcept { return fd & ActiveMask; }
+			FORCEINLINE constexpr bool remove_on_completion() const noexcept { return fr & RoCMask; }
+			FORCEINLINE constexpr u8 goal() const noexcept { return fd & GoalMask; }
+			FORCEINLINE constexpr u8 remaining() const noexcept { return fr & RemainingMask; }
+			FORCEINLINE constexpr u8 progress() const noexcept { return goal() - remaining(); }
 
-			__forceinline constexpr void set_remove_on_completion(const bool val) noexcept {
+			FORCEINLINE constexpr void set_remove_on_completion(const bool val) noexcept {
 				fr &= RemainingMask;
 				fr |= static_cast<u8>(static_cast<u8>(val) << 7);
 			}
-			__forceinline constexpr void set_goal(const sat1100u8 val) noexcept {
+			FORCEINLINE constexpr void set_goal(const sat1100u8 val) noexcept {
 				fd &= ActiveMask;
 				fd |= val.get();
 			}
-			__forceinline constexpr void set_remaining(const sat0100u8 val) noexcept {
+			FORCEINLINE constexpr void set_remaining(const sat0100u8 val) noexcept {
 				fr &= RoCMask;
 				fr |= val.get();
 			}
@@ -974,7 +972,7 @@ namespace Data {
 				}
 				return false;
 			}
-			__forceinline constexpr bool set_inactive() noexcept {
+			FORCEINLINE constexpr bool set_inactive() noexcept {
 				const bool old = active();
 				fd &= GoalMask;
 				return old;
@@ -1001,20 +999,20 @@ namespace Data {
 				RemainingMask = 0b0000'1111,
 			};
 
-			__forceinline constexpr bool active() const noexcept { return f & GoalMask; }
-			__forceinline constexpr bool remove_on_completion() const noexcept { return (f & GoalMask) == GoalMask; }
-			__forceinline constexpr u8 goal() const noexcept { return f >> 4; }
-			__forceinline constexpr u8 remaining() const noexcept { return f & RemainingMask; }
-			__forceinline constexpr u8 progress() const noexcept { return goal() - remaining(); }
+			FORCEINLINE constexpr bool active() const noexcept { return f & GoalMask; }
+			FORCEINLINE constexpr bool remove_on_completion() const noexcept { return (f & GoalMask) == GoalMask; }
+			FORCEINLINE constexpr u8 goal() const noexcept { return f >> 4; }
+			FORCEINLINE constexpr u8 remaining() const noexcept { return f & RemainingMask; }
+			FORCEINLINE constexpr u8 progress() const noexcept { return goal() - remaining(); }
 
-			__forceinline constexpr void set_remove_on_completion(const bool val) noexcept {
+			FORCEINLINE constexpr void set_remove_on_completion(const bool val) noexcept {
 				f |= static_cast<u8>(GoalMask & bool_extend(val));
 			}
-			__forceinline constexpr void set_goal(const sat114u8 val) noexcept {
+			FORCEINLINE constexpr void set_goal(const sat114u8 val) noexcept {
 				f &= RemainingMask;
 				f |= static_cast<u8>(val.get() << 4);
 			}
-			__forceinline constexpr void set_remaining(const sat014u8 val) noexcept {
+			FORCEINLINE constexpr void set_remaining(const sat014u8 val) noexcept {
 				f &= GoalMask;
 				f |= static_cast<u8>(val.get() & RemainingMask);
 			}
@@ -1054,7 +1052,7 @@ namespace Data {
 				}
 				return false;
 			}
-			__forceinline constexpr bool set_inactive() noexcept {
+			FORCEINLINE constexpr bool set_inactive() noexcept {
 				const bool old = active();
 				f &= RemainingMask; // Not sure if remaining value needs to be preserved but w/e
 				return old;
@@ -1087,21 +1085,21 @@ namespace Data {
 				RemainingMask = LowNumMask,
 			};
 
-			__forceinline constexpr bool active() const noexcept { return f & ActiveMask; }
-			__forceinline constexpr bool remove_on_completion() const noexcept { return f & RoCMask; }
-			__forceinline constexpr u8 goal() const noexcept { return static_cast<u8>(f >> 3) & LowNumMask; }
-			__forceinline constexpr u8 remaining() const noexcept { return f & LowNumMask; }
-			__forceinline constexpr u8 progress() const noexcept { return goal() - remaining(); }
+			FORCEINLINE constexpr bool active() const noexcept { return f & ActiveMask; }
+			FORCEINLINE constexpr bool remove_on_completion() const noexcept { return f & RoCMask; }
+			FORCEINLINE constexpr u8 goal() const noexcept { return static_cast<u8>(f >> 3) & LowNumMask; }
+			FORCEINLINE constexpr u8 remaining() const noexcept { return f & LowNumMask; }
+			FORCEINLINE constexpr u8 progress() const noexcept { return goal() - remaining(); }
 
-			__forceinline constexpr void set_remove_on_completion(const bool val) noexcept {
+			FORCEINLINE constexpr void set_remove_on_completion(const bool val) noexcept {
 				f &= static_cast<u8>(~RoCMask);
 				f |= static_cast<u8>(val << 6);
 			}
-			__forceinline constexpr void set_goal(const sat17u8 val) noexcept {
+			FORCEINLINE constexpr void set_goal(const sat17u8 val) noexcept {
 				f &= static_cast<u8>(~GoalMask);
 				f |= static_cast<u8>(val.get() << 3);
 			}
-			__forceinline constexpr void set_remaining(const sat07u8 val) noexcept {
+			FORCEINLINE constexpr void set_remaining(const sat07u8 val) noexcept {
 				f &= static_cast<u8>(~RemainingMask);
 				f |= val.get();
 			}
@@ -1142,7 +1140,7 @@ namespace Data {
 				}
 				return false;
 			}
-			__forceinline constexpr bool set_inactive() noexcept {
+			FORCEINLINE constexpr bool set_inactive() noexcept {
 				const bool old = active();
 				f &= static_cast<u8>(~ActiveMask);
 				return old;
@@ -1200,11 +1198,11 @@ namespace Data {
 			constexpr GranterID(const GranterTimed::ID val) noexcept	: id{ (val == GranterTimed::Total)	? GranterID::Total : (static_cast<u32>(val) + Totals::TimedOffset) } {}
 			constexpr GranterID(const u32 val) noexcept				: id{ val } {}
 
-			__forceinline constexpr bool IsBig() const noexcept		{ return id < Totals::Big; }
-			__forceinline constexpr bool IsMed() const noexcept		{ return (id >= Totals::MedOffset)		bitand (id < (Totals::MedOffset + Totals::Med)); }
-			__forceinline constexpr bool IsSmall() const noexcept	{ return (id >= Totals::SmallOffset)	bitand (id < (Totals::SmallOffset + Totals::Small)); }
-			__forceinline constexpr bool IsTiny() const noexcept	{ return (id >= Totals::TinyOffset)		bitand (id < (Totals::TinyOffset + Totals::Tiny)); }
-			__forceinline constexpr bool IsTimed() const noexcept	{ return (id >= Totals::TimedOffset)	bitand (id != GranterID::Total); }
+			FORCEINLINE constexpr bool IsBig() const noexcept		{ return id < Totals::Big; }
+			FORCEINLINE constexpr bool IsMed() const noexcept		{ return (id >= Totals::MedOffset)		bitand (id < (Totals::MedOffset + Totals::Med)); }
+			FORCEINLINE constexpr bool IsSmall() const noexcept	{ return (id >= Totals::SmallOffset)	bitand (id < (Totals::SmallOffset + Totals::Small)); }
+			FORCEINLINE constexpr bool IsTiny() const noexcept	{ return (id >= Totals::TinyOffset)		bitand (id < (Totals::TinyOffset + Totals::Tiny)); }
+			FORCEINLINE constexpr bool IsTimed() const noexcept	{ return (id >= Totals::TimedOffset)	bitand (id != GranterID::Total); }
 
 			constexpr size_t ToIndex() const noexcept {
 				if (IsBig()) { return Raw(); }
@@ -1215,17 +1213,17 @@ namespace Data {
 				return GranterID::Total;
 			}
 
-			__forceinline constexpr operator u32() const noexcept { return id.get(); }
-			__forceinline constexpr u32 Raw() const noexcept { return id.get(); }
+			FORCEINLINE constexpr operator u32() const noexcept { return id.get(); }
+			FORCEINLINE constexpr u32 Raw() const noexcept { return id.get(); }
 
-			__forceinline constexpr GranterID& operator+=(const u32 rhs) noexcept { id += rhs; return *this; }
-			__forceinline constexpr GranterID& operator-=(const u32 rhs) noexcept { id -= rhs; return *this; }
-			__forceinline constexpr GranterID& operator*=(const u32 rhs) noexcept { id *= rhs; return *this; }
-			__forceinline constexpr GranterID& operator/=(const u32 rhs) noexcept { id /= rhs; return *this; }
-			__forceinline constexpr GranterID& operator++() noexcept { ++id; return *this; }
-			__forceinline constexpr u32 operator++(int) noexcept { return id++; }
-			__forceinline constexpr GranterID& operator--() noexcept { --id; return *this; }
-			__forceinline constexpr u32 operator--(int) noexcept { return id--; }
+			FORCEINLINE constexpr GranterID& operator+=(const u32 rhs) noexcept { id += rhs; return *this; }
+			FORCEINLINE constexpr GranterID& operator-=(const u32 rhs) noexcept { id -= rhs; return *this; }
+			FORCEINLINE constexpr GranterID& operator*=(const u32 rhs) noexcept { id *= rhs; return *this; }
+			FORCEINLINE constexpr GranterID& operator/=(const u32 rhs) noexcept { id /= rhs; return *this; }
+			FORCEINLINE constexpr GranterID& operator++() noexcept { ++id; return *this; }
+			FORCEINLINE constexpr u32 operator++(int) noexcept { return id++; }
+			FORCEINLINE constexpr GranterID& operator--() noexcept { --id; return *this; }
+			FORCEINLINE constexpr u32 operator--(int) noexcept { return id--; }
 
 		private:
 			IDType id{ GranterID::Total };
@@ -1259,13 +1257,13 @@ namespace Data {
 			"This rule will be removed after it grants its reward."
 		};
 		struct GranterMaker {
-			__forceinline constexpr GranterID ID() const noexcept { return id; }
-			__forceinline constexpr u8 Difficulty() const noexcept { return difficulty; }
-			__forceinline constexpr u16 Goal() const noexcept { return GoalMult[goal_index] * difficulty; }
-			__forceinline constexpr bool RoC() const noexcept { return remove_on_completion; }
-			__forceinline constexpr void SetID(const GranterID new_id) noexcept { id = new_id; SetGoalIndex(); accepts_params = false; }
-			__forceinline constexpr void SetDifficulty(const u8 new_difficulty) noexcept { difficulty = new_difficulty; }
-			__forceinline constexpr void SetRoC(const bool new_roc) noexcept { remove_on_completion = new_roc; }
+			FORCEINLINE constexpr GranterID ID() const noexcept { return id; }
+			FORCEINLINE constexpr u8 Difficulty() const noexcept { return difficulty; }
+			FORCEINLINE constexpr u16 Goal() const noexcept { return GoalMult[goal_index] * difficulty; }
+			FORCEINLINE constexpr bool RoC() const noexcept { return remove_on_completion; }
+			FORCEINLINE constexpr void SetID(const GranterID new_id) noexcept { id = new_id; SetGoalIndex(); accepts_params = false; }
+			FORCEINLINE constexpr void SetDifficulty(const u8 new_difficulty) noexcept { difficulty = new_difficulty; }
+			FORCEINLINE constexpr void SetRoC(const bool new_roc) noexcept { remove_on_completion = new_roc; }
 
 			constexpr string Overview(const bool show_price = false) {
 				string res{};
@@ -1626,33 +1624,33 @@ namespace Data {
 
 
 		// Records
-		__forceinline constexpr array<float, 3> Boosts() const { return array<float, 3>{ mrate, srate, speed }; }
+		FORCEINLINE constexpr array<float, 3> Boosts() const { return array<float, 3>{ mrate, srate, speed }; }
 
-		__forceinline constexpr void AddBoosts(const array<float, 3>& extra) noexcept {
+		FORCEINLINE constexpr void AddBoosts(const array<float, 3>& extra) noexcept {
 			mrate += extra[0];
 			srate += extra[1];
 			speed += extra[2];
 		}
-		__forceinline constexpr void ClearBoosts() noexcept {
+		FORCEINLINE constexpr void ClearBoosts() noexcept {
 			mrate = 0.0f;
 			srate = 0.0f;
 			speed = 0.0f;
 		}
 		
-		__forceinline constexpr satu32 Total() const noexcept { return total; }
-		__forceinline constexpr satu32 Streak() const noexcept { return streak; }
-		__forceinline constexpr satu32 BestStreak() const noexcept { return best_streak; }
-		__forceinline constexpr satu32 SinceBoost() const noexcept { return since_boost; }
+		FORCEINLINE constexpr satu32 Total() const noexcept { return total; }
+		FORCEINLINE constexpr satu32 Streak() const noexcept { return streak; }
+		FORCEINLINE constexpr satu32 BestStreak() const noexcept { return best_streak; }
+		FORCEINLINE constexpr satu32 SinceBoost() const noexcept { return since_boost; }
 
-		__forceinline constexpr satu32 Total(const u32 num) noexcept { return (total = num); }
-		__forceinline constexpr satu32 Streak(const u32 num) noexcept {
+		FORCEINLINE constexpr satu32 Total(const u32 num) noexcept { return (total = num); }
+		FORCEINLINE constexpr satu32 Streak(const u32 num) noexcept {
 			if ((streak = num) > best_streak) {
 				best_streak = streak;
 			}
 			return streak;
 		}
-		__forceinline constexpr satu32 BestStreak(const u32 num) noexcept { return (best_streak = num); }
-		__forceinline constexpr satu32 SinceBoost(const u32 num) noexcept { return (since_boost = num); }
+		FORCEINLINE constexpr satu32 BestStreak(const u32 num) noexcept { return (best_streak = num); }
+		FORCEINLINE constexpr satu32 SinceBoost(const u32 num) noexcept { return (since_boost = num); }
 
 		constexpr void TickRecents(const float sec) noexcept {
 			// Non-ranged for loop consistently generates the best code on MSVC, at worst tied with something else. Both indexed and iterated are equally fast, with minor asm differences.
@@ -1786,7 +1784,7 @@ namespace Data {
 					case PreventerDodge:	{ filled = prev_dg.activate_check_full(); break; }
 					case PreventerSL:		{ filled = prev_sl.activate_random_check_full(gen); break; }
 					case Misc:				{ filled = misc_pun.activate_random_check_full(gen, follower); break; }
-					default:				{ __assume(0); }
+					default:				{ std::unreachable(); }
 					}
 					const u32 fill_mask = bool_extend<u32>(filled);
 					const u32 not_fill_mask = static_cast<u32>(~fill_mask);
@@ -40,15 +40,11 @@ namespace Data::PlayerRules {
 		return now - last_update_day.exchange(now, std::memory_order_relaxed) - days_to_skip.exchange(0.0f, std::memory_order_relaxed);
 	}
 
-	i32 UpdateShort(lazy_vector<rules_info>& infos, const milliseconds delta, const size_t player_index) noexcept {
+	// Decays recent dodges. Returns how many are left, or -1 if no time passed.
+	i32 UpdateShort(rules_info& info, const milliseconds delta) noexcept {
 		if (delta > 0ms) {
-			const float sec_delta = static_cast<float>(delta.count()) * 0.001f;
-			for (auto& info : infos) {
-				info.TickRecents(sec_delta);
-			}
-			if (player_index < infos.size()) {
-				return to_s32(infos[player_index].RecentsCount());
-			}
+			info.TickRecents(static_cast<float>(delta.count()) * 0.001f);
+			return to_s32(info.RecentsCount());
 		}
 		return -1;
 	}
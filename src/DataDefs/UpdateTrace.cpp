@@ -0,0 +1,179 @@
+#include "UpdateTrace.h"
+
+namespace Data::UpdateTrace {
+
+	template<typename T>
+	static void put(vector<char>& buf, const T* src, const size_t count) {
+		const size_t at = buf.size();
+		buf.resize(at + (count * sizeof(T)));
+		std::memcpy(buf.data() + at, src, count * sizeof(T));
+	}
+	// Copies out count Ts at pos and moves past them. False if the buffer ends first.
+	template<typename T>
+	static bool take(const vector<char>& buf, size_t& pos, T* dst, const size_t count) noexcept {
+		const size_t bytes = count * sizeof(T);
+		if (bytes > (buf.size() - pos)) {
+			return false;
+		}
+		std::memcpy(dst, buf.data() + pos, bytes);
+		pos += bytes;
+		return true;
+	}
+
+
+	bool recorder::open(const string& path) noexcept {
+		close();
+		try {
+			file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+			const file_header header{};
+			if (file.is_open()) {
+				file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			}
+		} catch (...) {}
+		if (!file.is_open() or !file) {
+			Log::Error("UpdateTrace: could not start a trace at <{}>!"sv, path);
+			close();
+			return false;
+		}
+		written = 0;
+		Log::Info("UpdateTrace: recording to <{}>"sv, path);
+		return true;
+	}
+
+	void recorder::close() noexcept {
+		if (file.is_open()) {
+			try { file.close(); } catch (...) {}
+			Log::Info("UpdateTrace: stopped after {} records"sv, written);
+		}
+		file.clear();
+	}
+
+	bool recorder::write(const record& rec) noexcept {
+		if (!file.is_open()) {
+			return false;
+		}
+		const record_header& head = rec.head;
+		const u32 count = head.is(record_header::FearRan) ? head.actor_count : 0;
+		const u32 words = rec.seeing.word_count();
+		try {
+			buffer.clear();
+			put(buffer, &head, 1);
+			put(buffer, rec.handles.data(), count);
+			put(buffer, rec.mains.data(), count);
+			put(buffer, rec.exposures.data(), count);
+			put(buffer, rec.fears_in.data(), count);
+			for (u32 i = 0; i < count; ++i) {
+				put(buffer, rec.seeing.seeing_row(i), words);
+			}
+			put(buffer, rec.fears_out.data(), count);
+			if (head.is(record_header::NeedRanks)) {
+				put(buffer, rec.ranks.data(), count);
+			}
+			if (head.is(record_header::RulesRan)) {
+				put(buffer, &rec.rules_in, 1);
+				put(buffer, &rec.equips, 1);
+				put(buffer, &rec.rules_out, 1);
+			}
+			// Fill in what the header can only know now
+			record_header full_head = head;
+			full_head.size = static_cast<u32>(buffer.size());
+			full_head.seeing_words = static_cast<u8>(words);
+			std::memcpy(buffer.data(), &full_head, sizeof(full_head));
+			file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+		} catch (...) {
+			file.setstate(std::ios::badbit);
+		}
+		if (!file) {
+			Log::Error("UpdateTrace: writing record {} failed!"sv, written);
+			close();
+			return false;
+		}
+		++written;
+		return true;
+	}
+
+
+	bool reader::open(const string& path) noexcept {
+		file_header header{};
+		try {
+			file.open(path, std::ios::in | std::ios::binary);
+			if (file.is_open()) {
+				file.read(reinterpret_cast<char*>(&header), sizeof(header));
+			}
+		} catch (...) {}
+		if (!file.is_open() or !file) {
+			Log::Error("UpdateTrace: could not read <{}>!"sv, path);
+			return false;
+		}
+		if (const file_header expected{}; !header.matches(expected)) {
+			Log::Error("UpdateTrace: <{}> is version {} with rows {}/{}/{} bytes for {} actors, this build reads version {} with {}/{}/{} for {}!"sv,
+				path, header.version, header.fear_info_size, header.rules_info_size, header.equip_state_size, header.max_update_count,
+				expected.version, expected.fear_info_size, expected.rules_info_size, expected.equip_state_size, expected.max_update_count);
+			return false;
+		}
+		return true;
+	}
+
+	bool reader::next(record& rec) noexcept {
+		record_header head{};
+		try {
+			if (!file.read(reinterpret_cast<char*>(&head), sizeof(head))) {
+				if (file.gcount() != 0) {
+					Log::Error("UpdateTrace: truncated record header!"sv);
+					bad_record = true;
+				}
+				return false; // Else end of trace
+			}
+			if ((head.size < sizeof(head)) or (head.actor_count > UpdateTypes::MaxUpdateCount) or (head.seeing_words > UpdateTypes::seeing_matrix::MaxWords)) {
+				Log::Error("UpdateTrace: malformed record header!"sv);
+				bad_record = true;
+				return false;
+			}
+			buffer.resize(head.size - sizeof(head));
+			if (!file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+				Log::Error("UpdateTrace: truncated record!"sv);
+				bad_record = true;
+				return false;
+			}
+		} catch (...) {
+			bad_record = true;
+			return false;
+		}
+
+		rec.head = head;
+		const u32 count = head.is(record_header::FearRan) ? head.actor_count : 0;
+		const u32 words = head.seeing_words;
+		if ((count != 0) and ((words * UpdateTypes::seeing_matrix::WordBits) < count)) {
+			Log::Error("UpdateTrace: seeing rows too short for {} actors!"sv, count);
+			bad_record = true;
+			return false;
+		}
+		size_t pos = 0;
+		bool ok = take(buffer, pos, rec.handles.data(), count)
+			and take(buffer, pos, rec.mains.data(), count)
+			and take(buffer, pos, rec.exposures.data(), count)
+			and take(buffer, pos, rec.fears_in.data(), count);
+		rec.seeing.reset(count);
+		array<UpdateTypes::seeing_matrix::word, UpdateTypes::seeing_matrix::MaxWords> row{};
+		for (u32 i = 0; ok and (i < count); ++i) {
+			ok = take(buffer, pos, row.data(), words);
+			for (u32 j = 0; ok and (j < count); ++j) {
+				rec.seeing.set_if_val(i, j, (row[j / UpdateTypes::seeing_matrix::WordBits] >> (j % UpdateTypes::seeing_matrix::WordBits)) & 1);
+			}
+		}
+		ok = ok and take(buffer, pos, rec.fears_out.data(), count);
+		if (ok and head.is(record_header::NeedRanks)) {
+			ok = take(buffer, pos, rec.ranks.data(), count);
+		}
+		if (ok and head.is(record_header::RulesRan)) {
+			ok = take(buffer, pos, &rec.rules_in, 1) and take(buffer, pos, &rec.equips, 1) and take(buffer, pos, &rec.rules_out, 1);
+		}
+		if (!ok or (pos != buffer.size())) {
+			Log::Error("UpdateTrace: record size does not match its contents!"sv);
+			bad_record = true;
+			return false;
+		}
+		return true;
+	}
+
+}
@@ -0,0 +1,154 @@
+#pragma once
+#include "FearKernel.h"
+#include "PlayerRules.h"
+#include <chrono>
+#include <fstream>
+
+namespace Data::UpdateTrace {
+	using std::chrono::milliseconds;
+
+	// Binary trace of default updates, for rerunning them outside the game: a file_header, then one record per update.
+	// Records hold what Fear::Update and rules_info::Update were given, as raw rows, plus what they gave back, so a replay can rerun both and diff.
+	// Rows are written as laid out in memory, so a trace only replays on a build with the same row sizes, which the header carries.
+
+	inline constexpr u32 Magic = 0x52545346; // "FSTR"
+	enum : u32 { Version = 2 }; // 2: replays pace the Fear math by delta_ms
+
+	struct file_header {
+		u32 magic{ Magic };
+		u32 version{ Version };
+		u32 max_update_count{ static_cast<u32>(UpdateTypes::MaxUpdateCount) };
+		u32 fear_info_size{ sizeof(FearInfo) };
+		u32 rules_info_size{ sizeof(rules_info) };
+		u32 equip_state_size{ sizeof(EquipState) };
+
+		bool matches(const file_header& other) const noexcept { return std::memcmp(this, &other, sizeof(file_header)) == 0; }
+	};
+	static_assert(std::is_trivially_copyable_v<file_header> and sizeof(file_header) == 24);
+
+	// After the header, if FearRan, per actor_count actors: handles, mains, exposures, fears before, seeing rows, fears after, and ranks if NeedRanks.
+	// Then the player's rules_info before, EquipState and rules_info after, if RulesRan.
+	struct record_header {
+		enum flag_bits : u8 {
+			FearRan = 1 << 0,
+			NeedRanks = 1 << 1,
+			RulesRan = 1 << 2,
+			Follower = 1 << 3
+		};
+
+		u32 size{};				// Bytes of the whole record, header included
+		u32 update_index{};		// Keys the thrillseeking rolls
+		i64 delta_ms{};			// Fear::Update delta
+		float now{};			// GameDaysPassed
+		float hostile{};		// Kernel::params
+		float interior{};
+		float rules_day_delta{};
+		u32 actor_count{};
+		u32 most_afraid_idx{};	// Out
+		float player_tension{};	// Out. In for rules_info::Update.
+		float player_willpower{};	// Out, if RulesRan
+		u8 flags{};
+		u8 seeing_words{};		// Words per seeing row
+		char pad[6]{};
+
+		constexpr bool is(const flag_bits bit) const noexcept { return flags & bit; }
+		constexpr void mark(const flag_bits bit, const bool val) noexcept { flags = static_cast<u8>((flags & ~bit) | (val * bit)); }
+	};
+	static_assert(std::is_trivially_copyable_v<record_header> and sizeof(record_header) == 56);
+
+	// One update, as recorded or as read back
+	struct record {
+		record_header head{};
+		array<trivial_handle, UpdateTypes::MaxUpdateCount> handles{};
+		array<UpdateTypes::main_out, UpdateTypes::MaxUpdateCount> mains{};
+		array<float, UpdateTypes::MaxUpdateCount> exposures{};
+		array<FearInfo, UpdateTypes::MaxUpdateCount> fears_in{};
+		array<FearInfo, UpdateTypes::MaxUpdateCount> fears_out{};
+		UpdateTypes::seeing_matrix seeing{};
+		array<UpdateTypes::applied_ranks, UpdateTypes::MaxUpdateCount> ranks{};
+		rules_info rules_in{};
+		rules_info rules_out{};
+		EquipState equips{};
+
+		// Fear::Update, before and after running the kernel
+		void fear_inputs(const milliseconds delta, const fear_columns& infos, const lazy_vector<float>& exposures_col, const array<UpdateTypes::main_out, UpdateTypes::MaxUpdateCount>& mains_in,
+						 const UpdateTypes::seeing_matrix& seeing_in, const array<trivial_handle, UpdateTypes::MaxUpdateCount>& handles_in, const UpdateTypes::ranks_and_oneofs& pack,
+						 const Fear::Kernel::params p, const u32 update_index) noexcept
+		{
+			const u32 actor_count = pack.actor_count;
+			head.update_index = update_index;
+			head.delta_ms = delta.count();
+			head.now = pack.now;
+			head.hostile = p.hostile;
+			head.interior = p.interior;
+			head.actor_count = actor_count;
+			head.mark(record_header::NeedRanks, pack.need_ranks);
+			std::copy_n(handles_in.begin(), actor_count, handles.begin());
+			std::copy_n(mains_in.begin(), actor_count, mains.begin());
+			std::copy_n(exposures_col.begin(), actor_count, exposures.begin());
+			for (u32 i = 0; i < actor_count; ++i) {
+				fears_in[i] = infos.row(i);
+			}
+			seeing = seeing_in;
+		}
+		void fear_outputs(const fear_columns& infos, const UpdateTypes::ranks_and_oneofs& pack, const Fear::Kernel::results res) noexcept {
+			for (u32 i = 0, end = head.actor_count; i < end; ++i) {
+				fears_out[i] = infos.row(i);
+			}
+			if (head.is(record_header::NeedRanks)) {
+				std::copy_n(pack.ranks.begin(), head.actor_count, ranks.begin());
+			}
+			head.most_afraid_idx = res.most_afraid_idx;
+			head.player_tension = res.player_tension;
+			head.mark(record_header::FearRan, true);
+		}
+		// rules_info::Update, before and after
+		void rules_inputs(const rules_info& rules, const EquipState& player_equips, const float day_delta, const float buildup, const bool follower) noexcept {
+			rules_in = rules;
+			equips = player_equips;
+			head.rules_day_delta = day_delta;
+			head.player_tension = buildup;
+			head.mark(record_header::Follower, follower);
+		}
+		void rules_outputs(const rules_info& rules) noexcept {
+			rules_out = rules;
+			head.player_willpower = rules.Exp().get();
+			head.mark(record_header::RulesRan, true);
+		}
+		void reset() noexcept { head = record_header{}; }
+		bool empty() const noexcept { return !head.is(record_header::FearRan) and !head.is(record_header::RulesRan); }
+	};
+
+	// Appends records to a trace file. Not thread safe, meant for the update thread alone.
+	class recorder {
+	public:
+		// Truncates path and writes a header
+		bool open(const string& path) noexcept;
+		void close() noexcept;
+		bool is_open() const noexcept { return file.is_open(); }
+		// Closes the file if the write fails
+		bool write(const record& rec) noexcept;
+		u64 records() const noexcept { return written; }
+
+	private:
+		std::ofstream file{};
+		vector<char> buffer{};	// One record, so it goes out in a single write
+		u64 written{ 0 };
+	};
+
+	// Reads records back in order
+	class reader {
+	public:
+		// False if it can't be read, or was written by a build with different row sizes
+		bool open(const string& path) noexcept;
+		// False at the end, or on a truncated or malformed record, after which malformed() says which
+		bool next(record& rec) noexcept;
+		bool malformed() const noexcept { return bad_record; }
+
+	private:
+		std::ifstream file{};
+		vector<char> buffer{};
+		bool bad_record{ false };
+	};
+
+}
@@ -1,254 +1,234 @@
 #include "ExtraKeywords.h"
 #include "Logger.h"
+#include "DataDefs/KeywordRecords.h"
+#include "Types/PairSet.h"
+#include "Types/SyncTypes.h"
 #include "Utils/PrimitiveUtils.h"
 
 namespace ExtraKeywords {
 	
-	// Ancient feature. Not used in-game but kept as is for reference.
+	// Ancient feature. Not used in-game.
 
 	namespace Data {
-		using Locker = std::lock_guard<std::mutex>;
-		std::mutex lock;
-		using Map = map<RE::FormID, std::set<RE::FormID>>; // Key:formID of forms to add keywords to		Value:set of the formIDs of all the keywords to add to Key's form
-		using Iterator = Map::iterator;
-		Map data;
+		using PairSet::pair_set;
+		static SyncTypes::LockProtectedResource<pair_set> locker{}; // (formID of a form keywords were added to, formID of an added keyword)
 
 
 		// Non-lockers, for internal use
-		u64 ClearInvalidsImpl() {
-			u64 count = 0;
-			for (Iterator iter = data.begin(), end = data.end(); iter != end;) {
-				if (iter->second.empty()) { // No data for this formiD
-					iter = data.erase(iter);
-					++count;
-				}
-				else if (const auto kwdForm = RE::TESForm::LookupByID<RE::BGSKeywordForm>(iter->first); !kwdForm || kwdForm->numKeywords == 0) { // formID can't produce a form with keywords
-					iter = data.erase(iter);
-					++count;
-				}
-				else {	
-					++iter;
-				}
+		static u64 ClearInvalidsImpl(pair_set& pairs) noexcept {
+			return pairs.erase_keys_if([](const RE::FormID formID) {
+				const auto kwdForm = RE::TESForm::LookupByID<RE::BGSKeywordForm>(formID);
+				return !kwdForm or (kwdForm->numKeywords == 0); // formID can't produce a form with keywords
+			});
+		}
+		static std::deque<bool> ToBools(const bits& found, const size_t count) {
+			std::deque<bool> result(count, false);
+			if ((found.size() * 64) < count) { // Ran out of memory for them
+				return result;
+			}
+			for (size_t i = 0; i < count; ++i) {
+				result[i] = (found[i / 64] >> (i % 64)) & 1;
+			}
+			return result;
+		}
+		// Keyword formIDs of whatever forms gives, 0 for nullptr
+		template<typename Get>
+		static bits HasEachImpl(RE::TESForm* form, const size_t count, Get&& get) {
+			bits found{};
+			if (!found.resize((count + 63) / 64)) { // Zeroed
+				return found;
 			}
-			return count;
+			if (!form or (count == 0)) {
+				return found;
+			}
+			LazyVector::lazy_vector<u32> ids{};
+			if (!ids.resize(count)) {
+				return found;
+			}
+			for (size_t i = 0; i < count; ++i) {
+				ids[i] = get(i);
+			}
+			locker.GetShared()->contains_each(form->formID, ids.data(), count, found.data());
+			for (size_t i = 0; i < count; ++i) { // 0 is no keyword, whatever got added
+				found[i / 64] &= ~(static_cast<u64>(ids[i] == 0) << (i % 64));
+			}
+			return found;
 		}
 
 
 		// Interface implementation		All these take the lock
 		bool Has(RE::TESForm* form, RE::BGSKeyword* keyword) {
-				if (!form || !keyword)
-					return false;
-				Locker locker(lock);
-				Iterator iter = data.find(form->formID);
-				if (iter != data.end())
-					return iter->second.contains(keyword->formID);
+			if (!form or !keyword) {
 				return false;
 			}
-		std::deque<bool> Has(RE::TESForm* form, vector<RE::BGSKeyword*> keywords) {
-			if (!form || keywords.size() <= 0)
-				return std::deque<bool>(keywords.size());
-			Locker locker(lock);
-			Iterator iter = data.find(form->formID);
-			if (iter == data.end())
-				return std::deque<bool>(keywords.size());
-			std::deque<bool> result(keywords.size(), false);
-			for (u64 i = 0; i < result.size(); ++i) {
-				if (keywords[i]) [[likely]]
-					result[i] = iter->second.contains(keywords[i]->formID);
+			return locker.GetShared()->contains(form->formID, keyword->formID);
+		}
+		bits HasEach(RE::TESForm* form, const std::span<RE::BGSKeyword* const> keywords) {
+			return HasEachImpl(form, keywords.size(), [&](const size_t i) { return keywords[i] ? keywords[i]->formID : 0; });
+		}
+		bits HasEach(RE::TESForm* form, RE::BGSListForm* formlist) {
+			if (!formlist) {
+				return {};
 			}
-			return result;
+			return HasEachImpl(form, formlist->forms.size(), [&](const size_t i) { return formlist->forms[static_cast<u32>(i)] ? formlist->forms[static_cast<u32>(i)]->formID : 0; });
+		}
+		std::deque<bool> Has(RE::TESForm* form, vector<RE::BGSKeyword*> keywords) {
+			return ToBools(HasEach(form, keywords), keywords.size());
 		}
 		std::deque<bool> Has(RE::TESForm* form, RE::BGSListForm* formlist) {
-			if (!form || !formlist || formlist->forms.size() <= 0)
+			if (!form or !formlist or formlist->forms.empty() or locker.GetShared()->block(form->formID).empty()) {
 				return std::deque<bool>{};
-			Locker locker(lock);
-			Iterator iter = data.find(form->formID);
-			if (iter == data.end())
-				return std::deque<bool>{};
-			std::deque<bool> result(formlist->forms.size(), false);
-			for (u32 i = 0; i < result.size(); ++i) {
-				if (formlist->forms[i]) [[likely]]
-					result[i] = iter->second.contains(formlist->forms[i]->formID);
 			}
-			return result;
+			return ToBools(HasEach(form, formlist), formlist->forms.size());
 		}
 		std::deque<bool> CrossKeywords(RE::TESForm* form, RE::BGSListForm* formlist) {
-			if (!form || !formlist || formlist->forms.empty() || formlist->forms.size() > INT_MAX) // Return shouldn't exceed UINT_MAX in size cause Papyrus, so input should be at most INT_MAX size
+			if (!form or !formlist or formlist->forms.empty() or (formlist->forms.size() > INT_MAX)) { // Return shouldn't exceed UINT_MAX in size cause Papyrus, so input should be at most INT_MAX size
 				return std::deque<bool>{};
+			}
 			const auto kwdForm = form->As<RE::BGSKeywordForm>();
-			if (!kwdForm)
+			if (!kwdForm) {
 				return std::deque<bool>{};
+			}
 			// [0 - size-1]     Toggle state:		has keyword
 			// [size - 2*size-1] Option flag:		has the keyword added and not natively
-			u32 size = formlist->forms.size();
-			std::deque<bool> result(2 * size, false);
-			for (u32 i = 0; i < size; ++i) { // Check has keywords
-				if (formlist->forms[i]) [[likely]]
-					result[i] = kwdForm->HasKeywordID(formlist->forms[i]->formID);
+			const u32 size = formlist->forms.size();
+			const bits added = HasEach(form, formlist);
+			if ((added.size() * 64) < size) {
+				return std::deque<bool>{};
 			}
-			Locker locker(lock); // Don't need the lock earlier
-			Iterator iter = data.find(form->formID);
-			if (iter == data.end())
-				return result; // Checked for keywords and there is no data of added ones so just return
-			for (u32 i = 0; i < size; ++i) { // Find if it has keywords natively
-				if (!result[i]) // Doesn't have the keyword, skip checks
-					continue;
-				if (formlist->forms[i]) // Don't access nullptr
-					result[static_cast<u64>(i) + size] = iter->second.contains(formlist->forms[i]->formID); // Found in data so it does not have the keyword natively
+			std::deque<bool> result(2 * static_cast<size_t>(size), false);
+			for (u32 i = 0; i < size; ++i) {
+				if (formlist->forms[i]) [[likely]] {
+					result[i] = kwdForm->HasKeywordID(formlist->forms[i]->formID);
+					result[static_cast<size_t>(i) + size] = result[i] and ((added[i / 64] >> (i % 64)) & 1); // Found in data so it does not have the keyword natively
+				}
 			}
-
-
 			return result;
 		}
 		bool Add(RE::TESForm* form, RE::BGSKeyword* keyword) {
-			if (!form || !keyword)
+			if (!form or !keyword) {
 				return false;
-
+			}
 			auto kwdForm = form->As<RE::BGSKeywordForm>();
-			if (!kwdForm || kwdForm->HasKeyword(keyword))
+			if (!kwdForm or kwdForm->HasKeyword(keyword)) {
 				return false;
-
-			Locker locker(lock);
-			data[form->formID].insert(keyword->formID); // Attempt to add to set
-			if (data[form->formID].contains(keyword->formID) && kwdForm->AddKeyword(keyword))
+			}
+			const auto locked = locker.GetExclusive();
+			if (locked->insert(form->formID, keyword->formID) and kwdForm->AddKeyword(keyword)) {
 				return true; // Exists in set and got added to form successfully
-			else // Either insertion in set or addition of keyword failed. Being here means that the keyword has NOT been added to the form.
-				data[form->formID].erase(keyword->formID); // So just erase the keyword formID from the set, if it existed.
+			}
+			locked->erase(form->formID, keyword->formID); // Either insertion in set or addition of keyword failed. Being here means that the keyword has NOT been added to the form.
 			return false;
 		}
 		bool Remove(RE::TESForm* form, RE::BGSKeyword* keyword) {
-			if (!form || !keyword)
+			if (!form or !keyword) {
 				return false;
-
-			Locker locker(lock);
-			Iterator iter = data.find(form->formID);
-			if (!iter->second.contains(keyword->formID))
+			}
+			const auto locked = locker.GetExclusive();
+			if (!locked->contains(form->formID, keyword->formID)) {
 				return false; // Attempted to remove a keyword we didn't add
-
+			}
 			auto kwdForm = form->As<RE::BGSKeywordForm>();
-			if (!kwdForm)
+			if (!kwdForm) {
 				return false; // form can't hold keywords
-
-			if (!kwdForm->HasKeyword(keyword))
-				return iter->second.erase(keyword->formID) > 0; // keyword formID did exist in the set but the form doesn't have the keyword for some reason
-
+			}
+			if (!kwdForm->HasKeyword(keyword)) {
+				return locked->erase(form->formID, keyword->formID); // keyword formID did exist in the set but the form doesn't have the keyword for some reason
+			}
 			if (kwdForm->RemoveKeyword(keyword)) {
-				iter->second.erase(keyword->formID); // Keyword did get removed, so erase entry from set. erase() can't fail.
+				locked->erase(form->formID, keyword->formID); // Keyword did get removed, so erase the pair. Can't fail.
 				return true;
 			}
-			
 			return false; // form had the keyword, and the set was up to date, but the keyword removal failed for some reason
 		}
 
-		void Clear() { Locker locker(lock); data.clear(); }
-		u64 ClearInvalids() { Locker locker(lock); return ClearInvalidsImpl(); }
+		void Clear() { locker.GetExclusive()->clear(); }
+		u64 ClearInvalids() { return ClearInvalidsImpl(*locker.GetExclusive()); }
 		string Dump() {
-			string result = "";
-			Locker locker(lock);
-			result = "[ExtraKeywords Dump] (" + to_string(data.size()) + " entries)\n";
-			for (const auto& [formID, kwds] : data) {
+			const auto locked = locker.GetShared();
+			string result = "[ExtraKeywords Dump] (" + to_string(locked->key_count()) + " entries)\n";
+			locked->for_each_block([&result](const RE::FormID formID, const std::span<const u64> block) {
 				if (RE::TESForm* form = RE::TESForm::LookupByID(formID); form)
 					result += "\n\t" + PrimitiveUtils::u32_xstr(formID) + " (" + form->GetName() + ")";
 				else
 					result += "\n\t" + PrimitiveUtils::u32_xstr(formID);
-				result += " has " + to_string(kwds.size()) + " extra keywords:";
+				result += " has " + to_string(block.size()) + " extra keywords:";
 
-				for (const auto& kwd : kwds) {
+				for (const u64 pair : block) {
+					const RE::FormID kwd = pair_set::value_of(pair);
 					if (RE::BGSKeyword* kwdForm = RE::TESForm::LookupByID<RE::BGSKeyword>(kwd); kwdForm)
 						result += "\n\t\t" + PrimitiveUtils::u32_xstr(kwd) + " (" + string{ kwdForm->formEditorID } + ")";
 					else
 						result += "\n\t\t" + PrimitiveUtils::u32_xstr(kwd);
 				}
-			}
+			});
 			return result + "\n[ExtraKeywords Dump Finished]";
 		}
 
 
 		bool Save(SKSE::SerializationInterface& intfc) {
-			using PrimitiveUtils::u32_xstr;
-
-			if (!intfc.OpenRecord(SerializationType, SerializationVersion))
-				return false;
-
-			Locker locker(lock);
-
-			ClearInvalidsImpl();
-
-			if (!intfc.WriteRecordData(data.size())) {	// Serialize how many pairs are gonna be serialized
-				Log::Critical("Failed to serialize ExtraKeywords data map size!"sv);
+			if (!intfc.OpenRecord(SerializationType, SerializationVersion)) {
 				return false;
 			}
-
-			for (const auto& [formID, kwds] : data) {
-				if (!intfc.WriteRecordData(formID)) { Log::Critical("Failed to serialize formID {} for ExtraKeywords!"sv, u32_xstr(formID)); return false; }
-
-				if (!intfc.WriteRecordData(kwds.size())) { Log::Critical("Failed to serialize {}'s extra keywords!"sv, u32_xstr(formID)); return false; }
-				for (const auto kwd : kwds) {
-					if (!intfc.WriteRecordData(kwd)) { Log::Critical("Failed to serialize extra keyword {} for {}!"sv,  u32_xstr(kwd), u32_xstr(formID)); return false; }
-				}
+			const auto locked = locker.GetExclusive();
+			ClearInvalidsImpl(*locked);
+			if (!Records::Write(intfc, *locked)) {
+				return false;
 			}
 			Log::Info("Serialized ExtraKeywords"sv);
 			return true;
 		}
 
-		bool Load(SKSE::SerializationInterface& intfc) {
+		bool Load(SKSE::SerializationInterface& intfc, const u32 version) {
 			using PrimitiveUtils::u32_xstr;
 
-			u64 size;
-			if (!intfc.ReadRecordData(size)) {  // Deserialize how many pairs we are gonna read
-				Log::Critical("Failed to read size of ExtraKeywords data map!"sv);
+			LazyVector::lazy_vector<u64> saved{};
+			if (!Records::Read(intfc, version, saved)) {
 				return false;
 			}
 
-			Locker locker(lock);
-			data.clear();
+			// Saved pairs come grouped by form. Resolve each form once, then its keywords, and keep the pairs whose keyword got added.
+			LazyVector::lazy_vector<u64> applied{};
+			if (!applied.reserve(saved.size())) {
+				Log::Critical("Not enough memory to deserialize ExtraKeywords data!"sv);
+				return false;
+			}
+			size_t form_count = 0;
+			for (size_t i = 0, end = saved.size(); i < end;) {
+				const RE::FormID saved_formID = pair_set::key_of(saved[i]);
+				size_t block_end = i;
+				for (; (block_end != end) and (pair_set::key_of(saved[block_end]) == saved_formID); ++block_end) { ; }
+				++form_count;
 
-			u64 i = 0;
-			for (i = 0; i < size; i++) {
 				RE::FormID formID;
-
-				if (!intfc.ReadRecordData(formID)) { Log::Critical("Failed to deserialize formID {} for ExtraKeywords!"sv, u32_xstr(formID)); return false; }
-				bool failstate = false; // Resolve failure doesn't mean we're out. Deserialize keyword ids to progress the buffer, ignore this formID, and move to the next.
-				if (!intfc.ResolveFormID(formID, formID)) { Log::Critical("Failed to resolve formID {}!"sv, u32_xstr(formID)); failstate = true; }
-
-
-				u64 keywordsSize;
-				if (!intfc.ReadRecordData(keywordsSize)) { Log::Critical("Failed to read extra keywords set size for formID {}!"sv, u32_xstr(formID)); return false; }
-
 				RE::BGSKeywordForm* kwdForm = nullptr;
-				Iterator iter = data.end();
-				if (!failstate) {
-					if (kwdForm = RE::TESForm::LookupByID<RE::BGSKeywordForm>(formID); kwdForm) {
-						iter = data.emplace(formID, std::set<RE::FormID>{}).first; // Make a map entry here so we can check its success and avoid adding keywords if it failed
-					}
-					failstate = !kwdForm || iter == data.end();
+				if (!intfc.ResolveFormID(saved_formID, formID)) {
+					Log::Critical("Failed to resolve formID {}!"sv, u32_xstr(saved_formID));
+				} else {
+					kwdForm = RE::TESForm::LookupByID<RE::BGSKeywordForm>(formID);
 				}
-
-				for (u64 k = 0; k < keywordsSize; k++) {
-					RE::FormID kwdID;
-					if (!intfc.ReadRecordData(kwdID)) { Log::Error("Failed to read extra keyword formID for {}!"sv, u32_xstr(formID)); return false; }
-					// Reading is done for this loop, so only continue if we haven't failed.
-					if (!failstate) {
-						if (!intfc.ResolveFormID(kwdID, kwdID)) {
-							Log::Error("Failed to resolve extra keyword formID {} and cannot add it to {}!"sv, u32_xstr(kwdID), u32_xstr(formID));
-							continue;
-						}
-						if (RE::BGSKeyword* kwd = RE::TESForm::LookupByID<RE::BGSKeyword>(kwdID); kwd && iter->second.insert(kwdID).second) {
-							if (!kwdForm->AddKeyword(kwd)) { // Adding the keyword to the form failed
-								iter->second.erase(kwdID); // So erase the kwdID that just got inserted and go on with looping
-							}
-						}
+				for (; kwdForm and (i < block_end); ++i) {
+					RE::FormID kwdID = pair_set::value_of(saved[i]);
+					if (!intfc.ResolveFormID(kwdID, kwdID)) {
+						Log::Error("Failed to resolve extra keyword formID {} and cannot add it to {}!"sv, u32_xstr(kwdID), u32_xstr(formID));
+						continue;
+					}
+					if (RE::BGSKeyword* kwd = RE::TESForm::LookupByID<RE::BGSKeyword>(kwdID); kwd and kwdForm->AddKeyword(kwd)) {
+						applied.append(pair_set::make(formID, kwdID));
 					}
 				}
+				i = block_end;
 			}
-			Log::Info("Deserialized {} Keyword sets"sv, i);
+
+			locker.GetExclusive()->assign(std::move(applied));
+			Log::Info("Deserialized {} Keyword sets"sv, form_count);
 			return true;
 		}
 
-		void Revert() { Locker locker(lock); data.clear(); }
+		void Revert() { locker.GetExclusive()->clear(); }
 
 
 
 	}
 
-}
+}
\ No newline at end of file
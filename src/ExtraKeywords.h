@@ -1,14 +1,22 @@
 #pragma once
 #include "Common.h"
+#include "Types/LazyVector.h"
+
+#include <span>
 
 
 namespace ExtraKeywords {
 
 	namespace Data {
 		constexpr u32 SerializationType{ 'EXKW' };
-		constexpr u32 SerializationVersion{ 1 };
+		constexpr u32 SerializationVersion{ 2 };	// Newest. 2 writes a block per form (DataDefs/KeywordRecords.h).
+
+		using bits = LazyVector::lazy_vector<u64>;	// Bit i of word i / 64 per queried keyword i
 
 		bool Has(RE::TESForm* form, RE::BGSKeyword* keyword);
+		// Batch queries under one shared lock. Which of keywords were added to form.
+		bits HasEach(RE::TESForm* form, const std::span<RE::BGSKeyword* const> keywords);
+		bits HasEach(RE::TESForm* form, RE::BGSListForm* formlist);
 		std::deque<bool> Has(RE::TESForm* form, vector<RE::BGSKeyword*> keywords);
 		std::deque<bool> Has(RE::TESForm* form, RE::BGSListForm* formlist);
 		std::deque<bool> CrossKeywords(RE::TESForm* form, RE::BGSListForm* formlist);
@@ -20,7 +28,7 @@ namespace ExtraKeywords {
 
 
 		bool Save(SKSE::SerializationInterface& intfc);
-		bool Load(SKSE::SerializationInterface& intfc); // This applies them as it reads them
+		bool Load(SKSE::SerializationInterface& intfc, const u32 version); // This applies them as it reads them. Older versions are migrated.
 		void Revert();
 
 	}
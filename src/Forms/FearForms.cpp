@@ -17,15 +17,13 @@ namespace Fear {
 
 	bool FormsFilled() noexcept { return formsFilled.load(std::memory_order_acquire); }
 
-	lazy_vector<KWD> KwdsToIdx(const lazy_vector<RE::BGSKeyword*>& kwds) {
-		lazy_vector<KWD> result{};
-		if (result.reserve(KEYWORDS.size())) {
-			for (auto IT = KEYWORDS.begin(), END = KEYWORDS.end(); IT != END; ++IT) { // Not worth trying to quit early with just 5 iterations
-				for (auto it = kwds.begin(), end = kwds.end(); it != end; ++it) {
-					if (*IT == *it) {
-						result.append(static_cast<KWD>(IT - KEYWORDS.begin())); // Cast is noop
-						break;
-					}
+	small_lazy_vector<KWD, static_cast<size_t>(KWD::Total)> KwdsToIdx(RE::BGSKeyword* const* kwds, const u32 count) noexcept {
+		small_lazy_vector<KWD, static_cast<size_t>(KWD::Total)> result{}; // Each KEYWORDS entry appends at most once, so this never spills
+		for (auto IT = KEYWORDS.begin(), END = KEYWORDS.end(); IT != END; ++IT) { // Not worth trying to quit early with just 5 iterations
+			for (auto it = kwds, end = kwds + count; it != end; ++it) {
+				if (*IT == *it) {
+					result.append(static_cast<KWD>(IT - KEYWORDS.begin())); // Cast is noop
+					break;
 				}
 			}
 		}
@@ -15,15 +15,13 @@ namespace Hurdles {
 	array<RE::EffectSetting*, static_cast<size_t>(EFF::Total)> EFFECTS;
 
 
-	lazy_vector<KWD> KwdsToIdx(const lazy_vector<RE::BGSKeyword*>& kwds) {
-		lazy_vector<KWD> result{};
-		if (result.reserve(KEYWORDS.size())) {
-			for (auto it = kwds.begin(), end = kwds.end(); it != end; ++it) { // Gonna go on a limb and assume most things have less than 27 keywords
-				for (auto IT = KEYWORDS.begin(), END = KEYWORDS.end(); IT != END; ++IT) {
-					if (*IT == *it) {
-						result.append(static_cast<KWD>(IT - KEYWORDS.begin())); // Cast is noop
-						break;
-					}
+	small_lazy_vector<KWD, static_cast<size_t>(KWD::Total)> KwdsToIdx(RE::BGSKeyword* const* kwds, const u32 count) noexcept {
+		small_lazy_vector<KWD, static_cast<size_t>(KWD::Total)> result{};
+		for (auto it = kwds, end = kwds + count; it != end; ++it) { // Gonna go on a limb and assume most things have less than 27 keywords
+			for (auto IT = KEYWORDS.begin(), END = KEYWORDS.end(); IT != END; ++IT) {
+				if (*IT == *it) {
+					result.try_append(static_cast<KWD>(IT - KEYWORDS.begin())); // Cast is noop. Checked since a form listing the same keyword twice could exceed the inline room.
+					break;
 				}
 			}
 		}
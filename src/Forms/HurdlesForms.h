@@ -1,6 +1,7 @@
 #pragma once
 #include "Common.h"
 #include "Types/LazyVector.h"
+#include "Types/SmallLazyVector.h"
 
 namespace Hurdles {
 	// Placeholder Hurdle IDs stuff. Some used to carry special meaning. Atm pointless. Redo once Hurdles actually implemented in game assets.
@@ -44,7 +45,8 @@ namespace Hurdles {
 
 
 
-	[[nodiscard]] LazyVector::lazy_vector<KWD> KwdsToIdx(const LazyVector::lazy_vector<RE::BGSKeyword*>& kwds);
+	// Inline room for every keyword, so matching never allocates
+	[[nodiscard]] LazyVector::small_lazy_vector<KWD, static_cast<size_t>(KWD::Total)> KwdsToIdx(RE::BGSKeyword* const* kwds, const u32 count) noexcept;
 
 	[[nodiscard]] RE::BGSKeyword* Keyword(const KWD idx) noexcept;
 
@@ -6,6 +6,10 @@
 // #include "Utils/StringUtils.h"
 #include "Utils/GameDataUtils.h"
 #include "Utils/PrimitiveUtils.h"
+#include "Utils/RNG.h"
+#include "Types/HandleIndex.h"
+#include "Types/SyncTypes.h"
+#include "DataDefs/FearKernel.h"
 #include <chrono>
 // using namespace std::chrono;
 using namespace GameDataUtils;
@@ -22,77 +26,77 @@ namespace TestFunctions {
 	string ToBits (const u64 num) {
 		string str{};
 
-		if (num & (1ui64 << 63)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 62)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 61)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 60)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 59)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 58)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 57)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 56)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 63)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 62)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 61)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 60)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 59)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 58)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 57)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 56)) { str += '1'; } else { str += '0'; }
 		str += ' ';
-		if (num & (1ui64 << 55)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 54)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 53)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 52)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 51)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 50)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 49)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 48)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 55)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 54)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 53)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 52)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 51)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 50)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 49)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 48)) { str += '1'; } else { str += '0'; }
 		str += ' ';
-		if (num & (1ui64 << 47)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 46)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 45)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 44)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 43)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 42)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 41)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 40)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 47)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 46)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 45)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 44)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 43)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 42)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 41)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 40)) { str += '1'; } else { str += '0'; }
 		str += ' ';
-		if (num & (1ui64 << 39)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 38)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 37)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 36)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 35)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 34)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 33)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 32)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 39)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 38)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 37)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 36)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 35)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 34)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 33)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 32)) { str += '1'; } else { str += '0'; }
 		str += ' ';
-		if (num & (1ui64 << 31)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 30)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 29)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 28)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 27)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 26)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 25)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 24)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 31)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 30)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 29)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 28)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 27)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 26)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 25)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 24)) { str += '1'; } else { str += '0'; }
 		str += ' ';
-		if (num & (1ui64 << 23)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 22)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 21)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 20)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 19)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 18)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 17)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 16)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 23)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 22)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 21)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 20)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 19)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 18)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 17)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 16)) { str += '1'; } else { str += '0'; }
 		str += ' ';
-		if (num & (1ui64 << 15)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 14)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 13)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 12)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 11)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 10)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 9)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 8)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 15)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 14)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 13)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 12)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 11)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 10)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 9)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 8)) { str += '1'; } else { str += '0'; }
 		str += ' ';
-		if (num & (1ui64 << 7)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 6)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 5)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 4)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 3)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 2)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 1)) { str += '1'; } else { str += '0'; }
-		if (num & (1ui64 << 0)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 7)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 6)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 5)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 4)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 3)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 2)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 1)) { str += '1'; } else { str += '0'; }
+		if (num & (1ull << 0)) { str += '1'; } else { str += '0'; }
 
 		return str;
 	}
@@ -336,12 +340,333 @@ namespace TestFunctions {
 
 
 
+	// Compares handle_index lookups with the linear lazy_vector scan multivector used before it. Keys look like native handles (index bits plus an age above).
+	void BenchHandleIndex(StaticFunc) {
+		using clock = std::chrono::steady_clock;
+		static constexpr array<u32, 3> RowCounts{ 100, 1'000, 10'000 };
+		enum : u32 { LookupCount = 20'000 };
+
+		RNG::gamerand rnd{ 0x4645 };
+		for (const u32 rows : RowCounts) {
+			lazy_vector<u32> keys{};
+			lazy_vector<u32> queries{};
+			HandleIndex::handle_index index{};
+			if (!keys.reserve(rows) or !queries.reserve(LookupCount) or !index.reserve(rows)) {
+				Log::Error("BenchHandleIndex: out of memory!"sv);
+				return;
+			}
+			for (u32 i = 0; i < rows; ++i) {
+				keys.append(((rnd.next(63) + 1) << 20) | (i + 1));
+				index.insert_or_assign(keys.back(), i);
+			}
+			for (u32 i = 0; i < LookupCount; ++i) {
+				queries.append(keys[rnd.next(rows)]);
+			}
+
+			u64 scan_sum = 0;
+			const auto scan_start = clock::now();
+			for (const u32 key : queries) {
+				scan_sum += static_cast<u64>(keys.find(key) - keys.begin());
+			}
+			const auto scan_time = clock::now() - scan_start;
+
+			u64 index_sum = 0;
+			const auto index_start = clock::now();
+			for (const u32 key : queries) {
+				index_sum += index.find(key);
+			}
+			const auto index_time = clock::now() - index_start;
+
+			Log::Info("BenchHandleIndex: {} rows, {} lookups: scan {} ns/lookup, index {} ns/lookup{}"sv, rows, static_cast<u32>(LookupCount),
+				std::chrono::duration_cast<std::chrono::nanoseconds>(scan_time).count() / LookupCount,
+				std::chrono::duration_cast<std::chrono::nanoseconds>(index_time).count() / LookupCount,
+				(scan_sum == index_sum) ? ""sv : " (MISMATCH!)"sv);
+		}
+	}
+
+
+	// Compares lazy_vector::find on u32, which takes the SIMD path, with the plain scalar loop it used before. Every lookup misses, so each one is a full scan.
+	void BenchFind(StaticFunc) {
+		using clock = std::chrono::steady_clock;
+		static constexpr array<u32, 4> Sizes{ 32, 256, 4'096, 65'536 };
+		enum : u32 { ScannedPerSize = 16'777'216 };
+
+		RNG::gamerand rnd{ 0x4645 };
+		for (const u32 size : Sizes) {
+			lazy_vector<u32> keys{};
+			if (!keys.reserve(size)) {
+				Log::Error("BenchFind: out of memory!"sv);
+				return;
+			}
+			for (u32 i = 0; i < size; ++i) {
+				keys.append(rnd.next() | 1); // Queries are even
+			}
+			const u32 lookups = ScannedPerSize / size;
+
+			u64 scalar_sum = 0;
+			const auto scalar_start = clock::now();
+			for (u32 i = 0; i < lookups; ++i) {
+				const u32 query = i << 1;
+				const u32* it = keys.begin();
+				for (; (it != keys.end()) and (*it != query); ++it) { ; }
+				scalar_sum += static_cast<u64>(it - keys.begin());
+			}
+			const auto scalar_time = clock::now() - scalar_start;
+
+			u64 simd_sum = 0;
+			const auto simd_start = clock::now();
+			for (u32 i = 0; i < lookups; ++i) {
+				simd_sum += static_cast<u64>(keys.find(i << 1) - keys.begin());
+			}
+			const auto simd_time = clock::now() - simd_start;
+
+			Log::Info("BenchFind: {} elements, {} lookups: scalar {} ns/lookup, simd {} ns/lookup{}"sv, size, lookups,
+				std::chrono::duration_cast<std::chrono::nanoseconds>(scalar_time).count() / lookups,
+				std::chrono::duration_cast<std::chrono::nanoseconds>(simd_time).count() / lookups,
+				(scalar_sum == simd_sum) ? ""sv : " (MISMATCH!)"sv);
+		}
+	}
+
+
+	// Worst and average time 1 writer waits for the lock while reader_count threads keep taking it shared
+	template<typename Lock>
+	static void BenchLockContentionWith(const string_view name, const u32 reader_count) {
+		using clock = std::chrono::steady_clock;
+		using std::chrono::nanoseconds;
+		enum : u32 { WriterRounds = 2'000 };
+
+		Lock lock{};
+		std::atomic<bool> stop{ false };
+		std::atomic<u64> reads{ 0 };
+		volatile u64 shared_value = 0;
+
+		vector<std::thread> readers{};
+		readers.reserve(reader_count);
+		for (u32 r = 0; r < reader_count; ++r) {
+			readers.emplace_back([&] {
+				u64 local_reads = 0;
+				while (!stop.load(std::memory_order_relaxed)) {
+					lock.lock_shared();
+					for (u32 spin = 0; spin < 64; ++spin) { // Getter sized critical section
+						(void)shared_value;
+					}
+					lock.unlock_shared();
+					++local_reads;
+				}
+				reads.fetch_add(local_reads, std::memory_order_relaxed);
+			});
+		}
+
+		nanoseconds worst{ 0 }, total{ 0 };
+		for (u32 round = 0; round < WriterRounds; ++round) {
+			const auto start = clock::now();
+			lock.lock();
+			const nanoseconds waited = clock::now() - start;
+			shared_value = shared_value + 1;
+			lock.unlock();
+			worst = std::max(worst, waited);
+			total += waited;
+			for (const auto until = clock::now() + std::chrono::microseconds{ 50 }; clock::now() < until;) { ; } // Let readers pile up again
+		}
+		stop.store(true, std::memory_order_relaxed);
+		for (auto& reader : readers) {
+			reader.join();
+		}
+
+		Log::Info("BenchLockContention: {} with {} readers: writer waited {} ns worst, {} ns average, readers got in {} times"sv,
+			name, reader_count, worst.count(), total.count() / WriterRounds, reads.load(std::memory_order_relaxed));
+	}
+	void BenchLockContention(StaticFunc, i32 reader_count) {
+		const u32 count = static_cast<u32>(std::clamp(reader_count, 1, 31));
+		BenchLockContentionWith<SyncTypes::shared_spinlock>("shared_spinlock"sv, count);
+		BenchLockContentionWith<SyncTypes::writer_preferring_spinlock>("writer_preferring_spinlock"sv, count);
+	}
+
+
+	// Random but plausible Fear kernel inputs. Padding lanes get filled too, since the SIMD version computes them.
+	static void FillFearLanes(Data::Fear::Kernel::lanes& l, const u32 count, RNG::gamerand& rnd) noexcept {
+		const u32 padded = (count + (Data::Fear::Kernel::lanes::Width - 1)) & ~(Data::Fear::Kernel::lanes::Width - 1);
+		for (u32 i = 0; i < padded; ++i) {
+			l.days_since_rest[i] = rnd.nextf(0.0f, 60.0f);
+			l.buildup_mod[i] = rnd.nextf(0.0f, 10.0f);
+			l.hppcnt[i] = static_cast<float>(rnd.next(101));
+			l.combat[i] = static_cast<float>(rnd.next(2));
+			l.seen_by_m[i] = static_cast<float>(rnd.next(20));
+			l.seen_by_f[i] = static_cast<float>(rnd.next(20));
+			l.seeing_exposure_m[i] = rnd.next(2) ? rnd.nextf(0.0f, 10.0f) : 0.0f; // Often seeing no one of a sex, which flips the loss masks
+			l.seeing_exposure_f[i] = rnd.next(2) ? rnd.nextf(0.0f, 10.0f) : 0.0f;
+			l.thrill_mod[i] = rnd.nextf01();
+			l.fears_male[i] = rnd.nextf01();
+			l.fears_female[i] = rnd.nextf01();
+			l.old_fear[i] = rnd.nextf01();
+		}
+	}
+
+	// Golden check of the SIMD Fear kernel against the scalar reference, over rounds of random inputs and actor counts. Both should agree to the bit, as RunSIMD() promises, so any difference fails.
+	bool CheckFearKernel(StaticFunc, i32 rounds) {
+		using Data::Fear::Kernel::lanes;
+
+		static lanes scalar{};
+		static lanes simd{};
+		RNG::gamerand rnd{ 0x4645 };
+		u32 worst = 0, worst_count = 0;
+		bool found_highest = true;
+		for (i32 round = 0, end = std::clamp(rounds, 1, 100'000); round < end; ++round) {
+			const u32 count = rnd.next(lanes::Capacity) + 1;
+			FillFearLanes(scalar, count, rnd);
+			simd = scalar;
+			const Data::Fear::Kernel::params p = Data::Fear::Kernel::Paced(rnd.next(2) ? 1.5f : 1.0f, rnd.next(2) ? 2.0f : 1.0f, std::chrono::milliseconds{ 1000 + rnd.next(21'000) }); // Any delta the cadence can pick
+			Data::Fear::Kernel::RunScalar(scalar, 0, count, p);
+			Data::Fear::Kernel::RunSIMD(simd, 0, count, p);
+			if (const float highest = *std::max_element(scalar.new_fear.begin(), scalar.new_fear.begin() + count); (highest >= 0.0f) and (scalar.new_fear[Data::Fear::Kernel::MostAfraid(scalar, count)] != highest)) {
+				Log::Error("CheckFearKernel: MostAfraid() missed the highest fear of {} actors!"sv, count);
+				found_highest = false;
+			}
+			for (u32 i = 0; i < count; ++i) {
+				if (const u32 ulps = std::max(Data::Fear::Kernel::UlpDistance(scalar.new_fear[i], simd.new_fear[i]), Data::Fear::Kernel::UlpDistance(scalar.buildup[i], simd.buildup[i])); ulps > worst) {
+					worst = ulps;
+					worst_count = count;
+				}
+			}
+		}
+		// The most afraid in the middle, with a less afraid last
+		scalar.new_fear[0] = 0.2f;
+		scalar.new_fear[1] = 0.9f;
+		scalar.new_fear[2] = 0.4f;
+		scalar.new_fear[3] = 0.1f;
+		const bool found_middle = Data::Fear::Kernel::MostAfraid(scalar, 4) == 1;
+		if (!found_middle) {
+			Log::Error("CheckFearKernel: MostAfraid() did not pick actor 1 of 4!"sv);
+		}
+		const bool passed = (worst == 0) and found_highest and found_middle;
+		Log::Info("CheckFearKernel: {} rounds, worst difference {} ulp (at {} actors): {}"sv, rounds, worst, worst_count, passed ? "passed"sv : "FAILED"sv);
+		return passed;
+	}
+
+	// Scalar and SIMD Fear kernel times at typical, old cap, and crowded actor counts
+	void BenchFearKernel(StaticFunc) {
+		using clock = std::chrono::steady_clock;
+		using Data::Fear::Kernel::lanes;
+		static constexpr array<u32, 3> Counts{ 8, 32, 128 };
+		enum : u32 { Runs = 20'000 };
+
+		static lanes l{};
+		RNG::gamerand rnd{ 0x4645 };
+		for (const u32 count : Counts) {
+			FillFearLanes(l, count, rnd);
+			const Data::Fear::Kernel::params p{ .hostile = 1.5f, .interior = 1.0f };
+			float sink = 0.0f;
+
+			const auto scalar_start = clock::now();
+			for (u32 run = 0; run < Runs; ++run) {
+				Data::Fear::Kernel::RunScalar(l, 0, count, p);
+				sink += l.new_fear[run % count];
+			}
+			const auto scalar_time = clock::now() - scalar_start;
+
+			const auto simd_start = clock::now();
+			for (u32 run = 0; run < Runs; ++run) {
+				Data::Fear::Kernel::RunSIMD(l, 0, count, p);
+				sink += l.new_fear[run % count];
+			}
+			const auto simd_time = clock::now() - simd_start;
+
+			Log::Info("BenchFearKernel: {} actors: scalar {} ns/update, simd {} ns/update (sink {})"sv, count,
+				std::chrono::duration_cast<std::chrono::nanoseconds>(scalar_time).count() / Runs,
+				std::chrono::duration_cast<std::chrono::nanoseconds>(simd_time).count() / Runs, sink);
+		}
+	}
+
+
+	// Runs the same random Fear update on 1 to MaxWorkers + 1 threads and checks every output is bit-identical to the single-threaded one
+	bool CheckFearThreads(StaticFunc, i32 actor_count) {
+		using namespace Data;
+		using Fear::Kernel::lanes;
+
+		const u32 count = static_cast<u32>(std::clamp(actor_count, 1, static_cast<i32>(lanes::Capacity)));
+		RNG::gamerand rnd{ 0x4645 };
+
+		// Inputs
+		fear_columns base{};
+		lazy_vector<float> exposures{};
+		if (!base.reserve(count) or !exposures.reserve(count)) {
+			Log::Error("CheckFearThreads: out of memory!"sv);
+			return false;
+		}
+		static array<UpdateTypes::main_out, lanes::Capacity> mains{};
+		static array<trivial_handle, lanes::Capacity> handles{};
+		static UpdateTypes::seeing_matrix seeing{};
+		seeing.reset(count);
+		for (u32 i = 0; i < count; ++i) {
+			FearInfo info{};
+			info.fear = rnd.nextf01();
+			info.thrillseeking = rnd.nextf01();
+			info.fears_female = rnd.nextf01();
+			info.fears_male = rnd.nextf01();
+			info.buildup_mod = rnd.nextf(0.0f, 10.0f);
+			info.last_rest_day = rnd.nextf(0.0f, 30.0f);
+			info.is_female = rnd.next(2);
+			info.in_brawl = rnd.next(8) == 0;
+			base.append(info);
+			exposures.append(rnd.nextf01());
+			mains[i] = UpdateTypes::main_out{ .hppcnt = static_cast<u8>(rnd.next(101)), .combat = rnd.next(4) == 0 };
+			handles[i] = std::bit_cast<trivial_handle>((rnd.next(63) + 1) << 20 | (i + 1));
+			for (u32 j = 0; j < count; ++j) {
+				seeing.set_if_val(i, j, rnd.next(3) == 0);
+			}
+		}
+		const Fear::Kernel::params p{ .hostile = 1.5f, .interior = 1.0f };
+
+		struct outputs {
+			fear_columns infos{};
+			UpdateTypes::ranks_and_oneofs pack{};
+			Fear::Kernel::results res{};
+		};
+		auto run = [&](const u32 workers, outputs& out) {
+			static lanes l{};
+			SyncTypes::worker_pool pool{};
+			out.infos = base;
+			out.pack.actor_count = count;
+			out.pack.now = 30.0f;
+			out.pack.need_ranks = true;
+			const bool pooled = pool.resize(workers) != 0;
+			out.res = Fear::Kernel::Compute(l, out.infos, exposures, mains, seeing, handles, out.pack, p, 7, pooled ? &pool : nullptr);
+		};
+		auto same = [count](const outputs& a, const outputs& b) {
+			auto same_col = [count](const auto& x, const auto& y) { return std::memcmp(x.data(), y.data(), count * sizeof(x[0])) == 0; };
+			return same_col(a.infos.fear, b.infos.fear) and same_col(a.infos.thrillseeking, b.infos.thrillseeking) and same_col(a.infos.buildup_mod, b.infos.buildup_mod)
+				and (std::memcmp(a.pack.ranks.data(), b.pack.ranks.data(), count * sizeof(a.pack.ranks[0])) == 0)
+				and (a.res.most_afraid_idx == b.res.most_afraid_idx) and (std::bit_cast<u32>(a.res.player_tension) == std::bit_cast<u32>(b.res.player_tension));
+		};
+
+		outputs reference{};
+		run(0, reference);
+		bool passed = true;
+		for (u32 workers = 1; workers <= SyncTypes::worker_pool::MaxWorkers; ++workers) {
+			outputs threaded{};
+			run(workers, threaded);
+			if (!same(reference, threaded)) {
+				Log::Error("CheckFearThreads: {} actors on {} threads differ from 1 thread!"sv, count, workers + 1);
+				passed = false;
+			}
+		}
+		Log::Info("CheckFearThreads: {} actors, 1 to {} threads: {}"sv, count, static_cast<u32>(SyncTypes::worker_pool::MaxWorkers) + 1, passed ? "identical"sv : "FAILED"sv);
+		return passed;
+	}
+
+
 	bool Register(IVM* vm) {
 
 		vm->RegisterFunction("DoSomething"sv, script, DoSomething);
 		vm->RegisterFunction("DoSomething4"sv, script, DoSomething4);
 		vm->RegisterFunction("DoSomething3"sv, script, DoSomething3);
 		vm->RegisterFunction("DoSomething2"sv, script, DoSomething2);
+		vm->RegisterFunction("BenchHandleIndex"sv, script, BenchHandleIndex);
+		vm->RegisterFunction("BenchFind"sv, script, BenchFind);
+		vm->RegisterFunction("BenchLockContention"sv, script, BenchLockContention);
+		vm->RegisterFunction("CheckFearKernel"sv, script, CheckFearKernel);
+		vm->RegisterFunction("BenchFearKernel"sv, script, BenchFearKernel);
+		vm->RegisterFunction("CheckFearThreads"sv, script, CheckFearThreads);
 		// vm->RegisterFunction("FrameTest"sv, script, FrameTest, true);
 
 		return true;
@@ -24,21 +24,74 @@ namespace Periodic {
 		std::atomic<bool> pause_waiter{ false };
 		Data::Shared::UpdateDeltas waiteds{};
 
-		constexpr milliseconds IntervalDefault = 7s;
+		constexpr milliseconds IntervalDefault = 7s;		// Few actors around, none in combat
+		constexpr milliseconds IntervalCombat = 3s;			// Fear moves fastest in combat
+		constexpr milliseconds IntervalCrowd = 5s;			// Plenty of actors that come and go
+		constexpr milliseconds IntervalAlone = 14s;			// Only the player
+		constexpr milliseconds IntervalDefaultMax = 21s;	// Where backing off stops
+		constexpr milliseconds IntervalShortMin = 1s;		// While there are recent dodges to decay
+		constexpr milliseconds IntervalShortMax = 8s;		// Where backing off stops. Also bounds how late a new dodge shows in the description.
 		constexpr milliseconds IntervalLong = 120s;
+		constexpr u32 CrowdCount = 24;
+		constexpr i64 MinCostRatio = 50; // Default updates no closer than this many times what the last one cost, so they stay under 2% of a thread
+
+
+		// Paces short and default updates by what the last ones saw. Only touched by the timer thread.
+		// Default: the interval follows actor count and combat, backs off by half again each time nothing changed, and never gets under MinCostRatio times the last cost.
+		// Fear paces its math by the delta (Kernel::TickInterval), so this changes how often fear moves, not how fast. IntervalDefaultMax is Kernel::MaxTicks of them.
+		// Short: every IntervalShortMin while there are recent dodges, doubling up to IntervalShortMax while there are none.
+		class cadence {
+		public:
+			milliseconds Default() const noexcept { return default_interval; }
+			milliseconds Short() const noexcept { return short_interval; }
+
+			void Observe(const Data::Shared::UpdateKinds kinds, const Data::Shared::UpdateActivity& act) noexcept {
+				if (kinds.is_marked(Data::Shared::UpdateKinds::ShortUpdate)) {
+					short_interval = act.recent_dodges ? IntervalShortMin : std::min(short_interval * 2, IntervalShortMax);
+				}
+				if (kinds.is_marked(Data::Shared::UpdateKinds::DefaultUpdate) and (act.actor_count != 0)) { // 0 means nothing was computed yet, so nothing to go by
+					const milliseconds target = Target(act);
+					const milliseconds backoff_max = (act.in_combat != 0) ? target : std::max(target, IntervalDefaultMax); // A steady fight still moves fear, so no backing off
+					milliseconds next = act.changed ? target : std::clamp((default_interval * 3) / 2, target, backoff_max);
+					next = std::max(next, act.cost * MinCostRatio);
+					if (next != default_interval) {
+						// Log::Info("Timer: default interval {} ms -> {} ms ({} actors, {} in combat, changed {}, cost {} ms)"sv, default_interval.count(), next.count(), act.actor_count, act.in_combat, act.changed, act.cost.count());
+						default_interval = next;
+					}
+				}
+			}
+
+		private:
+			milliseconds default_interval{ IntervalDefault };
+			milliseconds short_interval{ IntervalShortMin }; // Start eager, to pick up dodges from the loaded game
+
+			static milliseconds Target(const Data::Shared::UpdateActivity& act) noexcept {
+				if (act.in_combat != 0) {
+					return IntervalCombat;
+				}
+				if (act.actor_count >= CrowdCount) {
+					return IntervalCrowd;
+				}
+				if (act.actor_count <= 1) {
+					return IntervalAlone;
+				}
+				return IntervalDefault;
+			}
+		};
 
 
 		static void Update() {
 			Data::Shared::UpdateDeltas deltas{};
+			cadence pace{};
 			while (true) {
 
 				pause_waiter.wait(true); // Wait while paused
 
 				auto start = steady_clock::now();
 				std::unique_lock locker{ vars_lock };
-				if (const milliseconds adjusted_interval{ (IntervalDefault - deltas.delta_default) }; adjusted_interval > 0ms) {
+				if (const milliseconds adjusted_interval{ std::min(pace.Default() - deltas.delta_default, pace.Short() - deltas.delta_short) }; adjusted_interval > 0ms) {
 					// Log::Info("Timer::Update: waiting for {} ms"sv, adjusted_interval.count());
-					update_waiter.wait_for(locker, adjusted_interval); // Only wait if not ready for default update
+					update_waiter.wait_for(locker, adjusted_interval); // Only wait if not ready for any update
 				}
 				auto end = steady_clock::now();
 				deltas += duration_cast<milliseconds>(end - start);
@@ -58,7 +111,11 @@ namespace Periodic {
 				Data::Shared::UpdateKinds kinds{};
 				Data::Shared::UpdateDeltas deltas_copy{ deltas };
 
-				if (deltas.delta_default >= IntervalDefault) { // Start default updates no more often than once per IntervalDefault
+				if (deltas.delta_short >= pace.Short()) {
+					kinds.mark(Data::Shared::UpdateKinds::ShortUpdate);
+					deltas.delta_short = 0ms;
+				}
+				if (deltas.delta_default >= pace.Default()) { // Start default updates no more often than the cadence says
 					kinds.mark(Data::Shared::UpdateKinds::DefaultUpdate);
 					deltas.delta_default = 0ms;
 				}
@@ -69,7 +126,7 @@ namespace Periodic {
 
 				if (kinds.any_marked()) {
 					// Log::Info("Timer:Update: starting update"sv);
-					Data::Shared::Update(kinds, deltas_copy);
+					pace.Observe(kinds, Data::Shared::Update(kinds, deltas_copy));
 					// Log::Info("Timer::Update: done with update"sv);
 					deltas += duration_cast<milliseconds>(steady_clock::now() - end); // Account for time spent doing updates. deltas and end are not shared so no lock needed.
 				}
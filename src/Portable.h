@@ -0,0 +1,75 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// The few compiler specifics the shared code needs, spelled so it builds with MSVC for the plugin and with GCC/Clang for tools/.
+// Everything else uses std:: (std::bit_width instead of _BitScanReverse, std::unreachable() instead of __assume(0), standard integer literal suffixes).
+
+#if defined(_MSC_VER)
+#define FORCEINLINE __forceinline
+#else
+#define FORCEINLINE __attribute__((always_inline)) inline
+#endif
+
+namespace Portable {
+
+	// Spin-wait hint. Lets the sibling hyperthread run and saves power while spinning on a lock.
+	FORCEINLINE void pause() noexcept {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+		_mm_pause();
+#else
+		std::this_thread::yield();
+#endif
+	}
+
+	// Returns the low 64 bits of a * b, and puts the high ones in high
+	FORCEINLINE std::uint64_t mul128(const std::uint64_t a, const std::uint64_t b, std::uint64_t& high) noexcept {
+#if defined(_MSC_VER)
+		return _umul128(a, b, &high);
+#else
+		const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+		high = static_cast<std::uint64_t>(product >> 64);
+		return static_cast<std::uint64_t>(product);
+#endif
+	}
+
+	// Aligned heap. alignment must be a power of 2.
+	inline void* aligned_malloc(const std::size_t bytes, const std::size_t alignment) noexcept {
+#if defined(_MSC_VER)
+		return _aligned_malloc(bytes, alignment);
+#else
+		const std::size_t rounded = std::max((bytes + alignment - 1) & ~(alignment - 1), alignment); // aligned_alloc() wants a nonzero multiple of alignment
+		return std::aligned_alloc(alignment, rounded);
+#endif
+	}
+	// Like realloc(). old_bytes is what ptr was allocated with, since there is no aligned realloc() outside MSVC and the copy needs it.
+	inline void* aligned_realloc(void* ptr, [[maybe_unused]] const std::size_t old_bytes, const std::size_t new_bytes, const std::size_t alignment) noexcept {
+#if defined(_MSC_VER)
+		return _aligned_realloc(ptr, new_bytes, alignment);
+#else
+		void* const moved = aligned_malloc(new_bytes, alignment);
+		if (moved and ptr) {
+			std::memcpy(moved, ptr, std::min(old_bytes, new_bytes));
+			std::free(ptr);
+		}
+		return moved;
+#endif
+	}
+	inline void aligned_free(void* ptr) noexcept {
+#if defined(_MSC_VER)
+		_aligned_free(ptr);
+#else
+		std::free(ptr);
+#endif
+	}
+
+}
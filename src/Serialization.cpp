@@ -32,8 +32,8 @@ namespace Serialization {
 				Data::Shared::Load(*intfc, version);
 				continue;
 			case (ExtraKeywords::Data::SerializationType):
-				if (version != ExtraKeywords::Data::SerializationVersion) { Log::Critical("ExtraKeywords data is out of date! Read {}, expected {}"sv, version, ExtraKeywords::Data::SerializationVersion); }
-				else if (!ExtraKeywords::Data::Load(*intfc)) { Log::Critical("Failed to deserialize ExtraKeywords data!"sv); }
+				if ((version == 0) or (version > ExtraKeywords::Data::SerializationVersion)) { Log::Critical("ExtraKeywords data version {} is unknown! Expected up to {}"sv, version, ExtraKeywords::Data::SerializationVersion); }
+				else if (!ExtraKeywords::Data::Load(*intfc, version)) { Log::Critical("Failed to deserialize ExtraKeywords data!"sv); }
 				continue;
 			default: Log::Critical("Unrecognized type of deserialized record {}!"sv, PrimitiveUtils::u32_str(type));
 			}
@@ -34,8 +34,8 @@ namespace FlagTypes {
 		constexpr u8 GetRaw() const noexcept { return f; }
 
 	private:
-		static constexpr u8 FIRST = 0b1000'0000ui8;
-		static constexpr u8 LAST = 0b0000'0001ui8;
+		static constexpr u8 FIRST = u8{ 0b1000'0000 };
+		static constexpr u8 LAST = u8{ 0b0000'0001 };
 		static constexpr u8 BOTH = FIRST | LAST;
 
 		u8 f;
@@ -0,0 +1,5 @@
+#include "HandleIndex.h"
+
+namespace HandleIndex {
+	
+}
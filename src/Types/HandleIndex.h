@@ -0,0 +1,145 @@
+#pragma once
+#include "Common.h"
+#include "Types/LazyVector.h"
+
+namespace HandleIndex {
+	using LazyVector::lazy_vector;
+
+	// Open-addressing (linear probing) map of native handle -> row, for O(1) lookups into handle-indexed parallel arrays.
+	// Key 0 marks an empty slot, which is fine because 0 is never a valid handle and so never needs an index entry.
+	// Capacity is always a power of 2 kept at least twice the entry count, so probes stay short. Deletion shifts back following entries instead of leaving tombstones.
+	// It only maps keys to rows. Owners must verify the row still holds the key, since rows can be zeroed or compacted behind the index's back.
+	class handle_index {
+	public:
+		enum : u32 { NotFound = std::numeric_limits<u32>::max() };
+
+		constexpr handle_index() noexcept = default;
+		constexpr handle_index(const handle_index&) = default;
+		constexpr handle_index(handle_index&&) noexcept = default;
+		constexpr handle_index& operator=(const handle_index&) = default;
+		constexpr handle_index& operator=(handle_index&&) noexcept = default;
+		constexpr ~handle_index() noexcept = default;
+
+		constexpr size_t size() const noexcept { return count; }
+		constexpr size_t capacity() const noexcept { return slots.size(); }
+
+		constexpr u32 find(const u32 key) const noexcept {
+			if ((key == 0) or slots.empty()) {
+				return NotFound;
+			}
+			for (u32 i = home(key); ; i = (i + 1) & mask) {
+				if (const slot& s = slots[i]; s.key == key) {
+					return s.row;
+				} else if (s.key == 0) {
+					return NotFound;
+				}
+			}
+		}
+
+		// Can only fail if a new key needs growing and that fails. Reserving beforehand guarantees success, and assigning to a present key never grows.
+		constexpr bool insert_or_assign(const u32 key, const u32 row) noexcept {
+			if (key == 0) {
+				return true; // Never indexed
+			}
+			if (!slots.empty()) {
+				for (u32 i = home(key); slots[i].key != 0; i = (i + 1) & mask) {
+					if (slots[i].key == key) {
+						slots[i].row = row;
+						return true;
+					}
+				}
+			}
+			if (!reserve(count + 1ull)) {
+				return false;
+			}
+			for (u32 i = home(key); ; i = (i + 1) & mask) {
+				if (slot& s = slots[i]; s.key == 0) {
+					s.key = key;
+					s.row = row;
+					++count;
+					return true;
+				}
+			}
+		}
+
+		constexpr bool erase(const u32 key) noexcept {
+			if ((key == 0) or slots.empty()) {
+				return false;
+			}
+			u32 hole = home(key);
+			for (; slots[hole].key != key; hole = (hole + 1) & mask) {
+				if (slots[hole].key == 0) {
+					return false; // Not present
+				}
+			}
+			// Shift back every following entry of the cluster whose home does not lie cyclically in (hole, next].
+			for (u32 next = (hole + 1) & mask; slots[next].key != 0; next = (next + 1) & mask) {
+				if (((next - home(slots[next].key)) & mask) >= ((next - hole) & mask)) {
+					slots[hole] = slots[next];
+					hole = next;
+				}
+			}
+			slots[hole].key = 0;
+			--count;
+			return true;
+		}
+
+		// Makes room for entry_count entries without further growth.
+		constexpr bool reserve(const size_t entry_count) noexcept {
+			if ((entry_count * 2) <= slots.size()) {
+				return true;
+			}
+			return rehash(std::bit_ceil(std::max<size_t>(entry_count * 2, MinCapacity)));
+		}
+
+		constexpr void clear() noexcept {
+			if (count != 0) {
+				std::memset(slots.data(), 0, slots.size() * sizeof(slot));
+				count = 0;
+			}
+		}
+
+	private:
+		struct slot {
+			u32 key;
+			u32 row;
+		};
+		static_assert(std::is_trivially_copyable_v<slot> and std::is_trivially_default_constructible_v<slot>);
+
+		enum : size_t { MinCapacity = 16 };
+
+		lazy_vector<slot> slots{};
+		u32 count{ 0 };
+		u32 mask{ 0 };	// capacity - 1
+		u32 shift{ 32 };	// 32 - log2(capacity)
+
+		constexpr u32 home(const u32 key) const noexcept { return (key * 0x9E3779B9u) >> shift; } // Fibonacci hashing. Native handles differ mostly in their low bits, which this spreads to the high ones kept.
+
+		constexpr bool rehash(const size_t new_capacity) noexcept {
+			if (new_capacity > (1ull << 31)) {
+				return false;
+			}
+			lazy_vector<slot> fresh{};
+			if (!fresh.resize(new_capacity)) { // Zeroed, ie all empty
+				return false;
+			}
+			const lazy_vector<slot> old{ std::move(slots) };
+			slots = std::move(fresh);
+			mask = static_cast<u32>(new_capacity - 1);
+			shift = 32 - static_cast<u32>(std::countr_zero(new_capacity));
+			count = 0;
+			for (const slot& s : old) {
+				if (s.key != 0) {
+					u32 i = home(s.key);
+					while (slots[i].key != 0) {
+						i = (i + 1) & mask;
+					}
+					slots[i] = s;
+					++count;
+				}
+			}
+			return true;
+		}
+	};
+
+}
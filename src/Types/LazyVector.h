@@ -41,6 +41,9 @@ namespace LazyVector {
 		static constexpr bool SafeCopyAssignment = std::is_nothrow_copy_assignable_v<T>; // Always true if TrivialCopying == true.
 		static constexpr bool SafeMoveAssignment = std::is_nothrow_move_assignable_v<T>; // Always true if TrivialCopying == true.
 
+		// 4-byte T whose == can only mean bytewise equality (no padding, no float-like types) gets searched with SIMD compares (see PrimitiveUtils::find_u32).
+		static constexpr bool VectorFind = (Bytes == 4) and std::is_trivially_copyable_v<T> and std::has_unique_object_representations_v<T> and std::equality_comparable<T>;
+
 	public:
 		using size_type = size_t;
 		using value_type = T;
@@ -134,6 +137,11 @@ namespace LazyVector {
 
 		template<typename U> requires(!std::is_same_v<T*, U> and (Small or !std::is_same_v<T, U>))
 		constexpr T* find_in(const U val, T* from, T* to) const noexcept {
+			if constexpr (VectorFind and std::is_same_v<T, U>) {
+				if !consteval {
+					return const_cast<T*>(reinterpret_cast<const T*>(PrimitiveUtils::find_u32(reinterpret_cast<const u32*>(from), reinterpret_cast<const u32*>(to), std::bit_cast<u32>(val))));
+				}
+			}
 			T* it = from;
 			for (; (it != to) and (*it != val); ++it) { ; }
 			return it;
@@ -800,9 +808,10 @@ namespace LazyVector {
 		}
 
 
-		constexpr T* allocate(const size_t size) noexcept { return static_cast<T*>(_aligned_malloc(size * Bytes, Alignment)); }
-		constexpr T* reallocate_self(const size_t newcapacity) noexcept { return static_cast<T*>(_aligned_realloc(arr_first, newcapacity * Bytes, Alignment)); }
-		constexpr void free_self() noexcept { _aligned_free(arr_first); }
+		// Allocations always hold 1 more element than the capacity, hence the + 1 in the old size realloc() needs off Windows
+		constexpr T* allocate(const size_t size) noexcept { return static_cast<T*>(Portable::aligned_malloc(size * Bytes, Alignment)); }
+		constexpr T* reallocate_self(const size_t newcapacity) noexcept { return static_cast<T*>(Portable::aligned_realloc(arr_first, (capacity() + 1) * Bytes, newcapacity * Bytes, Alignment)); }
+		constexpr void free_self() noexcept { Portable::aligned_free(arr_first); }
 
 	};
 
@@ -1,7 +1,5 @@
 #pragma once
-// #include <intrin.h> // We only need the below, but keeping this here in case the below filename ever changes.
-#include <intrin0.inl.h>
-#pragma intrinsic(_umul128)
+#include "Portable.h" // mul128
 
 namespace NumericTypes {
 
@@ -28,13 +26,14 @@ namespace NumericTypes {
 		static constexpr bool is_signed{ std::signed_integral<T> };
 		static constexpr bool under64{ bytes < sizeof(u64t) };
 
+		// Specializations below are partial (on the unused D), since only MSVC takes explicit ones in class scope.
 		// Floatings
-		template <bool, size_t> struct helper_types { using sT = void; using uT = void; using swT = void; using uwT = void; };
+		template <bool, size_t, typename D = void> struct helper_types { using sT = void; using uT = void; using swT = void; using uwT = void; };
 		// Integrals
-		template <> struct helper_types<true, 1> { using sT = i8t;	using uT = u8t;	using swT = i16t;	using uwT = u16t; };
-		template <> struct helper_types<true, 2> { using sT = i16t;	using uT = u16t;using swT = i32t;	using uwT = u32t; };
-		template <> struct helper_types<true, 4> { using sT = i32t;	using uT = u32t;using swT = i64t;	using uwT = u64t; };
-		template <> struct helper_types<true, 8> { using sT = i64t;	using uT = u64t;using swT = void;	using uwT = void; };
+		template <typename D> struct helper_types<true, 1, D> { using sT = i8t;	using uT = u8t;	using swT = i16t;	using uwT = u16t; };
+		template <typename D> struct helper_types<true, 2, D> { using sT = i16t;	using uT = u16t;using swT = i32t;	using uwT = u32t; };
+		template <typename D> struct helper_types<true, 4, D> { using sT = i32t;	using uT = u32t;using swT = i64t;	using uwT = u64t; };
+		template <typename D> struct helper_types<true, 8, D> { using sT = i64t;	using uT = u64t;using swT = void;	using uwT = void; };
 
 		using sT = helper_types<is_integral, bytes>::sT;
 		using uT = helper_types<is_integral, bytes>::uT;
@@ -43,7 +42,7 @@ namespace NumericTypes {
 
 
 		// Integrals
-		template <typename U> struct helper_constants {
+		template <typename U, typename D = void> struct helper_constants {
 			static constexpr U shrcnt = static_cast<U>(sizeof(T) * 8 - 1); // Amount to shift right to signmask. SIGNED right shift extends the leftmost bit; instead of just prepending 0s like unsigned.
 			static constexpr U tminabs = (U{ 1 } << shrcnt); // Absolute of minimum of T
 			static constexpr U tmaxabs = tminabs - 1; // Absolute of maximum of T
@@ -55,22 +54,22 @@ namespace NumericTypes {
 			static constexpr U maxabs = (std::bit_cast<U>(max) ^ maxsgn) - maxsgn; // Absolute of max
 		};
 		// Floatings
-		template <> struct helper_constants<void> {};
+		template <typename D> struct helper_constants<void, D> {};
 
 		using constants = helper_constants<uT>;
 
 
 		template <typename U>
-		__forceinline static constexpr const U& mymin(const U& l, const U& r) noexcept { return l < r ? l : r; }
+		FORCEINLINE static constexpr const U& mymin(const U& l, const U& r) noexcept { return l < r ? l : r; }
 		template <typename U>
-		__forceinline static constexpr const U& mymax(const U& l, const U& r) noexcept { return l < r ? r : l; }
+		FORCEINLINE static constexpr const U& mymax(const U& l, const U& r) noexcept { return l < r ? r : l; }
 		template <typename U>
-		__forceinline static constexpr U& clamp_minmax(U& v) noexcept {
+		FORCEINLINE static constexpr U& clamp_minmax(U& v) noexcept {
 			v = mymax<U>(v, min);
 			v = mymin<U>(v, max);
 			return v;
 		}
-		__forceinline constexpr void clamp_self() noexcept requires(is_floating) {
+		FORCEINLINE constexpr void clamp_self() noexcept requires(is_floating) {
 			val = mymax(val, min);
 			val = mymin(val, max);
 		}
@@ -199,7 +198,7 @@ namespace NumericTypes {
 						const uT rhsabs = (std::bit_cast<uT>(rhs) ^ rhssgn) - rhssgn; // Absolute of rhs.
 
 						uT high; // Will hold the high 64 bits of the 128 bit result.
-						uT low = _umul128(valabs, rhsabs, &high); // Returns the low 64 bits. Remember, this is UNSIGNED multiplication.
+						uT low = Portable::mul128(valabs, rhsabs, high); // Returns the low 64 bits. Remember, this is UNSIGNED multiplication.
 
 						const uT maxlow = (constants::minabs & ressgn) | (constants::maxabs & ~ressgn); // minabs if result is negative, maxabs if result is positive.
 
@@ -212,7 +211,7 @@ namespace NumericTypes {
 					}
 					else { // 64bit unsigned
 						uT high;
-						val = _umul128(val, rhs, &high); // Don't use temporary for low. Worse codegen.
+						val = Portable::mul128(val, rhs, high); // Don't use temporary for low. Worse codegen.
 						const uT overflow_mask = std::bit_cast<uT>(std::bit_cast<i64t>(static_cast<uT>(high != 0) << 63) >> 63);
 						val = (overflow_mask & max) | (~overflow_mask & val);
 						val = clamp_minmax(val);
@@ -230,10 +229,7 @@ namespace NumericTypes {
 			if constexpr (is_integral) {
 				if constexpr (is_signed) {
 					if constexpr (min == std::numeric_limits<T>::min()) { // val could be minimum T, and if it is and rhs is -1 then overflow
-						enum : T {
-							tmin = (1i32 << (sizeof(T) * 8i32 - 1i32))
-						};
-						val += ((val == tmin) & (rhs == -1)); // Avoid that by adding 1 to val, making its absolute equal to the absolute of max, and division by /-1 later return max, which is what we want.
+						val += ((val == std::numeric_limits<T>::min()) & (rhs == -1)); // Avoid that by adding 1 to val, making its absolute equal to the absolute of max, and division by /-1 later return max, which is what we want.
 					}
 					T temp = val / rhs;
 					temp = (temp < min) ? min : temp; // Don't change to assignment only if cond is true. Generates branches. Idfk.
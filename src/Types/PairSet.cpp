@@ -0,0 +1,65 @@
+#include "PairSet.h"
+
+namespace PairSet {
+
+	std::span<const u64> pair_set::block(const u32 key) const noexcept {
+		const u64* first = std::lower_bound(pairs.begin(), pairs.end(), make(key, 0));
+		const u64* last = first;
+		for (const u64* end = pairs.end(); (last != end) and (key_of(*last) == key); ++last) { ; } // Blocks are short, so a scan beats a second search
+		return { first, last };
+	}
+
+	void pair_set::contains_each(const u32 key, const u32* values, const size_t count, u64* bits) const noexcept {
+		std::fill_n(bits, (count + 63) / 64, u64{ 0 });
+		const std::span<const u64> found = block(key);
+		if (found.empty()) {
+			return;
+		}
+		for (size_t i = 0; i < count; ++i) {
+			bits[i / 64] |= static_cast<u64>(std::binary_search(found.begin(), found.end(), make(key, values[i]))) << (i % 64);
+		}
+	}
+
+	bool pair_set::insert(const u32 key, const u32 value) noexcept {
+		const u64 pair = make(key, value);
+		const size_t pos = static_cast<size_t>(std::lower_bound(pairs.begin(), pairs.end(), pair) - pairs.begin());
+		if ((pos != pairs.size()) and (pairs[pos] == pair)) {
+			return true;
+		}
+		const size_t old_size = pairs.size();
+		if (!pairs.resize(old_size + 1)) { // Grows by powers of 2
+			return false;
+		}
+		std::memmove(pairs.begin() + pos + 1, pairs.begin() + pos, (old_size - pos) * sizeof(u64));
+		pairs[pos] = pair;
+		return true;
+	}
+
+	bool pair_set::erase(const u32 key, const u32 value) noexcept {
+		const u64 pair = make(key, value);
+		u64* it = std::lower_bound(pairs.begin(), pairs.end(), pair);
+		if ((it == pairs.end()) or (*it != pair)) {
+			return false;
+		}
+		std::memmove(it, it + 1, static_cast<size_t>(pairs.end() - (it + 1)) * sizeof(u64));
+		(void)pairs.resize(pairs.size() - 1);
+		return true;
+	}
+
+	size_t pair_set::key_count() const noexcept {
+		size_t count = 0;
+		for (size_t i = 0, end = pairs.size(); i < end; ++i) {
+			count += (i == 0) or (key_of(pairs[i]) != key_of(pairs[i - 1]));
+		}
+		return count;
+	}
+
+	void pair_set::assign(lazy_vector<u64>&& unsorted) noexcept {
+		pairs = std::move(unsorted);
+		if (!std::is_sorted(pairs.begin(), pairs.end())) { // Saved sets come back sorted unless load order moved their formIDs
+			std::sort(pairs.begin(), pairs.end());
+		}
+		(void)pairs.resize(static_cast<size_t>(std::unique(pairs.begin(), pairs.end()) - pairs.begin()));
+	}
+
+}
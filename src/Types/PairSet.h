@@ -0,0 +1,80 @@
+#pragma once
+#include "Common.h"
+#include "Types/LazyVector.h"
+
+#include <span>
+
+namespace PairSet {
+	using LazyVector::lazy_vector;
+
+	// Set of (key, value) pairs of u32s, kept as one sorted array of (key << 32) | value.
+	// A key's pairs are one contiguous block sorted by value, so lookups are a binary search and whole blocks can be copied or written at once.
+	// Insertions and erasures shift the tail. Fine for sets that are mostly read, and changed a pair at a time.
+	class pair_set {
+	public:
+		constexpr pair_set() noexcept = default;
+		constexpr pair_set(const pair_set&) = default;
+		constexpr pair_set(pair_set&&) noexcept = default;
+		constexpr pair_set& operator=(const pair_set&) = default;
+		constexpr pair_set& operator=(pair_set&&) noexcept = default;
+		constexpr ~pair_set() noexcept = default;
+
+		static constexpr u64 make(const u32 key, const u32 value) noexcept { return (static_cast<u64>(key) << 32) | value; }
+		static constexpr u32 key_of(const u64 pair) noexcept { return static_cast<u32>(pair >> 32); }
+		static constexpr u32 value_of(const u64 pair) noexcept { return static_cast<u32>(pair); }
+
+		constexpr size_t size() const noexcept { return pairs.size(); }
+		constexpr bool empty() const noexcept { return pairs.empty(); }
+		constexpr const lazy_vector<u64>& all() const noexcept { return pairs; }
+
+		bool contains(const u32 key, const u32 value) const noexcept { return std::binary_search(pairs.begin(), pairs.end(), make(key, value)); }
+		// The pairs of key, sorted by value. Empty if none.
+		std::span<const u64> block(const u32 key) const noexcept;
+		// Sets bit i of bits if (key, values[i]) is in, clears it otherwise. bits must hold (count + 63) / 64 words. Bits past count are cleared.
+		void contains_each(const u32 key, const u32* values, const size_t count, u64* bits) const noexcept;
+
+		// False only if it wasn't in and there was no memory to add it
+		bool insert(const u32 key, const u32 value) noexcept;
+		// False if it wasn't in
+		bool erase(const u32 key, const u32 value) noexcept;
+		// Erases the blocks of keys pred(key) is true for, calling it once per key. Returns how many keys.
+		template<typename Pred>
+		size_t erase_keys_if(Pred&& pred) noexcept {
+			size_t erased = 0;
+			u64* out = pairs.begin();
+			for (const u64* it = pairs.begin(), *end = pairs.end(); it != end;) {
+				const u32 key = key_of(*it);
+				const u64* block_end = it;
+				for (; (block_end != end) and (key_of(*block_end) == key); ++block_end) { ; }
+				if (pred(key)) {
+					++erased;
+				} else {
+					out = std::copy(it, block_end, out);
+				}
+				it = block_end;
+			}
+			(void)pairs.resize(static_cast<size_t>(out - pairs.begin())); // Shrinking can't fail
+			return erased;
+		}
+		// Calls fn(key, block) for every key, in order
+		template<typename Fn>
+		void for_each_block(Fn&& fn) const noexcept {
+			for (const u64* it = pairs.begin(), *end = pairs.end(); it != end;) {
+				const u32 key = key_of(*it);
+				const u64* block_end = it;
+				for (; (block_end != end) and (key_of(*block_end) == key); ++block_end) { ; }
+				fn(key, std::span<const u64>{ it, block_end });
+				it = block_end;
+			}
+		}
+		size_t key_count() const noexcept;
+
+		// Takes unsorted pairs, duplicates and all
+		void assign(lazy_vector<u64>&& unsorted) noexcept;
+		constexpr void clear() noexcept { pairs.clear(); }
+
+	private:
+		lazy_vector<u64> pairs{};
+	};
+
+}
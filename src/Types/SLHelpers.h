@@ -15,9 +15,9 @@ namespace SLHelpers {
 	struct sslThreadController_interface {
 	private:
 		struct flags32 {
-			__forceinline constexpr void set(const u32 i) noexcept { f |= static_cast<u32>(1 << i); }
-			[[nodiscard]] __forceinline constexpr bool operator[](const u32 i) const noexcept { return (f >> i) & 1; }
-			__forceinline constexpr void clear() noexcept { f = 0; }
+			FORCEINLINE constexpr void set(const u32 i) noexcept { f |= static_cast<u32>(1 << i); }
+			[[nodiscard]] FORCEINLINE constexpr bool operator[](const u32 i) const noexcept { return (f >> i) & 1; }
+			FORCEINLINE constexpr void clear() noexcept { f = 0; }
 		private:
 			u32 f{ 0 };
 		};
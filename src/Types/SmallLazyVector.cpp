@@ -0,0 +1,5 @@
+#include "SmallLazyVector.h"
+
+namespace LazyVector {
+	
+}
@@ -0,0 +1,177 @@
+#pragma once
+#include "Common.h"
+
+namespace LazyVector {
+
+	// lazy_vector-like container that keeps up to N elements inline, and only allocates once it grows past that.
+	// Meant for short-lived buffers on hot paths (eg keyword copies on equip events) whose size is almost always small and bounded.
+	// Only for trivially copyable and trivially default constructible T, so everything is memcpy/memset and nothing ever needs constructing or destroying.
+	// Same unchecked interface as lazy_vector: reserve()/try_append() can fail (return false), append() assumes capacity.
+	template<typename T, size_t N>
+	requires (
+		(N > 0)
+		and std::is_trivially_copyable_v<T>
+		and std::is_trivially_default_constructible_v<T>)
+	class small_lazy_vector {
+	private:
+		static constexpr size_t Bytes = sizeof(T);
+
+	public:
+		using size_type = size_t;
+		using value_type = T;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+
+		static constexpr size_t InlineCapacity = N;
+
+		constexpr small_lazy_vector() noexcept = default;
+		constexpr small_lazy_vector(const small_lazy_vector& other) noexcept {
+			if (!try_append_range_copy(other.begin(), other.size())) {
+				SKSE::stl::report_and_fail("out of memory"sv);
+			}
+		}
+		constexpr small_lazy_vector(small_lazy_vector&& other) noexcept { steal(other); }
+		constexpr small_lazy_vector& operator=(const small_lazy_vector& rhs) noexcept {
+			if (this != std::addressof(rhs)) {
+				clear();
+				if (!try_append_range_copy(rhs.begin(), rhs.size())) {
+					SKSE::stl::report_and_fail("out of memory"sv);
+				}
+			}
+			return *this;
+		}
+		constexpr small_lazy_vector& operator=(small_lazy_vector&& rhs) noexcept {
+			if (this != std::addressof(rhs)) {
+				free_self();
+				steal(rhs);
+			}
+			return *this;
+		}
+		constexpr ~small_lazy_vector() noexcept { free_self(); }
+
+		constexpr small_lazy_vector(const T* init_data, const size_t init_size) noexcept {
+			if (!try_append_range_copy(init_data, init_size)) {
+				SKSE::stl::report_and_fail("out of memory"sv);
+			}
+		}
+
+
+		constexpr size_t capacity() const noexcept { return alloc_sentinel - arr_first; }
+		constexpr size_t size() const noexcept { return arr_sentinel - arr_first; }
+		constexpr bool empty() const noexcept { return arr_first == arr_sentinel; }
+		constexpr bool is_inline() const noexcept { return arr_first == local; }
+
+		constexpr T* data() noexcept { return arr_first; }
+		constexpr const T* data() const noexcept { return arr_first; }
+
+		constexpr T& operator[](const size_t index) noexcept { return arr_first[index]; }
+		constexpr const T& operator[](const size_t index) const noexcept { return arr_first[index]; }
+
+		constexpr T& front() noexcept { return *arr_first; }
+		constexpr const T& front() const noexcept { return *arr_first; }
+		constexpr T& back() noexcept { return *(arr_sentinel - 1); }
+		constexpr const T& back() const noexcept { return *(arr_sentinel - 1); }
+
+		constexpr T* begin() noexcept { return arr_first; }
+		constexpr const T* begin() const noexcept { return arr_first; }
+		constexpr T* end() noexcept { return arr_sentinel; }
+		constexpr const T* end() const noexcept { return arr_sentinel; }
+
+
+		template<typename U>
+		constexpr T* find(const U& val) const noexcept {
+			T* it = arr_first;
+			for (; (it != arr_sentinel) and (*it != val); ++it) { ; }
+			return it;
+		}
+		template<typename U>
+		constexpr bool contains(const U& val) const noexcept { return find(val) != arr_sentinel; }
+
+
+		constexpr bool reserve(const size_t newcapacity) noexcept {
+			return (newcapacity <= capacity()) or expand(newcapacity);
+		}
+		constexpr bool resize(const size_t newsize) noexcept {
+			const size_t oldsize = size();
+			if ((newsize > oldsize) and !reserve(newsize)) {
+				return false;
+			}
+			if (newsize > oldsize) {
+				std::memset(arr_first + oldsize, 0, (newsize - oldsize) * Bytes);
+			}
+			arr_sentinel = arr_first + newsize;
+			return true;
+		}
+
+		// No boundchecks
+		template<typename... Args>
+		constexpr void append(Args&&... args) noexcept { std::construct_at(arr_sentinel++, std::forward<Args>(args)...); }
+		template<typename... Args>
+		constexpr bool try_append(Args&&... args) noexcept {
+			if ((arr_sentinel != alloc_sentinel) or expand(capacity() + 1)) {
+				append(std::forward<Args>(args)...);
+				return true;
+			}
+			return false;
+		}
+		constexpr bool try_append_range_copy(const T* first, const size_t count) noexcept {
+			if ((count == 0) or !reserve(size() + count)) {
+				return count == 0;
+			}
+			std::memcpy(arr_sentinel, first, count * Bytes);
+			arr_sentinel += count;
+			return true;
+		}
+
+		constexpr void pop_back() noexcept { --arr_sentinel; }
+		constexpr void erase(const size_t pos) noexcept { arr_first[pos] = *(--arr_sentinel); } // Unordered, like lazy_vector::erase()
+		constexpr void clear() noexcept { arr_sentinel = arr_first; } // Keeps any heap memory
+
+
+	private:
+		T local[N];
+		T* arr_first{ local };
+		T* arr_sentinel{ local };
+		T* alloc_sentinel{ local + N };
+
+		constexpr bool expand(const size_t needed_elem_count) noexcept {
+			const size_t new_cap = std::bit_ceil(needed_elem_count);
+			T* newloc = static_cast<T*>(Portable::aligned_malloc(new_cap * Bytes, alignof(T)));
+			if (!newloc) {
+				return false;
+			}
+			const size_t cursize = size();
+			std::memcpy(newloc, arr_first, cursize * Bytes);
+			free_self();
+			arr_first = newloc;
+			arr_sentinel = newloc + cursize;
+			alloc_sentinel = newloc + new_cap;
+			return true;
+		}
+		constexpr void free_self() noexcept {
+			if (!is_inline()) {
+				Portable::aligned_free(arr_first);
+			}
+			arr_first = local;
+			arr_sentinel = local;
+			alloc_sentinel = local + N;
+		}
+		constexpr void steal(small_lazy_vector& other) noexcept {
+			if (other.is_inline()) {
+				const size_t count = other.size();
+				std::memcpy(local, other.local, count * Bytes);
+				arr_sentinel = local + count;
+			} else { // Take the heap block, leave other empty and inline
+				arr_first = other.arr_first;
+				arr_sentinel = other.arr_sentinel;
+				alloc_sentinel = other.alloc_sentinel;
+				other.arr_first = other.local;
+			}
+			other.arr_sentinel = other.arr_first;
+			other.alloc_sentinel = other.local + N;
+		}
+	};
+
+}
@@ -3,6 +3,93 @@
 
 namespace SyncTypes {
 
+	u32 worker_pool::resize(const u32 count) noexcept {
+		const u32 wanted = std::min<u32>(count, MaxWorkers);
+		if (wanted < threads.size()) {
+			{
+				std::lock_guard lock{ mtx };
+				stopping = true;
+			}
+			wake.notify_all();
+			for (auto& thread : threads) {
+				thread.join();
+			}
+			threads.clear();
+			stopping = false;
+		}
+		try {
+			threads.reserve(wanted);
+			while (threads.size() < wanted) {
+				threads.emplace_back(&worker_pool::work, this);
+			}
+		} catch (...) {
+			Log::Error("worker_pool::resize: only {} of {} threads started!"sv, threads.size(), wanted);
+		}
+		return size();
+	}
+
+	void worker_pool::run_erased(const u32 count, const u32 granularity, void* ctx, const job_fn fn) noexcept {
+		const u32 parts = size() + 1;
+		const u32 per_part = (count + (parts - 1)) / parts;
+		const u32 grain = std::max<u32>(granularity, 1);
+		const u32 chunk_len = std::max<u32>(((per_part + (grain - 1)) / grain) * grain, grain);
+		if ((parts == 1) or (count <= chunk_len)) {
+			fn(ctx, 0, count); // Not worth waking anyone
+			return;
+		}
+		{
+			std::unique_lock lock{ mtx };
+			idle.wait(lock, [this] { return active == 0; }); // Stragglers of the last run, which found nothing left but may still be reading the job
+			job_ctx = ctx;
+			job = fn;
+			job_count = count;
+			chunk = chunk_len;
+			chunk_count = (count + (chunk_len - 1)) / chunk_len;
+			next_chunk.store(0, std::memory_order_relaxed);
+			pending.store(chunk_count, std::memory_order_relaxed);
+			++generation;
+		}
+		wake.notify_all();
+		drain();
+		std::unique_lock lock{ mtx };
+		idle.wait(lock, [this] { return (pending.load(std::memory_order_acquire) == 0) and (active == 0); });
+	}
+
+	void worker_pool::drain() noexcept {
+		for (u32 c; (c = next_chunk.fetch_add(1, std::memory_order_relaxed)) < chunk_count;) {
+			const u32 begin = c * chunk;
+			job(job_ctx, begin, std::min(begin + chunk, job_count));
+			if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				std::lock_guard lock{ mtx };
+				idle.notify_all();
+			}
+		}
+	}
+
+	void worker_pool::work() noexcept {
+		u64 seen = 0;
+		{
+			std::lock_guard lock{ mtx };
+			seen = generation; // Only runs started after this one exists
+		}
+		for (;;) {
+			{
+				std::unique_lock lock{ mtx };
+				wake.wait(lock, [this, seen] { return stopping or (generation != seen); });
+				if (stopping) {
+					return;
+				}
+				seen = generation;
+				++active;
+			}
+			drain();
+			{
+				std::lock_guard lock{ mtx };
+				--active;
+			}
+			idle.notify_all();
+		}
+	}
 
 }
 
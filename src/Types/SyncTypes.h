@@ -1,8 +1,8 @@
 #pragma once
 #include "Common.h"
 #include "Logger.h"
-#include <intrin.h>
-#pragma intrinsic(_mm_pause)
+#include <condition_variable>
+#include <thread>
 
 namespace SyncTypes {
 	using mo = std::memory_order;
@@ -53,7 +53,7 @@ namespace SyncTypes {
 					return; // Previous value was false. Got the lock.
 				}
 				do {
-					_mm_pause();  // Noop without SSE2 (released in 2000).
+					Portable::pause();  // Noop without SSE2 (released in 2000).
 				} while (locked.load(mo::relaxed)); // This needn't protect anything, so use relaxed.
 			}
 		}
@@ -68,7 +68,7 @@ namespace SyncTypes {
 						return true;
 					}
 					do {
-						_mm_pause();
+						Portable::pause();
 						if (steady_clock::now() >= cutoff) {
 							return false;
 						}
@@ -100,7 +100,7 @@ namespace SyncTypes {
 					return;
 				}
 				do {
-					_mm_pause();
+					Portable::pause();
 				} while (locked.load(mo::relaxed) != Unlocked);
 			}
 		}
@@ -115,7 +115,7 @@ namespace SyncTypes {
 					return; // Changed it from Unlocked to 1, so we done.
 				}
 				while (expected >= MaxReaders) { // Spin-load if locking failed because not lockable. Skip and go straight to CAS with corrected values otherwise.
-					_mm_pause();
+					Portable::pause();
 					expected = locked.load(mo::relaxed);
 				}
 				desired = expected + 1; // Here, expected represents a lockable state (< MaxReaders which implies != Writing)
@@ -127,6 +127,174 @@ namespace SyncTypes {
 	};
 	static_assert(sizeof(shared_spinlock) == 4);
 
+	// shared_spinlock that stops admitting new readers as soon as a writer is waiting, so a writer only ever waits for the readers already in.
+	// Readers can't starve a writer this way, however steady their stream. Writers only compete among themselves.
+	class writer_preferring_spinlock {
+		using lock_t = u32;
+		enum : lock_t {
+			Unlocked = 0,
+			Writing = 1u << 31,
+			WriterPending = 1u << 30,
+			ReaderMask = WriterPending - 1,
+			MaxReaders = ReaderMask
+		};
+
+		std::atomic<lock_t> locked{ 0 };
+		static_assert(decltype(locked)::is_always_lock_free, "writer_preferring_spinlock lock implementation is not always lock-free, so probably just use a shared mutex");
+	public:
+		void lock() noexcept {
+			lock_t state = locked.load(mo::relaxed);
+			for (;;) {
+				if ((state & (Writing | ReaderMask)) == 0) { // Nobody in. Take it, which also clears the pending flag. Other waiting writers set it again.
+					if (locked.compare_exchange_weak(state, Writing, mo::acquire, mo::relaxed)) {
+						return;
+					}
+					continue; // state reloaded by CAS
+				}
+				if ((state & WriterPending) == 0) {
+					state = locked.fetch_or(WriterPending, mo::relaxed) | WriterPending; // Close the door to new readers
+				}
+				Portable::pause();
+				state = locked.load(mo::relaxed);
+			}
+		}
+		void unlock() noexcept {
+			locked.fetch_and(~Writing, mo::release); // Keep the pending flag other writers may have set meanwhile
+		}
+
+		void lock_shared() noexcept {
+			lock_t state = locked.load(mo::relaxed);
+			for (;;) {
+				if ((state & (Writing | WriterPending)) == 0 and ((state & ReaderMask) < MaxReaders)) {
+					if (locked.compare_exchange_weak(state, state + 1, mo::acquire, mo::relaxed)) {
+						return;
+					}
+					continue; // state reloaded by CAS
+				}
+				Portable::pause();
+				state = locked.load(mo::relaxed);
+			}
+		}
+		void unlock_shared() noexcept {
+			locked.fetch_sub(1, mo::release); // UB if not having lock_shared() previously
+		}
+	};
+	static_assert(sizeof(writer_preferring_spinlock) == 4);
+
+	// Bounded lock-free queue for many producers and one consumer (Vyukov's sequenced ring).
+	// try_push() fails instead of waiting when full, and try_pop() fails if the oldest element is empty or still being written.
+	// Only one thread at a time may pop, eg by only popping under some exclusive lock.
+	template<typename T, u32 Capacity>
+	requires (std::is_trivially_copyable_v<T> and std::has_single_bit(Capacity))
+	class mpsc_ring {
+	public:
+		mpsc_ring() noexcept {
+			for (u32 i = 0; i < Capacity; ++i) {
+				cells[i].seq.store(i, mo::relaxed);
+			}
+		}
+		mpsc_ring(const mpsc_ring&) = delete;
+		mpsc_ring(mpsc_ring&&) = delete;
+		mpsc_ring& operator=(const mpsc_ring&) = delete;
+		mpsc_ring& operator=(mpsc_ring&&) = delete;
+
+		[[nodiscard]] bool try_push(const T& val) noexcept {
+			u32 pos = tail.load(mo::relaxed);
+			for (;;) {
+				cell& c = cells[pos & Mask];
+				const i32 diff = static_cast<i32>(c.seq.load(mo::acquire) - pos);
+				if (diff == 0) { // Free for this pos. Claim it.
+					if (tail.compare_exchange_weak(pos, pos + 1, mo::relaxed, mo::relaxed)) {
+						c.value = val;
+						c.seq.store(pos + 1, mo::release); // Publish
+						return true;
+					}
+				} else if (diff < 0) {
+					return false; // Full. The consumer hasn't gotten to this cell yet.
+				} else {
+					pos = tail.load(mo::relaxed); // Another producer claimed it
+				}
+			}
+		}
+
+		[[nodiscard]] bool try_pop(T& out) noexcept {
+			const u32 pos = head.load(mo::relaxed);
+			cell& c = cells[pos & Mask];
+			if (static_cast<i32>(c.seq.load(mo::acquire) - (pos + 1)) < 0) {
+				return false;
+			}
+			out = c.value;
+			c.seq.store(pos + Capacity, mo::release); // Free for the producer one lap ahead
+			head.store(pos + 1, mo::relaxed);
+			return true;
+		}
+
+		// Only a hint unless called by the consumer
+		bool empty() const noexcept { return tail.load(mo::relaxed) == head.load(mo::relaxed); }
+
+	private:
+		static constexpr u32 Mask = Capacity - 1;
+
+		struct cell {
+			std::atomic<u32> seq;
+			T value;
+		};
+
+		array<cell, Capacity> cells;
+		std::atomic<u32> tail{ 0 };	// Next pos to push to
+		char pad[64 - sizeof(std::atomic<u32>)];	// Keep producers' and consumer's positions in separate cachelines. Padding by hand because alignas() padding warns.
+		std::atomic<u32> head{ 0 };	// Next pos to pop from. Only the consumer writes it.
+	};
+
+
+	// A few threads that split index ranges with the calling thread. run() hands out chunks of [0, count) until none are left and returns once all are done.
+	// Chunks are a multiple of some granularity long, so callers can keep SIMD blocks or cachelines whole. For one caller at a time.
+	class worker_pool {
+	public:
+		enum : u32 { MaxWorkers = 7 };
+
+		worker_pool() noexcept = default;
+		worker_pool(const worker_pool&) = delete;
+		worker_pool(worker_pool&&) = delete;
+		worker_pool& operator=(const worker_pool&) = delete;
+		worker_pool& operator=(worker_pool&&) = delete;
+		~worker_pool() noexcept { resize(0); }
+
+		// Starts or joins threads so there are count of them, up to MaxWorkers. Not during run(). Returns the new count, less than asked if threads failed to start.
+		u32 resize(const u32 count) noexcept;
+		u32 size() const noexcept { return static_cast<u32>(threads.size()); }
+
+		template<typename Fn>
+		void run(const u32 count, const u32 granularity, Fn&& fn) noexcept {
+			run_erased(count, granularity, &fn, [](void* ctx, const u32 begin, const u32 end) { (*static_cast<std::remove_reference_t<Fn>*>(ctx))(begin, end); });
+		}
+
+	private:
+		using job_fn = void(*)(void*, u32, u32);
+
+		void run_erased(const u32 count, const u32 granularity, void* ctx, const job_fn fn) noexcept;
+		void drain() noexcept;
+		void work() noexcept;
+
+		// Workers only touch the job while counted in active, and run_erased() only changes it while none are
+		std::mutex mtx{};
+		std::condition_variable wake{};
+		std::condition_variable idle{};
+		vector<std::thread> threads{};
+		u64 generation{ 0 };
+		u32 active{ 0 };
+		bool stopping{ false };
+
+		void* job_ctx{ nullptr };
+		job_fn job{ nullptr };
+		u32 job_count{ 0 };
+		u32 chunk{ 0 };
+		u32 chunk_count{ 0 };
+		std::atomic<u32> next_chunk{ 0 };
+		std::atomic<u32> pending{ 0 };
+	};
+
+
 	template<typename Lock_T>
 	concept SharedLock = requires(Lock_T lock) {
 		{ lock.lock() } -> std::convertible_to<void>;
@@ -188,7 +356,7 @@ namespace SyncTypes {
 		LockedAccessor<false> GetShared() noexcept { return LockedAccessor<false>{ data_and_lock.data, data_and_lock.lock }; }
 	};
 
-	template<typename payload_t, SharedLock lock_t = shared_spinlock>
+	template<typename payload_t, SharedLock lock_t = writer_preferring_spinlock>
 	class LockProtectedResource {
 	public:
 		// Lock is taken/released with RAII
@@ -0,0 +1,37 @@
+#include "Timing.h"
+
+namespace Timing {
+
+	void latency_histogram::reset() noexcept {
+		for (auto& b : buckets) {
+			b.store(0, std::memory_order_relaxed);
+		}
+		samples.store(0, std::memory_order_relaxed);
+		total_ns.store(0, std::memory_order_relaxed);
+		max_ns.store(0, std::memory_order_relaxed);
+	}
+
+	microseconds latency_histogram::bucket_upper(const u32 idx) const noexcept {
+		if (idx >= (BucketCount - 1)) {
+			return std::chrono::ceil<microseconds>(max());
+		}
+		return microseconds{ i64{ 1 } << idx };
+	}
+
+	microseconds latency_histogram::quantile_upper(const double q) const noexcept {
+		const u64 n = count();
+		if (n == 0) {
+			return 0us;
+		}
+		const u64 wanted = std::max<u64>(static_cast<u64>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(n))), 1);
+		u64 seen = 0;
+		for (u32 idx = 0; idx < BucketCount; ++idx) {
+			seen += bucket(idx);
+			if (seen >= wanted) {
+				return bucket_upper(idx);
+			}
+		}
+		return bucket_upper(BucketCount - 1); // Counts moved while summing
+	}
+
+}
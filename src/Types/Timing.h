@@ -0,0 +1,72 @@
+#pragma once
+#include "Common.h"
+#include <chrono>
+
+namespace Timing {
+	using clock = std::chrono::steady_clock;
+	using std::chrono::nanoseconds;
+	using std::chrono::microseconds;
+
+	// Latency histogram with power of 2 microsecond buckets: [0, 1), [1, 2), [2, 4), ..., and everything from 2^(BucketCount - 2) up in the last one.
+	// Recording is a few relaxed atomic adds, so any thread can record and read at any time. Readers may see a record half done, which is fine for stats.
+	class latency_histogram {
+	public:
+		enum : u32 { BucketCount = 20 }; // Last bucket starts at ~262ms
+
+		latency_histogram() noexcept = default;
+		latency_histogram(const latency_histogram&) = delete;
+		latency_histogram& operator=(const latency_histogram&) = delete;
+
+		void record(const nanoseconds elapsed) noexcept {
+			const u64 ns = static_cast<u64>(std::max<nanoseconds::rep>(elapsed.count(), 0));
+			buckets[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+			samples.fetch_add(1, std::memory_order_relaxed);
+			total_ns.fetch_add(ns, std::memory_order_relaxed);
+			for (u64 old = max_ns.load(std::memory_order_relaxed); (ns > old) and !max_ns.compare_exchange_weak(old, ns, std::memory_order_relaxed);) { ; }
+		}
+		void reset() noexcept;
+
+		u64 count() const noexcept { return samples.load(std::memory_order_relaxed); }
+		u64 bucket(const u32 idx) const noexcept { return buckets[idx].load(std::memory_order_relaxed); }
+		nanoseconds total() const noexcept { return nanoseconds{ total_ns.load(std::memory_order_relaxed) }; }
+		nanoseconds max() const noexcept { return nanoseconds{ max_ns.load(std::memory_order_relaxed) }; }
+		nanoseconds average() const noexcept { const u64 n = count(); return (n != 0) ? (total() / static_cast<nanoseconds::rep>(n)) : 0ns; }
+
+		// Exclusive upper bound of a bucket. The last one has none, so gives max().
+		microseconds bucket_upper(const u32 idx) const noexcept;
+		// Upper bound of the bucket the q-quantile (0 to 1) falls in. 0 if empty.
+		microseconds quantile_upper(const double q) const noexcept;
+
+	private:
+		array<std::atomic<u64>, BucketCount> buckets{};
+		std::atomic<u64> samples{ 0 };
+		std::atomic<u64> total_ns{ 0 };
+		std::atomic<u64> max_ns{ 0 };
+
+		static constexpr u32 bucket_of(const u64 ns) noexcept {
+			const u64 us = ns / 1000;
+			return (us == 0) ? 0 : std::min<u32>(static_cast<u32>(std::bit_width(us)), BucketCount - 1);
+		}
+	};
+
+	// Records the time from construction to destruction into a histogram, and also adds it to a running total if given one.
+	class scoped_span {
+	public:
+		explicit scoped_span(latency_histogram& hist, std::atomic<u64>* running_total_ns = nullptr) noexcept : histogram{ hist }, running_total{ running_total_ns }, start{ clock::now() } {}
+		scoped_span(const scoped_span&) = delete;
+		scoped_span& operator=(const scoped_span&) = delete;
+		~scoped_span() noexcept {
+			const nanoseconds elapsed = clock::now() - start;
+			histogram.record(elapsed);
+			if (running_total) {
+				running_total->fetch_add(static_cast<u64>(elapsed.count()), std::memory_order_relaxed);
+			}
+		}
+
+	private:
+		latency_histogram& histogram;
+		std::atomic<u64>* running_total;
+		const clock::time_point start;
+	};
+
+}
@@ -11,7 +11,7 @@ namespace GameDataUtils {
 	lazy_vector<RE::ActorPtr> GetHighActors(const SkipFlags flags) noexcept {
 		if (const RE::ProcessLists* lists = RE::ProcessLists::GetSingleton(); lists) {
 			lazy_vector<RE::ActorPtr> result{};
-			if (!result.reserve(1ui64 + lists->highActorHandles.size())) {
+			if (!result.reserve(1ull + lists->highActorHandles.size())) {
 				return {};
 			}
 			result.append(RE::PlayerCharacter::GetSingleton());
@@ -34,7 +34,7 @@ namespace GameDataUtils {
 	lazy_vector<RE::ActorPtr> GetHighValidActors() noexcept {
 		if (const RE::ProcessLists* lists = RE::ProcessLists::GetSingleton(); lists) {
 			lazy_vector<RE::ActorPtr> result{};
-			if (!result.reserve(1ui64 + lists->highActorHandles.size())) {
+			if (!result.reserve(1ull + lists->highActorHandles.size())) {
 				return {};
 			}
 			result.append(RE::PlayerCharacter::GetSingleton());
@@ -99,6 +99,10 @@ namespace GameDataUtils {
 		spell->effects[index]->baseEffect->magicItemDescription = desc;
 		return true;
 	}
+	bool SetNthEffectDescription(RE::SpellItem* spell, const u32 index, const char* desc) noexcept {
+		spell->effects[index]->baseEffect->magicItemDescription = desc;
+		return true;
+	}
 
 	void SetNthEffectMagnitude(RE::SpellItem* spell, const u32 index, const float mag) noexcept { spell->effects[index]->effectItem.magnitude = mag; }
 	void SetEffectsMagnitude(RE::SpellItem* spell, const u32 idx_first, const u32 idx_last, const float mag) noexcept {
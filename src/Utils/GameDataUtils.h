@@ -47,6 +47,7 @@ namespace GameDataUtils {
 	bool DispelSpell(RE::Actor* act, RE::SpellItem* spell) noexcept;
 	// Expects valid spell, index, and targeted baseEffect
 	bool SetNthEffectDescription(RE::SpellItem* spell, const u32 index, const string& desc) noexcept;
+	bool SetNthEffectDescription(RE::SpellItem* spell, const u32 index, const char* desc) noexcept;
 	// Expects valid spell, index, and targeted effectItem
 	void SetNthEffectMagnitude(RE::SpellItem* spell, const u32 index, const float mag) noexcept;
 	// Expects valid spell, indices [idx_first, idx_last], and targeted effectItems
@@ -51,7 +51,7 @@ namespace MenuUtils {
 			switch (menucode) {
 			case menu_closed: menu_checker.store(CheckMenuClosed, std::memory_order_relaxed); break;
 			case menu_opened: menu_checker.store(CheckMenuOpened, std::memory_order_relaxed); break;
-			default: __assume(0);
+			default: std::unreachable();
 			}
 			return true;
 		}
@@ -112,7 +112,7 @@ namespace MenuUtils {
 
 			case evmmbbl_frame: modevent_checker.store(CheckEVMMBBLFrame, std::memory_order_relaxed); break;
 			case evmmbbl_result: modevent_checker.store(CheckEVMMBBLClosed, std::memory_order_relaxed); break;
-			default: __assume(0);
+			default: std::unreachable();
 			}
 			return true;
 		}
@@ -48,10 +48,10 @@ namespace MenuUtils {
 		constexpr slider_params& operator=(const string& init) { val = init; return *this; }
 		constexpr slider_params& operator=(string&& init) noexcept { val = std::move(init); return *this; }
 
-		constexpr slider_params(const values& init)
+		slider_params(const values& init) // Not constexpr, since to_string() isn't
 			: val("||"+init.text+"||"+init.info+"||"+to_string(init.min)+"||"+to_string(init.max)+"||"+to_string(init.start)+"||"+to_string(init.step)+"||"+to_string(init.decimals))
 		{}
-		constexpr slider_params& operator=(const values & init) {
+		slider_params& operator=(const values & init) {
 			val = ("||"+init.text+"||"+init.info+"||"+to_string(init.min)+"||"+to_string(init.max)+"||"+to_string(init.start)+"||"+to_string(init.step)+"||"+to_string(init.decimals));
 			return *this;
 		}
@@ -1,5 +1,6 @@
 #pragma once
 #include "Common.h"
+#include <immintrin.h> // SSE2 is always there on x64. AVX2 paths are only compiled in with /arch:AVX2 (__AVX2__).
 
 
 namespace PrimitiveUtils {
@@ -20,18 +21,59 @@ namespace PrimitiveUtils {
 
 	// Returns std::numeric_limits<T>::max() (all bits 1) if flag == true, and 0 otherwise
 	template<typename T = u8> requires (std::unsigned_integral<T>)
-	__forceinline constexpr T bool_extend(const bool flag) noexcept {
+	FORCEINLINE constexpr T bool_extend(const bool flag) noexcept {
 		// Could use flag as index to static array, or unsigned shift LSB to MSB then signed shift MSB to LSB to sign-extend, or just cast and negate
 		// Array is by far the slowest. Shifts is 3 instructions (movzx, shr, sal). Negation is 2 (movzx, neg).
 		return 0 - static_cast<T>(flag); // Defined underflow. 1 (true) becomes 255 (1 under 0), 0 (false) stays 0
 	}
 
 	// Returns val if flag == true, and 32 unset bits otherwise (= 0.0f if IEEE754, which MSVC guarantees).
-	[[nodiscard]] __forceinline constexpr float mask_float(const float val, const bool flag) noexcept {
+	[[nodiscard]] FORCEINLINE constexpr float mask_float(const float val, const bool flag) noexcept {
 		return std::bit_cast<float>(std::bit_cast<u32>(val) & bool_extend<u32>(flag));
 	}
 	
 
+	// Returns a pointer to the first element in [first, last) equal to val, or last. Compares 4 (SSE2) or 8 (AVX2) keys per instruction, 4 vectors per iteration, and finishes with a scalar tail.
+	[[nodiscard]] inline const u32* find_u32(const u32* first, const u32* const last, const u32 val) noexcept {
+#if defined(__AVX2__)
+		using vec = __m256i;
+		enum : ptrdiff_t { Lanes = 8 };
+		const vec key = _mm256_set1_epi32(static_cast<int>(val));
+		auto load = [](const u32* p) { return _mm256_loadu_si256(reinterpret_cast<const vec*>(p)); };
+		auto cmpeq = [&key](const vec v) { return _mm256_cmpeq_epi32(v, key); };
+		auto bits = [](const vec v) { return static_cast<u32>(_mm256_movemask_ps(_mm256_castsi256_ps(v))); };
+		auto either = [](const vec a, const vec b) { return _mm256_or_si256(a, b); };
+#else
+		using vec = __m128i;
+		enum : ptrdiff_t { Lanes = 4 };
+		const vec key = _mm_set1_epi32(static_cast<int>(val));
+		auto load = [](const u32* p) { return _mm_loadu_si128(reinterpret_cast<const vec*>(p)); };
+		auto cmpeq = [&key](const vec v) { return _mm_cmpeq_epi32(v, key); };
+		auto bits = [](const vec v) { return static_cast<u32>(_mm_movemask_ps(_mm_castsi128_ps(v))); };
+		auto either = [](const vec a, const vec b) { return _mm_or_si128(a, b); };
+#endif
+		for (; (last - first) >= (Lanes * 4); first += (Lanes * 4)) {
+			const vec eq0 = cmpeq(load(first));
+			const vec eq1 = cmpeq(load(first + Lanes));
+			const vec eq2 = cmpeq(load(first + (Lanes * 2)));
+			const vec eq3 = cmpeq(load(first + (Lanes * 3)));
+			if (bits(either(either(eq0, eq1), either(eq2, eq3))) != 0) { // Rare, so only now figure out which one hit
+				if (const u32 m = bits(eq0); m != 0) { return first + std::countr_zero(m); }
+				if (const u32 m = bits(eq1); m != 0) { return first + Lanes + std::countr_zero(m); }
+				if (const u32 m = bits(eq2); m != 0) { return first + (Lanes * 2) + std::countr_zero(m); }
+				return first + (Lanes * 3) + std::countr_zero(bits(eq3));
+			}
+		}
+		for (; (last - first) >= Lanes; first += Lanes) {
+			if (const u32 m = bits(cmpeq(load(first))); m != 0) {
+				return first + std::countr_zero(m);
+			}
+		}
+		for (; (first != last) and (*first != val); ++first) { ; }
+		return first;
+	}
+	
+
 	// Number to number functions perform clamping where necessary to avoid overflow/underflow. eg S23ToS8 with input 200 will return 127 which is the i8 max.
 	constexpr i64		to_s64(u64 num)	noexcept { return static_cast<i64>	(std::clamp<u64>(num, 0u, LLONG_MAX)); }
 	constexpr u32	to_u32(u64 num)	noexcept { return static_cast<u32>	(std::clamp<u64>(num, 0u, UINT_MAX)); }
@@ -74,8 +74,8 @@ namespace RNG {
 		constexpr float nextf(const float min, const float max) noexcept { return min + (nextf01() * (max - min)); }
 
 	private:
-		__forceinline constexpr u32 next_z() noexcept { return (z = 36969 * (z & 65535) + (z >> 16)); }
-		__forceinline constexpr u32 next_w() noexcept { return (w = 18000 * (w & 65535) + (w >> 16)); }
+		FORCEINLINE constexpr u32 next_z() noexcept { return (z = 36969 * (z & 65535) + (z >> 16)); }
+		FORCEINLINE constexpr u32 next_w() noexcept { return (w = 18000 * (w & 65535) + (w >> 16)); }
 
 		u32 z{}; // Marsaglia defaults: z{ 362436069 }, w{ 521288629 }
 		u32 w{};
@@ -130,7 +130,7 @@ namespace RNG {
 		constexpr float nextf(const float min, const float max) noexcept { return min + (nextf01() * (max - min)); }
 
 	private:
-		__forceinline static constexpr u32 rotl(const u32 x, const u32 k) noexcept { return (x << k) | (x >> (32ui32 - k)); }
+		FORCEINLINE static constexpr u32 rotl(const u32 x, const u32 k) noexcept { return (x << k) | (x >> (32u - k)); }
 
 		u32 s0{};
 		u32 s1{};
@@ -187,7 +187,7 @@ namespace RNG {
 		constexpr float nextf(const float min, const float max) noexcept { return min + (nextf01() * (max - min)); }
 
 	private:
-		__forceinline static constexpr u32 rotl(const u32 x, const u32 k) noexcept { return (x << k) | (x >> (32ui32 - k)); }
+		FORCEINLINE static constexpr u32 rotl(const u32 x, const u32 k) noexcept { return (x << k) | (x >> (32u - k)); }
 
 		u32 s0{};
 		u32 s1{};
@@ -342,5 +342,17 @@ namespace RNG {
 	}
 
 
+	// Stateless [0, 1) from a key and a counter (a splitmix64 finalizer over both). Gives each key its own stream without keeping any state, so draws don't depend on the order or thread they're made in.
+	constexpr float hashf01(const u32 key, const u32 counter) noexcept {
+		u64 x = (static_cast<u64>(key) << 32) | counter;
+		x ^= x >> 30;
+		x *= 0xBF58476D1CE4E5B9ull;
+		x ^= x >> 27;
+		x *= 0x94D049BB133111EBull;
+		x ^= x >> 31;
+		return std::bit_cast<float>(static_cast<u32>(sign_and_exponent | static_cast<u32>(x >> 41))) - 1.0f;
+	}
+
+
 
 }
@@ -2,4 +2,165 @@
 
 namespace SerializationUtils {
 
+	enum : u32 {
+		MinMatch = 4,
+		MaxOffset = 0xFFFF,
+		HashBits = 12,
+		NoPosition = 0xFFFF'FFFF
+	};
+
+	static FORCEINLINE u32 read32(const u8* src) noexcept {
+		u32 val;
+		std::memcpy(&val, src, sizeof(val));
+		return val;
+	}
+	static FORCEINLINE u32 hash(const u32 seq) noexcept { return (seq * 2654435761u) >> (32 - HashBits); }
+
+	// Lengths past a token's 15 go as bytes of 255 and a last one under 255
+	static bool put_length(u8*& out, const u8* end, size_t len) noexcept {
+		for (; len >= 255; len -= 255) {
+			if (out == end) {
+				return false;
+			}
+			*(out++) = 255;
+		}
+		if (out == end) {
+			return false;
+		}
+		*(out++) = static_cast<u8>(len);
+		return true;
+	}
+	static bool get_length(const u8*& in, const u8* end, size_t& len) noexcept {
+		u8 byte;
+		do {
+			if (in == end) {
+				return false;
+			}
+			byte = *(in++);
+			len += byte;
+		} while (byte == 255);
+		return true;
+	}
+
+
+	size_t Compress(const u8* src, const size_t size, u8* dst, const size_t capacity) noexcept {
+		if (size >= NoPosition) { // Positions are kept as u32
+			return 0;
+		}
+		array<u32, size_t{ 1 } << HashBits> table;
+		table.fill(NoPosition);
+
+		u8* out = dst;
+		const u8* const out_end = dst + capacity;
+		size_t anchor = 0; // First literal not written yet
+
+		// Literals from anchor to literal_end, then the match, if match_len isn't 0
+		const auto sequence = [&](const size_t literal_end, const size_t offset, const size_t match_len) noexcept {
+			const size_t literals = literal_end - anchor;
+			const size_t extra = (match_len != 0) ? (match_len - MinMatch) : 0;
+			if (out == out_end) {
+				return false;
+			}
+			*(out++) = static_cast<u8>((std::min<size_t>(literals, 15) << 4) | std::min<size_t>(extra, 15));
+			if ((literals >= 15) and !put_length(out, out_end, literals - 15)) {
+				return false;
+			}
+			if (literals > static_cast<size_t>(out_end - out)) {
+				return false;
+			}
+			if (literals != 0) {
+				std::memcpy(out, src + anchor, literals);
+				out += literals;
+			}
+			if (match_len != 0) {
+				if ((out_end - out) < 2) {
+					return false;
+				}
+				const u16 off = static_cast<u16>(offset);
+				std::memcpy(out, &off, sizeof(off));
+				out += sizeof(off);
+				if ((extra >= 15) and !put_length(out, out_end, extra - 15)) {
+					return false;
+				}
+			}
+			return true;
+		};
+
+		for (size_t pos = 0; (pos + MinMatch) <= size;) {
+			const u32 seq = read32(src + pos);
+			u32& slot = table[hash(seq)];
+			const u32 candidate = slot;
+			slot = static_cast<u32>(pos);
+			if ((candidate != NoPosition) and ((pos - candidate) <= MaxOffset) and (read32(src + candidate) == seq)) {
+				size_t len = MinMatch;
+				while (((pos + len) < size) and (src[candidate + len] == src[pos + len])) {
+					++len;
+				}
+				if (!sequence(pos, pos - candidate, len)) {
+					return 0;
+				}
+				pos += len;
+				anchor = pos;
+			} else {
+				++pos;
+			}
+		}
+		// The block always ends in literals only, maybe none
+		if (!sequence(size, 0, 0)) {
+			return 0;
+		}
+		return static_cast<size_t>(out - dst);
+	}
+
+	bool Decompress(const u8* src, const size_t compressed_size, u8* dst, const size_t size) noexcept {
+		const u8* in = src;
+		const u8* const in_end = src + compressed_size;
+		u8* out = dst;
+		u8* const out_end = dst + size;
+
+		while (in != in_end) {
+			const u8 token = *(in++);
+			size_t literals = token >> 4;
+			if ((literals == 15) and !get_length(in, in_end, literals)) {
+				return false;
+			}
+			if ((literals > static_cast<size_t>(in_end - in)) or (literals > static_cast<size_t>(out_end - out))) {
+				return false;
+			}
+			if (literals != 0) {
+				std::memcpy(out, in, literals);
+				in += literals;
+				out += literals;
+			}
+			if (out == out_end) {
+				return in == in_end; // The last sequence has no match
+			}
+
+			if ((in_end - in) < 2) {
+				return false;
+			}
+			u16 offset;
+			std::memcpy(&offset, in, sizeof(offset));
+			in += sizeof(offset);
+			size_t len = token & 0x0F;
+			if ((len == 15) and !get_length(in, in_end, len)) {
+				return false;
+			}
+			len += MinMatch;
+			if ((offset == 0) or (offset > static_cast<size_t>(out - dst)) or (len > static_cast<size_t>(out_end - out))) {
+				return false;
+			}
+			const u8* from = out - offset;
+			if (offset >= len) {
+				std::memcpy(out, from, len);
+			} else {
+				for (size_t i = 0; i < len; ++i) { // Overlapping, so repeats the last offset bytes
+					out[i] = from[i];
+				}
+			}
+			out += len;
+		}
+		return false;
+	}
+
 }
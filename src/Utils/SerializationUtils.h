@@ -4,21 +4,86 @@
 
 namespace SerializationUtils {
 
-	
-}
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
+	// Writes into a buffer sized beforehand. Stops writing and stays !ok() if it runs out of room.
+	class byte_writer {
+	public:
+		byte_writer(u8* begin, const size_t capacity) noexcept : first{ begin }, at{ begin }, last{ begin + capacity } {}
+
+		template<typename T> requires std::is_trivially_copyable_v<T>
+		void put(const T& val) noexcept {
+			if (room(sizeof(T))) {
+				std::memcpy(at, &val, sizeof(T));
+				at += sizeof(T);
+			}
+		}
+		// 7 bits per byte, low first. High bit set on all but the last. 1 byte under 128, at most 5.
+		void put_varint(u32 val) noexcept {
+			while (val >= 0x80) {
+				put(static_cast<u8>(val | 0x80));
+				val >>= 7;
+			}
+			put(static_cast<u8>(val));
+		}
+
+		size_t size() const noexcept { return static_cast<size_t>(at - first); }
+		bool ok() const noexcept { return good; }
+
+	private:
+		bool room(const size_t bytes) noexcept {
+			good = good and (bytes <= static_cast<size_t>(last - at));
+			return good;
+		}
+
+		u8* first;
+		u8* at;
+		u8* last;
+		bool good{ true };
+	};
+
+	// Reads what a byte_writer wrote. Reads past the end give zeros and leave it !ok(), so callers check once at the end.
+	class byte_reader {
+	public:
+		byte_reader(const u8* begin, const size_t size) noexcept : at{ begin }, last{ begin + size } {}
+
+		template<typename T> requires std::is_trivially_copyable_v<T>
+		T get() noexcept {
+			T val{};
+			if (good = good and (sizeof(T) <= remaining()); good) {
+				std::memcpy(&val, at, sizeof(T));
+				at += sizeof(T);
+			}
+			return val;
+		}
+		u32 get_varint() noexcept {
+			u32 val = 0;
+			for (u32 shift = 0; shift < 35; shift += 7) {
+				const u8 byte = get<u8>();
+				val |= static_cast<u32>(byte & 0x7F) << shift;
+				if ((byte & 0x80) == 0) {
+					return val;
+				}
+			}
+			good = false; // More than 5 bytes isn't a u32
+			return 0;
+		}
+
+		size_t remaining() const noexcept { return static_cast<size_t>(last - at); }
+		bool ok() const noexcept { return good; }
+
+	private:
+		const u8* at;
+		const u8* last;
+		bool good{ true };
+	};
+
+
+	// LZ77 block compression, in LZ4's sequence format: a token (literal count, match length - 4), the literals, a 16 bit offset, and extra length bytes past 15.
+	// Single pass with a 4096 entry hash table, so it favors speed over ratio. Blocks are only readable by Decompress(), which needs the original size.
+
+	constexpr size_t CompressBound(const size_t size) noexcept { return size + (size / 255) + 16; }
+	// Returns the compressed size, or 0 if dst is too small
+	size_t Compress(const u8* src, const size_t size, u8* dst, const size_t capacity) noexcept;
+	// False if src is not a whole block of exactly size bytes
+	bool Decompress(const u8* src, const size_t compressed_size, u8* dst, const size_t size) noexcept;
 
+}
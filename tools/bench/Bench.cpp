@@ -0,0 +1,55 @@
+#include "Bench.h"
+
+namespace Bench {
+
+	void runner::report(const string_view name, const u64 items) noexcept {
+		std::sort(samples.begin(), samples.end());
+		const u64 n = samples.size();
+		const u64 median = samples[n / 2];
+		const u64 p99 = samples[std::min<u64>((n * 99) / 100, n - 1)];
+		std::printf("%-44.*s %10llu %12llu %12llu %12llu %12.2f\n", static_cast<int>(name.size()), name.data(), static_cast<unsigned long long>(n),
+			static_cast<unsigned long long>(samples.front()), static_cast<unsigned long long>(median), static_cast<unsigned long long>(p99),
+			static_cast<double>(median) / static_cast<double>(std::max<u64>(items, 1)));
+		std::fflush(stdout);
+		++count;
+	}
+
+	static bool ParseArgs(const int argc, char** argv, string_view& filter, milliseconds& min_time) noexcept {
+		for (int i = 1; i < argc; ++i) {
+			const string_view arg{ argv[i] };
+			if (arg == "--min-time"sv) {
+				u32 ms = 0;
+				if ((++i >= argc) or (std::from_chars(argv[i], argv[i] + std::strlen(argv[i]), ms).ec != std::errc{}) or (ms == 0)) {
+					return false;
+				}
+				min_time = milliseconds{ ms };
+			} else if (filter.empty() and !arg.starts_with("--"sv)) {
+				filter = arg;
+			} else {
+				return false;
+			}
+		}
+		return true;
+	}
+
+}
+
+int main(int argc, char** argv) {
+	string_view filter{};
+	std::chrono::milliseconds min_time{ 200 };
+	if (!Bench::ParseArgs(argc, argv, filter, min_time)) {
+		std::fputs("Usage: fearse_bench [filter] [--min-time MS]\n", stderr);
+		return 2;
+	}
+	Bench::runner r{ filter, min_time };
+	std::printf("%-44s %10s %12s %12s %12s %12s\n", "benchmark", "calls", "min ns", "median ns", "p99 ns", "ns/item");
+	Bench::Micro(r);
+	Bench::Macro(r);
+	Bench::Saves(r);
+	Bench::Keywords(r);
+	if (r.ran() == 0) {
+		std::fprintf(stderr, "No benchmark matches <%.*s>\n", static_cast<int>(filter.size()), filter.data());
+		return 1;
+	}
+	return 0;
+}
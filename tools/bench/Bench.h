@@ -0,0 +1,64 @@
+#pragma once
+#include "Common.h"
+#include "Types/Timing.h"
+
+// Micro and macro benchmarks of the portable core, run outside the game.
+// Usage: fearse_bench [filter] [--min-time MS]. Runs every benchmark whose name contains filter.
+
+namespace Bench {
+	using Timing::nanoseconds;
+	using std::chrono::milliseconds;
+
+	// Keeps the compiler from dropping the work that made val
+	template<typename T>
+	FORCEINLINE void keep(const T& val) noexcept {
+#if defined(__GNUC__)
+		asm volatile("" : : "r,m"(val) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &val;
+#endif
+	}
+
+	class runner {
+	public:
+		runner(const string_view filter, const milliseconds min_time) noexcept : filter{ filter }, min_time{ min_time } {}
+
+		// Times fn() over and over for at least min_time, after a warmup call. items is how much work one call does, for the per-item figure.
+		template<typename Fn>
+		void run(const string_view name, const u64 items, Fn&& fn) noexcept {
+			if (!wanted(name)) {
+				return;
+			}
+			fn();
+			samples.clear();
+			const auto until = Timing::clock::now() + min_time;
+			do {
+				const auto start = Timing::clock::now();
+				fn();
+				samples.push_back(static_cast<u64>((Timing::clock::now() - start).count()));
+			} while ((Timing::clock::now() < until) or (samples.size() < MinSamples));
+			report(name, items);
+		}
+		u32 ran() const noexcept { return count; }
+
+		// For skipping setup of benchmarks that won't run
+		bool wanted(const string_view name) const noexcept { return filter.empty() or (name.find(filter) != string_view::npos); }
+
+	private:
+		static constexpr size_t MinSamples = 10;
+
+		string_view filter;
+		milliseconds min_time;
+		vector<u64> samples{};
+		u32 count{ 0 };
+
+		void report(const string_view name, const u64 items) noexcept;
+	};
+
+	void Micro(runner& r) noexcept;
+	void Macro(runner& r) noexcept;
+	void Saves(runner& r) noexcept;
+	void Keywords(runner& r) noexcept;
+
+}
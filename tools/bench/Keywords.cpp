@@ -0,0 +1,184 @@
+#include "Bench.h"
+#include "DataDefs/KeywordRecords.h"
+#include "Types/PairSet.h"
+#include "Utils/RNG.h"
+
+// ExtraKeywords storage at 100k (form, keyword) pairs: the flat pair_set against the map of sets it replaced, in lookups and in co-save records.
+
+namespace Bench {
+	using PairSet::pair_set;
+	using LazyVector::lazy_vector;
+
+	enum : u32 {
+		FormCount = 10'000,
+		KeywordsPerForm = 10,	// 100k pairs
+		KeywordPool = 1'000,
+		Queries = 4096,
+		BatchKeywords = 32,		// Per batch query, like a formlist of keywords
+		BatchForms = 128
+	};
+
+	static constexpr RE::FormID FormAt(const u32 i) noexcept { return 0x0001'0000 + (i * 17); }
+	static constexpr RE::FormID KeywordAt(const u32 i) noexcept { return 0x0000'0800 + i; }
+	static RE::FormID RandomKeyword(const u32 key, const u32 counter) noexcept { return KeywordAt(static_cast<u32>(RNG::hashf01(key, counter) * (KeywordPool - 1))); }
+
+	using map_of_sets = std::map<RE::FormID, std::set<RE::FormID>>;
+
+	// What ExtraKeywords::Data::Save() wrote before version 2, a call per formID
+	static void WriteV1(SKSE::SerializationInterface& intfc, const map_of_sets& data) noexcept {
+		(void)intfc.WriteRecordData(static_cast<u64>(data.size()));
+		for (const auto& [formID, kwds] : data) {
+			(void)intfc.WriteRecordData(formID);
+			(void)intfc.WriteRecordData(static_cast<u64>(kwds.size()));
+			for (const RE::FormID kwd : kwds) {
+				(void)intfc.WriteRecordData(kwd);
+			}
+		}
+	}
+
+	static void Read(SKSE::SerializationInterface& intfc, pair_set& out) noexcept {
+		u32 type, version, length;
+		lazy_vector<u64> saved{};
+		if (!intfc.GetNextRecordInfo(type, version, length) or !ExtraKeywords::Records::Read(intfc, version, saved)) {
+			SKSE::stl::report_and_fail("reading ExtraKeywords records failed"sv);
+		}
+		out.assign(std::move(saved));
+	}
+
+	void Keywords(runner& r) noexcept {
+		enum : u32 { RecordType = 0x45584B57 }; // "EXKW", as ExtraKeywords saves
+		static constexpr array<string_view, 9> Names{
+			"ExtraKeywords map+set contains 100k pairs"sv,
+			"ExtraKeywords pair_set contains 100k pairs"sv,
+			"ExtraKeywords map+set 32 keywords to deque<bool>"sv,
+			"ExtraKeywords pair_set contains_each 32 keywords"sv,
+			"ExtraKeywords pair_set insert+erase 100k pairs"sv,
+			"ExtraKeywords v1 write 100k pairs"sv,
+			"ExtraKeywords v1 load 100k pairs"sv,
+			"ExtraKeywords v2 write 100k pairs"sv,
+			"ExtraKeywords v2 load 100k pairs"sv
+		};
+		if (std::ranges::none_of(Names, [&r](const string_view name) { return r.wanted(name); })) {
+			return;
+		}
+
+		static map_of_sets sets{};
+		static pair_set pairs{};
+		lazy_vector<u64> unsorted{};
+		if (!unsorted.reserve(FormCount * KeywordsPerForm)) {
+			SKSE::stl::report_and_fail("out of memory"sv);
+		}
+		for (u32 f = 0; f < FormCount; ++f) {
+			for (u32 k = 0; k < KeywordsPerForm; ++k) {
+				const RE::FormID kwd = RandomKeyword(f, k);
+				sets[FormAt(f)].insert(kwd);
+				unsorted.append(pair_set::make(FormAt(f), kwd));
+			}
+		}
+		pairs.assign(std::move(unsorted));
+
+		// Half hit, since forms get queried for the keywords they were given
+		vector<pair<RE::FormID, RE::FormID>> queries(Queries);
+		for (u32 q = 0; q < Queries; ++q) {
+			const u32 f = static_cast<u32>(RNG::hashf01(q, 100) * (FormCount - 1));
+			queries[q] = { FormAt(f), (q % 2) ? RandomKeyword(f, q % KeywordsPerForm) : RandomKeyword(q, 101) };
+		}
+		u64 hits_sets = 0;
+		u64 hits_pairs = 0;
+		for (const auto& [form, kwd] : queries) {
+			const auto it = sets.find(form);
+			hits_sets += (it != sets.end()) and it->second.contains(kwd);
+			hits_pairs += pairs.contains(form, kwd);
+		}
+		if (hits_sets != hits_pairs) {
+			SKSE::stl::report_and_fail("pair_set disagrees with the map of sets"sv);
+		}
+
+		r.run(Names[0], Queries, [&] {
+			u64 hits = 0;
+			for (const auto& [form, kwd] : queries) {
+				const auto it = sets.find(form);
+				hits += (it != sets.end()) and it->second.contains(kwd);
+			}
+			keep(hits);
+		});
+		r.run(Names[1], Queries, [&] {
+			u64 hits = 0;
+			for (const auto& [form, kwd] : queries) {
+				hits += pairs.contains(form, kwd);
+			}
+			keep(hits);
+		});
+
+		// A form against a list of keywords, as Has(form, keywords) does for Papyrus
+		array<RE::FormID, BatchKeywords> batch{};
+		for (u32 k = 0; k < BatchKeywords; ++k) {
+			batch[k] = RandomKeyword(k, 102);
+		}
+		r.run(Names[2], BatchForms * BatchKeywords, [&] {
+			for (u32 f = 0; f < BatchForms; ++f) {
+				std::deque<bool> result(BatchKeywords, false);
+				if (const auto it = sets.find(FormAt(f * 61)); it != sets.end()) {
+					for (u32 k = 0; k < BatchKeywords; ++k) {
+						result[k] = it->second.contains(batch[k]);
+					}
+				}
+				keep(result.back());
+			}
+		});
+		r.run(Names[3], BatchForms * BatchKeywords, [&] {
+			for (u32 f = 0; f < BatchForms; ++f) {
+				u64 bits = 0;
+				pairs.contains_each(FormAt(f * 61), batch.data(), BatchKeywords, &bits);
+				keep(bits);
+			}
+		});
+
+		r.run(Names[4], 2, [&] {
+			const bool inserted = pairs.insert(FormAt(FormCount / 2), KeywordAt(KeywordPool));
+			keep(pairs.erase(FormAt(FormCount / 2), KeywordAt(KeywordPool)) and inserted);
+		});
+
+		static SKSE::SerializationInterface intfc{};
+		static pair_set loaded{};
+		const auto write_v1 = [&] {
+			intfc.clear();
+			(void)intfc.OpenRecord(RecordType, 1);
+			WriteV1(intfc, sets);
+		};
+		const auto write_v2 = [&] {
+			intfc.clear();
+			(void)intfc.OpenRecord(RecordType, 2);
+			if (!ExtraKeywords::Records::Write(intfc, pairs)) {
+				SKSE::stl::report_and_fail("ExtraKeywords::Records::Write failed"sv);
+			}
+		};
+		array<size_t, 2> bytes{};
+		array<size_t, 2> calls{};
+		for (u32 v = 0; v < 2; ++v) {
+			(v == 0) ? write_v1() : write_v2();
+			bytes[v] = intfc.bytes();
+			calls[v] = intfc.write_calls;
+			Read(intfc, loaded);
+			if (!std::ranges::equal(loaded.all(), pairs.all())) {
+				SKSE::stl::report_and_fail("ExtraKeywords records did not round trip"sv);
+			}
+		}
+		write_v1();
+		r.run(Names[5], pairs.size(), write_v1);
+		r.run(Names[6], pairs.size(), [&] {
+			intfc.rewind();
+			Read(intfc, loaded);
+			keep(loaded.size());
+		});
+		write_v2();
+		r.run(Names[7], pairs.size(), write_v2);
+		r.run(Names[8], pairs.size(), [&] {
+			intfc.rewind();
+			Read(intfc, loaded);
+			keep(loaded.size());
+		});
+		std::printf("\nExtraKeywords record at 100k pairs: v1 %zu bytes in %zu calls, v2 %zu bytes in %zu calls\n", bytes[0], calls[0], bytes[1], calls[1]);
+	}
+
+}
@@ -0,0 +1,154 @@
+#include "Bench.h"
+#include "DataDefs/FearKernel.h"
+#include "DataDefs/Multivector.h"
+#include "Types/SyncTypes.h"
+#include "Utils/RNG.h"
+
+// Whole updates, or the parts of one, over made up actors shaped like a busy game's
+
+namespace Bench {
+	using namespace Data;
+	namespace Kernel = Data::Fear::Kernel;	// ::Fear holds the forms
+	using UpdateTypes::MaxUpdateCount;
+
+	static trivial_handle Handle(const u32 native) noexcept { return std::bit_cast<trivial_handle>(native); }
+
+	// Update inputs for count actors, from fixed seeds
+	struct update_inputs {
+		fear_columns infos{};
+		lazy_vector<float> exposures{};
+		array<UpdateTypes::main_out, MaxUpdateCount> mains{};
+		UpdateTypes::seeing_matrix seeing{};
+		array<trivial_handle, MaxUpdateCount> handles{};
+		UpdateTypes::ranks_and_oneofs pack{};
+
+		void make(const u32 count) noexcept {
+			infos.clear();
+			exposures.clear();
+			if (!infos.reserve(count) or !exposures.reserve(count)) {
+				SKSE::stl::report_and_fail("out of memory"sv);
+			}
+			seeing.reset(count);
+			for (u32 i = 0; i < count; ++i) {
+				FearInfo info{};
+				info.fear = RNG::hashf01(i, 1);
+				info.thrillseeking = RNG::hashf01(i, 2);
+				info.fears_female = RNG::hashf01(i, 3);
+				info.fears_male = RNG::hashf01(i, 4);
+				info.buildup_mod = RNG::hashf01(i, 5) * 20.0f;
+				info.last_rest_day = RNG::hashf01(i, 6) * 30.0f;
+				info.is_female = RNG::hashf01(i, 7) < 0.5f;
+				info.in_brawl = RNG::hashf01(i, 8) < 0.05f;
+				infos.append(info);
+				exposures.append(RNG::hashf01(i, 9));
+				mains[i] = UpdateTypes::main_out{ .hppcnt = static_cast<u8>(RNG::hashf01(i, 10) * 100.0f), .combat = RNG::hashf01(i, 11) < 0.2f };
+				handles[i] = Handle(0x0010'0000 + i);
+				for (u32 j = 0; j < count; ++j) {
+					seeing.set_if_val(i, j, (i != j) and (RNG::hashf01(i, j) < 0.25f));
+				}
+			}
+			pack.actor_count = count;
+			pack.now = 40.0f;
+			pack.need_ranks = true;
+		}
+	};
+
+	static void FearUpdates(runner& r) noexcept {
+		static update_inputs in{};
+		static Kernel::lanes lanes{};
+		static SyncTypes::worker_pool pool{};
+		const Kernel::params p{ .hostile = 1.5f, .interior = 1.0f };
+		u32 update_index = 0;
+
+		for (const u32 count : { 16u, 64u, 128u, static_cast<u32>(MaxUpdateCount) }) {
+			const string name = "Kernel::Compute " + to_string(count) + " actors";
+			if (!r.wanted(name)) {
+				continue;
+			}
+			in.make(count);
+			r.run(name, count, [&] {
+				keep(Kernel::Compute(lanes, in.infos, in.exposures, in.mains, in.seeing, in.handles, in.pack, p, update_index++, nullptr));
+			});
+		}
+
+		// Same update split across the pool, as fear_workers does from Kernel::ParallelMinActors actors on
+		const u32 workers = std::min<u32>(std::max<u32>(std::thread::hardware_concurrency(), 2) - 1, SyncTypes::worker_pool::MaxWorkers);
+		const string pooled = "Kernel::Compute 256 actors, " + to_string(workers) + " workers";
+		if (r.wanted(pooled) and (pool.resize(workers) != 0)) {
+			in.make(MaxUpdateCount);
+			r.run(pooled, MaxUpdateCount, [&] {
+				keep(Kernel::Compute(lanes, in.infos, in.exposures, in.mains, in.seeing, in.handles, in.pack, p, update_index++, &pool));
+			});
+			(void)pool.resize(0);
+		}
+
+		// Just the math, on whatever the last Compute() gathered into lanes
+		r.run("Kernel::RunScalar 256 actors"sv, MaxUpdateCount, [&] {
+			Kernel::RunScalar(lanes, 0, MaxUpdateCount, p);
+			keep(lanes.new_fear);
+		});
+		r.run("Kernel::RunSIMD 256 actors"sv, MaxUpdateCount, [&] {
+			Kernel::RunSIMD(lanes, 0, MaxUpdateCount, p);
+			keep(lanes.new_fear);
+		});
+	}
+
+	static void RulesUpdates(runner& r) noexcept {
+		static rules_info rules{};
+		static const EquipState equips{};
+		float buildup = 0.0f;
+		r.run("rules_info::Update"sv, 1, [&] {
+			buildup = (buildup >= 20.0f) ? 0.0f : (buildup + 0.5f);
+			rules.Update(equips, 0.01f, buildup, false);
+			keep(rules);
+		});
+	}
+
+	// The bookkeeping a default update does on the persistent data before anything is computed: sort the gathered actors into rows, most recent first
+	static void MultivectorBookkeeping(runner& r) noexcept {
+		constexpr u32 Known = 2048; // Actors ever seen
+		constexpr u32 PerUpdate = 192;
+		static multivector data{};
+		static array<trivial_handle, MaxUpdateCount> handles{};
+		static array<RE::ActorPtr, MaxUpdateCount> ptrs{};
+		static UpdateTypes::ranks_and_oneofs pack{};
+		u32 offset = 0;
+
+		// Each update sees mostly the actors of the last one, give or take a few walking in and out of range
+		auto next_update = [&] {
+			offset = (offset + 7) % Known;
+			for (u32 i = 0; i < PerUpdate; ++i) {
+				handles[i] = Handle(0x0010'0000 + ((offset + ((i * 13) % PerUpdate)) % Known));
+			}
+			pack.actor_count = PerUpdate;
+			keep(data.swap_allocate_move(handles, ptrs, pack));
+		};
+		r.run("multivector::swap_allocate_move 192 actors"sv, PerUpdate, next_update);
+
+		r.run("multivector::find_index 192 actors"sv, PerUpdate, [&] {
+			u64 sum = 0;
+			for (u32 i = 0; i < PerUpdate; ++i) {
+				sum += data.find_index(handles[i]);
+			}
+			keep(sum);
+		});
+
+		// Dead or unloaded actors get their handles zeroed, and the rows compacted away
+		r.run("multivector::clear_zero_handles 1/16 zeroed"sv, data.size(), [&] {
+			for (size_t i = 0, end = data.size(); i < end; i += 16) {
+				data.all_handles()[i].reset();
+			}
+			data.clear_zero_handles();
+			for (u32 i = 0; i < 4; ++i) {
+				next_update();
+			}
+		});
+	}
+
+	void Macro(runner& r) noexcept {
+		FearUpdates(r);
+		RulesUpdates(r);
+		MultivectorBookkeeping(r);
+	}
+
+}
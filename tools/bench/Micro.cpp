@@ -0,0 +1,240 @@
+#include "Bench.h"
+#include "DataDefs/FearKernel.h"
+#include "Types/HandleIndex.h"
+#include "Types/SyncTypes.h"
+#include "Utils/RNG.h"
+
+// Single operations of the core types, a batch per call so the clock's cost doesn't matter
+
+namespace Bench {
+	using namespace Data;
+	namespace Kernel = Data::Fear::Kernel;	// ::Fear holds the forms
+
+	enum : u32 { Batch = 4096 };
+
+	// Deterministic inputs, so runs compare
+	static vector<u32> Keys(const u32 count, const u32 seed) {
+		vector<u32> keys(count);
+		for (u32 i = 0; i < count; ++i) {
+			keys[i] = static_cast<u32>(RNG::hashf01(seed, i) * static_cast<float>(std::numeric_limits<u32>::max() >> 8)) + 1; // Never 0, the empty key
+		}
+		return keys;
+	}
+
+	static void LazyVectors(runner& r) noexcept {
+		lazy_vector<u32> vec{};
+		if (!vec.reserve(Batch)) {
+			SKSE::stl::report_and_fail("out of memory"sv);
+		}
+		r.run("lazy_vector append"sv, Batch, [&] {
+			vec.clear();
+			for (u32 i = 0; i < Batch; ++i) {
+				vec.append(i);
+			}
+			keep(vec.back());
+		});
+		r.run("lazy_vector erase (swap with last)"sv, Batch, [&] {
+			vec.clear();
+			for (u32 i = 0; i < Batch; ++i) {
+				vec.append(i);
+			}
+			for (u32 i = 0; i < Batch; ++i) {
+				vec.erase((i * 7) % vec.size());
+			}
+			keep(vec.size());
+		});
+	}
+
+	// lazy_vector::find on u32, which takes the SIMD path, against the plain scalar loop it replaced, as the in-game BenchFind. Every lookup misses, so each one is a full scan.
+	static void Finds(runner& r) noexcept {
+		static constexpr array<u32, 4> Sizes{ 32, 256, 4'096, 65'536 };
+		static constexpr array<string_view, Sizes.size()> ScalarNames{
+			"lazy_vector<u32> find 32 (scalar)"sv,
+			"lazy_vector<u32> find 256 (scalar)"sv,
+			"lazy_vector<u32> find 4k (scalar)"sv,
+			"lazy_vector<u32> find 64k (scalar)"sv
+		};
+		static constexpr array<string_view, Sizes.size()> SIMDNames{
+			"lazy_vector<u32> find 32 (SIMD)"sv,
+			"lazy_vector<u32> find 256 (SIMD)"sv,
+			"lazy_vector<u32> find 4k (SIMD)"sv,
+			"lazy_vector<u32> find 64k (SIMD)"sv
+		};
+		enum : u32 { ScannedPerCall = 65'536 };
+
+		for (size_t s = 0; s < Sizes.size(); ++s) {
+			if (!r.wanted(ScalarNames[s]) and !r.wanted(SIMDNames[s])) {
+				continue;
+			}
+			const u32 size = Sizes[s];
+			const vector<u32> odd = Keys(size, 7);
+			lazy_vector<u32> keys{};
+			if (!keys.reserve(size)) {
+				SKSE::stl::report_and_fail("out of memory"sv);
+			}
+			for (const u32 key : odd) {
+				keys.append(key | 1); // Queries are even
+			}
+			const u32 lookups = ScannedPerCall / size;
+
+			u32 query = 0;
+			r.run(ScalarNames[s], lookups, [&] {
+				u64 sum = 0;
+				for (u32 i = 0; i < lookups; ++i) {
+					query += 2;
+					const u32* it = keys.begin();
+					for (; (it != keys.end()) and (*it != query); ++it) { ; }
+					sum += static_cast<u64>(it - keys.begin());
+				}
+				keep(sum);
+			});
+			r.run(SIMDNames[s], lookups, [&] {
+				u64 sum = 0;
+				for (u32 i = 0; i < lookups; ++i) {
+					query += 2;
+					sum += static_cast<u64>(keys.find(query) - keys.begin());
+				}
+				keep(sum);
+			});
+		}
+	}
+
+	static void Saturatings(runner& r) noexcept {
+		static array<float, Batch> floats{};
+		for (u32 i = 0; i < Batch; ++i) {
+			floats[i] = RNG::hashf01(1, i) - 0.5f;
+		}
+		r.run("sat01flt +="sv, Batch, [&] {
+			sat01flt acc{ 0.5f };
+			for (const float f : floats) {
+				acc += f;
+			}
+			keep(acc);
+		});
+		r.run("satu8 +="sv, Batch, [&] {
+			satu8 acc{};
+			for (u32 i = 0; i < Batch; ++i) {
+				acc += static_cast<u8>(i);
+				acc -= static_cast<u8>(i >> 1);
+			}
+			keep(acc);
+		});
+		r.run("saturating<u64> *="sv, Batch, [&] {
+			u64 sum = 0;
+			for (u32 i = 0; i < Batch; ++i) {
+				saturating<u64> val{ 0x1'0000'0000ull + i };
+				val *= (static_cast<u64>(i) << 20) | 3;
+				sum += val.get();
+			}
+			keep(sum);
+		});
+		r.run("saturating<i64> *="sv, Batch, [&] {
+			i64 sum = 0;
+			for (u32 i = 0; i < Batch; ++i) {
+				saturating<i64> val{ static_cast<i64>(i) - 2048 };
+				val *= static_cast<i64>(0x7FFF'FFFF'FFFFll / (i + 1));
+				sum += val.get();
+			}
+			keep(sum);
+		});
+	}
+
+	static void Hashing(runner& r) noexcept {
+		r.run("RNG::hashf01"sv, Batch, [&] {
+			float sum = 0.0f;
+			for (u32 i = 0; i < Batch; ++i) {
+				sum += RNG::hashf01(i, 12345);
+			}
+			keep(sum);
+		});
+
+		const vector<u32> keys = Keys(Batch, 7);
+		HandleIndex::handle_index index{};
+		r.run("handle_index insert"sv, Batch, [&] {
+			index.clear();
+			for (u32 i = 0; i < Batch; ++i) {
+				(void)index.insert_or_assign(keys[i], i);
+			}
+			keep(index.size());
+		});
+		r.run("handle_index find"sv, Batch, [&] {
+			u64 sum = 0;
+			for (const u32 key : keys) {
+				sum += index.find(key);
+			}
+			keep(sum);
+		});
+		r.run("handle_index erase"sv, Batch, [&] {
+			for (u32 i = 0; i < Batch; ++i) {
+				(void)index.insert_or_assign(keys[i], i);
+			}
+			for (const u32 key : keys) {
+				(void)index.erase(key);
+			}
+			keep(index.size());
+		});
+	}
+
+	static void Locks(runner& r) noexcept {
+		SyncTypes::spinlock spin{};
+		SyncTypes::shared_spinlock shared{};
+		SyncTypes::writer_preferring_spinlock writer{};
+		r.run("spinlock lock/unlock"sv, Batch, [&] {
+			for (u32 i = 0; i < Batch; ++i) {
+				spin.lock();
+				spin.unlock();
+			}
+		});
+		r.run("shared_spinlock lock_shared/unlock_shared"sv, Batch, [&] {
+			for (u32 i = 0; i < Batch; ++i) {
+				shared.lock_shared();
+				shared.unlock_shared();
+			}
+		});
+		r.run("writer_preferring_spinlock lock/unlock"sv, Batch, [&] {
+			for (u32 i = 0; i < Batch; ++i) {
+				writer.lock();
+				writer.unlock();
+			}
+		});
+	}
+
+	static void Seeing(runner& r) noexcept {
+		constexpr u32 Actors = UpdateTypes::MaxUpdateCount;
+		static UpdateTypes::seeing_matrix seeing{};
+		static Kernel::lanes lanes{};
+		for (u32 i = 0; i < Actors; ++i) {
+			lanes.exposure_m[i] = (i & 1) ? RNG::hashf01(i, 1) : 0.0f;
+			lanes.exposure_f[i] = (i & 1) ? 0.0f : RNG::hashf01(i, 1);
+		}
+		r.run("seeing_matrix fill (256 actors)"sv, Actors * Actors, [&] {
+			seeing.reset(Actors);
+			for (u32 i = 0; i < Actors; ++i) {
+				for (u32 j = 0; j < Actors; ++j) {
+					seeing.set_if_val(i, j, (i != j) and (RNG::hashf01(i, j) < 0.25f));
+				}
+			}
+			keep(seeing);
+		});
+		r.run("Kernel::SeeingExposures (256 actors)"sv, Actors, [&] {
+			float sum = 0.0f;
+			for (u32 i = 0; i < Actors; ++i) {
+				float sum_m = 0.0f;
+				float sum_f = 0.0f;
+				Kernel::SeeingExposures(lanes, seeing, i, sum_m, sum_f);
+				sum += sum_m + sum_f;
+			}
+			keep(sum);
+		});
+	}
+
+	void Micro(runner& r) noexcept {
+		LazyVectors(r);
+		Finds(r);
+		Saturatings(r);
+		Hashing(r);
+		Locks(r);
+		Seeing(r);
+	}
+
+}
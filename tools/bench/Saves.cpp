@@ -0,0 +1,230 @@
+#include "Bench.h"
+#include "DataDefs/ActorRecords.h"
+#include "Utils/RNG.h"
+
+#include <unordered_map>
+
+// The actor rows of the co-save, written and read back through the shim's in-memory SerializationInterface.
+// Game lookups are left out: formIDs resolve to themselves and every actor is taken as valid.
+
+namespace Bench {
+	using namespace Data;
+	using ActorRecords::format;
+
+	struct saved_actors {
+		lazy_vector<RE::FormID> formIDs{};
+		fear_columns fears{};
+		lazy_vector<EquipState> equips{};
+
+		// Rows shaped like a long playthrough's: base game, mod and created references, mostly in body armor, few hurdles, hands usually empty
+		void make(const u32 count) noexcept {
+			formIDs.clear();
+			fears.clear();
+			equips.clear();
+			if (!formIDs.reserve(count) or !fears.reserve(count) or !equips.reserve(count)) {
+				SKSE::stl::report_and_fail("out of memory"sv);
+			}
+			for (u32 i = 0; i < count; ++i) {
+				const float kind = RNG::hashf01(i, 0);
+				const RE::FormID formID = (kind < 0.5f) ? (0x0001'0000 + (i * 37)) : (kind < 0.7f) ? (0x0500'0000 + (i * 7)) : (0xFF00'0800 + (i * 3));
+				formIDs.append(((i % 50) == 49) ? 0 : formID); // Some gone since they were gathered
+				FearInfo info{};
+				info.fear = RNG::hashf01(i, 1);
+				info.thrillseeking = RNG::hashf01(i, 2);
+				info.fears_female = RNG::hashf01(i, 3);
+				info.fears_male = RNG::hashf01(i, 4);
+				info.buildup_mod = RNG::hashf01(i, 5) * 20.0f;
+				if (RNG::hashf01(i, 6) < 0.7f) {
+					info.last_rest_day = RNG::hashf01(i, 7) * 300.0f;
+				}
+				info.is_female = RNG::hashf01(i, 8) < 0.5f;
+				info.is_blocked = RNG::hashf01(i, 9) < 0.1f;
+				fears.append(info);
+
+				EquipState eqs{};
+				for (const u32 slot : { 2u, 3u, 7u, 1u }) { // Body, hands, feet, hair
+					if (RNG::hashf01(i, 10 + slot) < 0.8f) {
+						eqs.slots[slot].f = static_cast<u8>((u8{ 0b0010'0000 } << static_cast<u32>(RNG::hashf01(i, 20 + slot) * 3.0f)) | (i & 0x3));
+					}
+				}
+				if (RNG::hashf01(i, 30) < 0.1f) {
+					eqs.hr.counts[static_cast<u32>(RNG::hashf01(i, 31) * 26.0f)] = 1;
+				}
+				eqs.hr.update_empty_flag();
+				eqs.hands.right = static_cast<u8>((RNG::hashf01(i, 32) < 0.3f) * 1);
+				equips.append(eqs);
+			}
+		}
+	};
+
+	// What multivector::Save() did before version 2: 3 calls per actor
+	static void WriteV1(SKSE::SerializationInterface& intfc, const saved_actors& in) noexcept {
+		const size_t valid_count = static_cast<size_t>(std::ranges::count_if(in.formIDs, [](const RE::FormID id) { return id != 0; }));
+		(void)intfc.WriteRecordData(valid_count);
+		for (size_t i = 0, end = in.formIDs.size(); i < end; ++i) {
+			if (in.formIDs[i] != 0) {
+				(void)intfc.WriteRecordData(in.formIDs[i]);
+				(void)in.fears.row(i).Save(intfc);
+				(void)in.equips[i].Save(intfc);
+			}
+		}
+	}
+
+	// What multivector::Load() does with the actor rows: read them, then keep them cold
+	static void Read(SKSE::SerializationInterface& intfc, ActorRecords::columns& saved, ActorRecords::cold_rows& cold) noexcept {
+		u32 type, version, length;
+		if (!intfc.GetNextRecordInfo(type, version, length) or !ActorRecords::Read(intfc, version, saved) or !cold.assign(intfc, saved)) {
+			SKSE::stl::report_and_fail("reading actor records failed"sv);
+		}
+	}
+	static void Collect(const ActorRecords::cold_rows& cold, saved_actors& out) noexcept {
+		out.formIDs = cold.formIDs;
+		out.fears.clear();
+		out.equips.clear();
+		if (!out.fears.reserve(cold.size()) or !out.equips.reserve(cold.size())) {
+			SKSE::stl::report_and_fail("out of memory"sv);
+		}
+		for (size_t row = 0, end = cold.size(); row < end; ++row) {
+			out.fears.append(cold.fear(row));
+			out.equips.append(cold.equips(row));
+		}
+	}
+
+	// Every version must load back the rows that were saved. Encoded ones come back sorted, and the [0, 1] fields within their 16 bit step.
+	static void Verify(const saved_actors& in, const saved_actors& out, const bool encoded) noexcept {
+		std::unordered_map<RE::FormID, size_t> loaded{};
+		for (size_t o = 0, end = out.formIDs.size(); o < end; ++o) {
+			loaded.emplace(out.formIDs[o], o);
+		}
+		const auto near = [encoded](const float a, const float b) { return encoded ? (std::abs(a - b) <= (0.5f / 65535.0f) + 1e-7f) : (a == b); };
+		size_t saved = 0;
+		for (size_t i = 0, end = in.formIDs.size(); i < end; ++i) {
+			if (in.formIDs[i] == 0) {
+				continue;
+			}
+			++saved;
+			const auto it = loaded.find(in.formIDs[i]);
+			if (it == loaded.end()) {
+				SKSE::stl::report_and_fail("actor records did not round trip"sv);
+			}
+			const FearInfo a = in.fears.row(i);
+			const FearInfo b = out.fears.row(it->second);
+			if (!near(a.fear, b.fear) or !near(a.thrillseeking, b.thrillseeking) or !near(a.fears_female, b.fears_female) or !near(a.fears_male, b.fears_male)
+				or (std::memcmp(&a.buildup_mod, &b.buildup_mod, sizeof(float)) != 0) or (std::memcmp(&a.last_rest_day, &b.last_rest_day, sizeof(float)) != 0)
+				or (a.is_female != b.is_female) or (a.is_blocked != b.is_blocked) or b.in_brawl
+				or (std::memcmp(&in.equips[i], &out.equips[it->second], ActorRecords::EquipRowSize) != 0))
+			{
+				SKSE::stl::report_and_fail("actor records did not round trip"sv);
+			}
+		}
+		if (saved != out.formIDs.size()) {
+			SKSE::stl::report_and_fail("actor records did not round trip"sv);
+		}
+	}
+
+	void Saves(runner& r) noexcept {
+		enum : u32 { RecordType = 0x46524454 }; // "FRDT", as Data::Shared saves
+		struct kind {
+			string_view name;
+			u32 version;
+			format fmt;
+		};
+		static constexpr array<kind, 4> Kinds{ {
+			{ "v1"sv, 1, format::Columns },
+			{ "columns"sv, 2, format::Columns },
+			{ "encoded"sv, 3, format::Encoded },
+			{ "encoded+lz"sv, 3, format::EncodedCompressed }
+		} };
+		static constexpr array<u32, 3> Counts{ 1'000, 10'000, 50'000 };
+		static saved_actors in{};
+		static saved_actors out{};
+		static ActorRecords::columns saved{};
+		static ActorRecords::cold_rows cold{};
+		static const ActorRecords::cold_rows none{};
+		static SKSE::SerializationInterface intfc{};
+		array<array<size_t, Counts.size()>, Kinds.size()> sizes{};
+		array<size_t, Counts.size()> cold_bytes{};
+		bool any = false;
+
+		for (size_t c = 0; c < Counts.size(); ++c) {
+			const u32 count = Counts[c];
+			const string actors = " " + to_string(count / 1000) + "k actors";
+			bool made = false;
+			for (size_t k = 0; k < Kinds.size(); ++k) {
+				const kind& kd = Kinds[k];
+				const string prefix = "co-save " + string{ kd.name } + " ";
+				const bool round_trip = (count == 10'000);
+				const bool finds = round_trip and (kd.version == 2); // Lookups don't depend on the version
+				if (!r.wanted(prefix + "write" + actors) and !r.wanted(prefix + "load" + actors) and !(round_trip and r.wanted(prefix + "round trip" + actors)) and !(finds and r.wanted("co-save cold find" + actors))) {
+					continue;
+				}
+				if (!made) {
+					in.make(count);
+					made = true;
+				}
+				const auto write = [&] {
+					intfc.clear();
+					(void)intfc.OpenRecord(RecordType, kd.version);
+					if (kd.version == 1) {
+						WriteV1(intfc, in);
+					} else if (!ActorRecords::Write(intfc, in.formIDs, in.fears, in.equips, none, kd.fmt)) {
+						SKSE::stl::report_and_fail("ActorRecords::Write failed"sv);
+					}
+				};
+				write();
+				sizes[k][c] = intfc.bytes();
+				any = true;
+				Read(intfc, saved, cold);
+				Collect(cold, out);
+				Verify(in, out, kd.version == 3);
+				if (kd.version == 2) {
+					cold_bytes[c] = cold.bytes.size() + (cold.size() * (sizeof(RE::FormID) + sizeof(u32)));
+				}
+
+				r.run(prefix + "write" + actors, count, write);
+				r.run(prefix + "load" + actors, count, [&] {
+					intfc.rewind();
+					Read(intfc, saved, cold);
+					keep(cold.count());
+				});
+				if (round_trip) {
+					r.run(prefix + "round trip" + actors, count, [&] {
+						write();
+						Read(intfc, saved, cold);
+						keep(cold.count());
+					});
+				}
+				if (finds) { // What swap_allocate_move() asks of each new actor while there are cold rows
+					r.run("co-save cold find" + actors, count, [&] {
+						size_t found = 0;
+						for (const RE::FormID formID : in.formIDs) {
+							found += cold.find(formID) < cold.size();
+						}
+						keep(found);
+					});
+				}
+			}
+		}
+
+		if (any) {
+			std::printf("\n%-44s %18s %18s %18s\n", "co-save actor bytes (% of v1)", "1k actors", "10k actors", "50k actors");
+			for (size_t k = 0; k < Kinds.size(); ++k) {
+				std::printf("%-44.*s", static_cast<int>(Kinds[k].name.size()), Kinds[k].name.data());
+				for (size_t c = 0; c < Counts.size(); ++c) {
+					if ((sizes[k][c] == 0) or (sizes[0][c] == 0)) { // Filtered out
+						std::printf(" %18s", "-");
+					} else {
+						std::printf(" %10zu (%5.1f%%)", sizes[k][c], 100.0 * static_cast<double>(sizes[k][c]) / static_cast<double>(sizes[0][c]));
+					}
+				}
+				std::printf("\n");
+			}
+			std::printf("%-44s", "cold rows in memory, per actor");
+			for (size_t c = 0; c < Counts.size(); ++c) {
+				(cold_bytes[c] == 0) ? (void)std::printf(" %18s", "-") : (void)std::printf(" %18.1f", static_cast<double>(cold_bytes[c]) / Counts[c]);
+			}
+			std::printf("   (FearInfo and EquipState: %zu)\n", sizeof(FearInfo) + sizeof(EquipState));
+		}
+	}
+
+}
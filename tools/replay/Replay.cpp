@@ -0,0 +1,206 @@
+#include "DataDefs/UpdateTrace.h"
+#include "Types/SyncTypes.h"
+#include "Types/Timing.h"
+
+// Reruns the Fear and rules updates of a trace recorded in game with SetUpdateTrace(true), timing them and diffing what they give against what the game got.
+// Usage: fearse_replay <trace> [--repeat N] [--workers N] [--max-diffs N]
+// Exits with 0 if everything matched, 1 if anything differed, and 2 if the trace could not be read.
+
+namespace Replay {
+	using namespace Data;
+	using UpdateTrace::record;
+	using UpdateTrace::record_header;
+	namespace Kernel = Data::Fear::Kernel;	// ::Fear holds the forms
+
+	template<typename... Args>
+	static void Print(const std::string_view fmt, Args&&... args) noexcept {
+		try { std::fputs((std::vformat(fmt, std::make_format_args(args...)) + "\n").c_str(), stdout); }
+		catch (...) {}
+	}
+
+	struct options {
+		string path{};
+		u32 repeat{ 1 };	// Times to rerun each update, for steadier timings
+		u32 workers{ 0 };	// Pool threads for updates of Kernel::ParallelMinActors or more, like fear_workers in game
+		u32 max_diffs{ 10 };	// Diffs to print before only counting them
+	};
+
+	static bool ParseArgs(const int argc, char** argv, options& opts) noexcept {
+		for (int i = 1; i < argc; ++i) {
+			const string_view arg{ argv[i] };
+			auto number = [&](u32& out) {
+				if (++i >= argc) {
+					return false;
+				}
+				const string_view val{ argv[i] };
+				return std::from_chars(val.data(), val.data() + val.size(), out).ec == std::errc{};
+			};
+			if (arg == "--repeat"sv) {
+				if (!number(opts.repeat) or (opts.repeat == 0)) {
+					return false;
+				}
+			} else if (arg == "--workers"sv) {
+				if (!number(opts.workers)) {
+					return false;
+				}
+				opts.workers = std::min<u32>(opts.workers, SyncTypes::worker_pool::MaxWorkers);
+			} else if (arg == "--max-diffs"sv) {
+				if (!number(opts.max_diffs)) {
+					return false;
+				}
+			} else if (opts.path.empty() and !arg.starts_with("--"sv)) {
+				opts.path = string{ arg };
+			} else {
+				return false;
+			}
+		}
+		return !opts.path.empty();
+	}
+
+	struct totals {
+		u64 records{ 0 };
+		u64 fear_updates{ 0 };
+		u64 actors{ 0 };
+		u64 rules_updates{ 0 };
+		u64 fear_diffs{ 0 };	// Updates where any actor's fear row differed
+		u64 rank_diffs{ 0 };
+		u64 result_diffs{ 0 };	// Most afraid or tension
+		u64 rules_diffs{ 0 };
+		u64 printed{ 0 };
+		Timing::latency_histogram fear_time{};
+		Timing::latency_histogram rules_time{};
+	};
+
+	// Counts a diff, and says what it was while under max_diffs
+	template<typename... Args>
+	static void Diff(totals& t, const options& opts, u64& counter, const std::string_view fmt, Args&&... args) noexcept {
+		++counter;
+		if (t.printed++ < opts.max_diffs) {
+			Print(fmt, std::forward<Args>(args)...);
+		}
+	}
+
+	static void ReplayFear(const record& rec, SyncTypes::worker_pool& pool, const options& opts, totals& t) noexcept {
+		static Kernel::lanes lanes{};
+		static fear_columns infos{};
+		static lazy_vector<float> exposures{};
+
+		const record_header& head = rec.head;
+		const u32 count = head.actor_count;
+		infos.clear();
+		exposures.clear();
+		if (!infos.reserve(count) or !exposures.reserve(count)) {
+			SKSE::stl::report_and_fail("out of memory"sv);
+		}
+		for (u32 i = 0; i < count; ++i) {
+			infos.append(rec.fears_in[i]);
+			exposures.append(rec.exposures[i]);
+		}
+		UpdateTypes::ranks_and_oneofs pack{};
+		pack.actor_count = count;
+		pack.now = head.now;
+		pack.need_ranks = head.is(record_header::NeedRanks);
+		const Kernel::params p = Kernel::Paced(head.hostile, head.interior, Kernel::milliseconds{ head.delta_ms });
+		SyncTypes::worker_pool* const use_pool = (opts.workers != 0) and (count >= Kernel::ParallelMinActors) ? &pool : nullptr;
+
+		Kernel::results res{};
+		for (u32 r = 0; r < opts.repeat; ++r) {
+			for (u32 i = 0; i < count; ++i) { // Every run from what the game had, since Compute() writes back
+				infos.set_row(i, rec.fears_in[i]);
+			}
+			const auto start = Timing::clock::now();
+			res = Kernel::Compute(lanes, infos, exposures, rec.mains, rec.seeing, rec.handles, pack, p, head.update_index, use_pool);
+			t.fear_time.record(Timing::clock::now() - start);
+		}
+		++t.fear_updates;
+		t.actors += count;
+
+		for (u32 i = 0; i < count; ++i) {
+			const FearInfo got = infos.row(i);
+			const FearInfo& want = rec.fears_out[i];
+			if (std::memcmp(&got, &want, sizeof(FearInfo)) != 0) {
+				Diff(t, opts, t.fear_diffs, "record {}: actor {} fear/thrillseeking/buildup {}/{}/{}, game had {}/{}/{}"sv, t.records, i,
+					got.fear.get(), got.thrillseeking.get(), got.buildup_mod.get(), want.fear.get(), want.thrillseeking.get(), want.buildup_mod.get());
+				break;
+			}
+		}
+		if (pack.need_ranks and (std::memcmp(pack.ranks.data(), rec.ranks.data(), count * sizeof(pack.ranks[0])) != 0)) {
+			Diff(t, opts, t.rank_diffs, "record {}: ranks differ"sv, t.records);
+		}
+		if ((res.most_afraid_idx != head.most_afraid_idx) or (std::bit_cast<u32>(res.player_tension) != std::bit_cast<u32>(head.player_tension))) {
+			Diff(t, opts, t.result_diffs, "record {}: most afraid {} and tension {}, game had {} and {}"sv, t.records, res.most_afraid_idx, res.player_tension, head.most_afraid_idx, head.player_tension);
+		}
+	}
+
+	static void ReplayRules(const record& rec, const options& opts, totals& t) noexcept {
+		const record_header& head = rec.head;
+		rules_info rules{};
+		for (u32 r = 0; r < opts.repeat; ++r) {
+			rules = rec.rules_in;
+			const auto start = Timing::clock::now();
+			rules.Update(rec.equips, head.rules_day_delta, head.player_tension, head.is(record_header::Follower));
+			t.rules_time.record(Timing::clock::now() - start);
+		}
+		++t.rules_updates;
+		// Punishments added by an update are picked at random, so those updates can differ without anything being wrong
+		if ((std::memcmp(&rules, &rec.rules_out, sizeof(rules_info)) != 0) or (std::bit_cast<u32>(rules.Exp().get()) != std::bit_cast<u32>(head.player_willpower))) {
+			Diff(t, opts, t.rules_diffs, "record {}: rules_info differs, reliefs {}, game had {}"sv, t.records, rules.EarnedReliefs().get(), rec.rules_out.EarnedReliefs().get());
+		}
+	}
+
+	static void PrintTimes(const string_view name, const Timing::latency_histogram& hist, const u64 updates, const u32 repeat) noexcept {
+		if (hist.count() == 0) {
+			return;
+		}
+		Print("{}: {} updates x{}, avg {}ns, p50 <{}us, p99 <{}us, max {}ns"sv, name, updates, repeat,
+			hist.average().count(), hist.quantile_upper(0.5).count(), hist.quantile_upper(0.99).count(), hist.max().count());
+	}
+
+	static int Run(const options& opts) noexcept {
+		UpdateTrace::reader reader{};
+		if (!reader.open(opts.path)) {
+			return 2;
+		}
+		static record rec{};
+		static totals t{};
+		SyncTypes::worker_pool pool{};
+		if (opts.workers != pool.resize(opts.workers)) {
+			Print("Only started {} of {} workers"sv, pool.size(), opts.workers);
+		}
+
+		while (reader.next(rec)) {
+			if (rec.head.is(record_header::FearRan)) {
+				ReplayFear(rec, pool, opts, t);
+			}
+			if (rec.head.is(record_header::RulesRan)) {
+				ReplayRules(rec, opts, t);
+			}
+			++t.records;
+		}
+
+		Print("{}: {} records, {} Fear updates of {:.1f} actors on average, {} rules updates, {} workers"sv, opts.path, t.records, t.fear_updates,
+			(t.fear_updates != 0) ? static_cast<double>(t.actors) / static_cast<double>(t.fear_updates) : 0.0, t.rules_updates, pool.size());
+		PrintTimes("Fear::Update"sv, t.fear_time, t.fear_updates, opts.repeat);
+		if (t.fear_time.count() != 0 and t.actors != 0) {
+			Print("Fear::Update: {:.1f}ns per actor"sv, static_cast<double>(t.fear_time.total().count()) / static_cast<double>(t.actors * opts.repeat));
+		}
+		PrintTimes("rules_info::Update"sv, t.rules_time, t.rules_updates, opts.repeat);
+		Print("Diffs: {} fear, {} ranks, {} most afraid/tension, {} rules (random punishments can make these differ)"sv, t.fear_diffs, t.rank_diffs, t.result_diffs, t.rules_diffs);
+
+		if (reader.malformed()) {
+			Print("Stopped at a bad record after {} good ones"sv, t.records);
+			return 2;
+		}
+		return ((t.fear_diffs | t.rank_diffs | t.result_diffs | t.rules_diffs) == 0) ? 0 : 1;
+	}
+
+}
+
+int main(int argc, char** argv) {
+	Replay::options opts{};
+	if (!Replay::ParseArgs(argc, argv, opts)) {
+		std::fputs("Usage: fearse_replay <trace> [--repeat N] [--workers N] [--max-diffs N]\n", stderr);
+		return 2;
+	}
+	return Replay::Run(opts);
+}
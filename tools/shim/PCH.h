@@ -0,0 +1,389 @@
+#pragma once
+
+// Stands in for src/PCH.h outside the game: the standard library CommonLibSSE would have pulled in, plus just enough RE::, REL:: and SKSE:: for the shared headers to compile.
+// Nothing here touches a game. Game functions are only declared, so inline code naming them compiles, and anything that actually calls one fails to link.
+// SKSE::SerializationInterface is the exception: it keeps records in memory, for co-save benchmarks.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cfloat>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <set>
+#include <shared_mutex>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <immintrin.h>
+
+using namespace std::literals;
+
+namespace SKSE::stl {
+	// Just the enum and its underlying value
+	template<typename E, typename U = std::underlying_type_t<E>>
+	class enumeration {
+	public:
+		constexpr enumeration() noexcept = default;
+		constexpr enumeration(const E val) noexcept : value{ static_cast<U>(val) } {}
+
+		constexpr E get() const noexcept { return static_cast<E>(value); }
+		constexpr U underlying() const noexcept { return value; }
+
+	private:
+		U value{};
+	};
+}
+
+namespace RE {
+	using FormID = std::uint32_t;
+	using VMStackID = std::uint32_t;
+
+	struct StaticFunctionTag;
+	namespace BSScript {
+		class IVirtualMachine;
+		class Variable {
+		public:
+			bool IsNoneObject() const noexcept;
+			std::shared_ptr<std::vector<Variable>> GetArray() const noexcept;
+			template<typename T> T Unpack() const noexcept;
+		};
+		namespace Internal {
+			class VirtualMachine;
+		}
+	}
+
+	enum class FormType : std::uint8_t {
+		Spell = 22,
+		Armor = 26,
+		Weapon = 41
+	};
+
+	enum class SEX : std::uint32_t {
+		kNone = static_cast<std::uint32_t>(-1),
+		kMale = 0,
+		kFemale = 1
+	};
+
+	enum class ActorValue : std::int32_t {
+		kNone = -1,
+		kTotal = 164
+	};
+
+	enum class ACTOR_VALUE_MODIFIER : std::uint32_t {
+		kPermanent = 0,
+		kTemporary = 1,
+		kDamage = 2,
+		kTotal
+	};
+
+	namespace MagicSystem {
+		enum class SpellType : std::uint32_t {
+			kSpell = 0
+		};
+	}
+
+	namespace WeaponTypes {
+		enum WEAPON_TYPE : std::uint32_t {
+			kHandToHandMelee = 0,
+			kOneHandSword,
+			kOneHandDagger,
+			kOneHandAxe,
+			kOneHandMace,
+			kTwoHandSword,
+			kTwoHandAxe,
+			kBow,
+			kStaff,
+			kCrossbow,
+			kTotal
+		};
+	}
+
+	struct BIPED_MODEL {
+		enum class ArmorType : std::uint32_t {
+			kLightArmor = 0,
+			kHeavyArmor = 1,
+			kClothing = 2
+		};
+		enum class BipedObjectSlot : std::uint32_t {
+			kNone = 0,
+			kHead = 1 << 0,
+			kHair = 1 << 1,
+			kBody = 1 << 2,
+			kHands = 1 << 3,
+			kFeet = 1 << 7
+		};
+
+		SKSE::stl::enumeration<BipedObjectSlot, std::uint32_t> bipedObjectSlots{};
+		SKSE::stl::enumeration<ArmorType, std::uint32_t> armorType{};
+	};
+
+	class TESForm {
+	public:
+		struct RecordFlags {
+			enum RecordFlag : std::uint32_t {
+				kDeleted = 1 << 5,
+				kInitiallyDisabled = 1 << 11
+			};
+		};
+
+		template<typename T> static T* LookupByID(const FormID id) noexcept;
+
+		FormID GetFormID() const noexcept { return formID; }
+		FormType GetFormType() const noexcept;
+		bool Is(const FormType type) const noexcept;
+		template<typename T> T* As() noexcept;
+		template<typename T> const T* As() const noexcept;
+
+		std::uint32_t formFlags{};
+		FormID formID{};
+	};
+
+	class BGSKeyword : public TESForm {};
+	class BGSKeywordForm {
+	public:
+		bool HasKeyword(const BGSKeyword* keyword) const noexcept;
+
+		BGSKeyword** keywords{};
+		std::uint32_t numKeywords{};
+	};
+	class BGSLocation : public TESForm {};
+	class TESRace : public TESForm {};
+	class TESFaction : public TESForm {};
+	class TESGlobal : public TESForm { public: float value{}; };
+	class TESObjectMISC : public TESForm {};
+	class TESQuest : public TESForm {};
+	class EffectSetting : public TESForm {};
+	class TESObjectCELL : public TESForm { public: bool IsInteriorCell() const noexcept; };
+	class TESBoundObject : public TESForm {};
+
+	class SpellItem : public TESBoundObject {
+	public:
+		static constexpr FormType FORMTYPE{ FormType::Spell };
+		ActorValue GetAssociatedSkill() const noexcept;
+	};
+	class TESObjectWEAP : public TESBoundObject {
+	public:
+		static constexpr FormType FORMTYPE{ FormType::Weapon };
+		WeaponTypes::WEAPON_TYPE GetWeaponType() const noexcept;
+	};
+	class TESObjectARMO : public TESBoundObject, public BGSKeywordForm {
+	public:
+		static constexpr FormType FORMTYPE{ FormType::Armor };
+		BIPED_MODEL::ArmorType GetArmorType() const noexcept;
+		BIPED_MODEL::BipedObjectSlot GetSlotMask() const noexcept;
+
+		BIPED_MODEL bipedModelData{};
+	};
+
+	class InventoryEntryData {
+	public:
+		bool IsWorn() const noexcept;
+
+		TESBoundObject* object{};
+	};
+	class InventoryChanges {
+	public:
+		std::vector<InventoryEntryData*>* entryList{};
+	};
+
+	class AIProcess {
+	public:
+		struct Hands {
+			enum Hand : std::uint32_t {
+				kLeft = 0,
+				kRight = 1,
+				kTotal
+			};
+		};
+
+		TESForm* equippedObjects[Hands::kTotal]{};
+	};
+
+	class TESObjectREFR : public TESForm {
+	public:
+		bool IsPlayerRef() const noexcept;
+		InventoryChanges* GetInventoryChanges(const bool no_init = false) noexcept;
+	};
+
+	class Actor : public TESObjectREFR {
+	public:
+		bool IsDead() const noexcept;
+		bool IsChild() const noexcept;
+		bool IsInCombat() const noexcept;
+		void AddToFaction(TESFaction* faction, const std::int8_t rank) noexcept;
+		bool RemoveSpell(SpellItem* spell) noexcept;
+
+		TESRace* race{};
+		AIProcess* currentProcess{};
+	};
+	class PlayerCharacter : public Actor {};
+
+	// Holds the pointer and nothing else. No game reference counts out here.
+	template<typename T>
+	class NiPointer {
+	public:
+		NiPointer() noexcept = default;
+		explicit NiPointer(T* init) noexcept : ptr{ init } {}
+
+		T* get() const noexcept { return ptr; }
+		T* operator->() const noexcept { return ptr; }
+		T& operator*() const noexcept { return *ptr; }
+		explicit operator bool() const noexcept { return ptr != nullptr; }
+
+	private:
+		T* ptr{};
+	};
+	using ActorPtr = NiPointer<Actor>;
+
+	class ActorHandle {
+	public:
+		ActorHandle() noexcept = default;
+		ActorHandle(const Actor* actor) noexcept;
+
+		NiPointer<Actor> get() const noexcept;
+		std::uint32_t native_handle() const noexcept { return handle; }
+
+	private:
+		std::uint32_t handle{};
+	};
+
+	class TESFile {
+	public:
+		std::uint8_t compileIndex{};
+		std::uint16_t smallFileCompileIndex{};
+	};
+
+	class TESDataHandler {
+	public:
+		static TESDataHandler* GetSingleton() noexcept;
+		const TESFile* LookupModByName(std::string_view name) const noexcept;
+		std::optional<std::uint8_t> GetLoadedModIndex(std::string_view name) const noexcept;
+		std::optional<std::uint16_t> GetLoadedLightModIndex(std::string_view name) const noexcept;
+	};
+}
+
+namespace REL {
+	template<typename T>
+	class Relocation {
+	public:
+		explicit Relocation(const std::uint64_t id) noexcept;
+
+		template<typename... Args>
+		std::invoke_result_t<const T&, Args&&...> operator()(Args&&... args) const noexcept;
+	};
+}
+#define RELOCATION_ID(se, ae) static_cast<std::uint64_t>(se)
+
+namespace SKSE {
+	struct ModCallbackEvent;
+
+	// Keeps records in memory instead of a co-save, so Save()/Load() code can run out here. Form IDs resolve to themselves.
+	// Write everything, rewind(), then read it back like a load would.
+	class SerializationInterface {
+	public:
+		bool OpenRecord(const std::uint32_t type, const std::uint32_t version) noexcept {
+			records.push_back({ type, version, data.size(), 0 });
+			return true;
+		}
+		bool WriteRecordData(const void* buf, const std::uint32_t length) noexcept {
+			if (records.empty()) {
+				return false;
+			}
+			const auto* bytes = static_cast<const std::byte*>(buf);
+			data.insert(data.end(), bytes, bytes + length);
+			records.back().length += length;
+			++write_calls;
+			return true;
+		}
+		template<typename T> bool WriteRecordData(const T& data) noexcept { return WriteRecordData(std::addressof(data), static_cast<std::uint32_t>(sizeof(T))); }
+
+		bool GetNextRecordInfo(std::uint32_t& type, std::uint32_t& version, std::uint32_t& length) noexcept {
+			if (next_record >= records.size()) {
+				return false;
+			}
+			const record& rec = records[next_record++];
+			read_pos = rec.offset;
+			read_end = rec.offset + rec.length;
+			type = rec.type;
+			version = rec.version;
+			length = rec.length;
+			return true;
+		}
+		std::uint32_t ReadRecordData(void* buf, const std::uint32_t length) noexcept {
+			const std::uint32_t n = static_cast<std::uint32_t>(std::min<std::size_t>(length, read_end - read_pos));
+			std::memcpy(buf, data.data() + read_pos, n);
+			read_pos += n;
+			++read_calls;
+			return n;
+		}
+		template<typename T> std::uint32_t ReadRecordData(T& data) noexcept { return ReadRecordData(std::addressof(data), static_cast<std::uint32_t>(sizeof(T))); }
+		bool ResolveFormID(const RE::FormID old_id, RE::FormID& new_id) const noexcept {
+			new_id = old_id;
+			return true;
+		}
+
+		void rewind() noexcept { next_record = 0; read_pos = 0; read_end = 0; }
+		void clear() noexcept { data.clear(); records.clear(); rewind(); write_calls = 0; read_calls = 0; }
+		std::size_t bytes() const noexcept { return data.size(); }
+
+		std::size_t write_calls{};
+		std::size_t read_calls{};
+
+	private:
+		struct record {
+			std::uint32_t type;
+			std::uint32_t version;
+			std::size_t offset;
+			std::uint32_t length;
+		};
+
+		std::vector<std::byte> data{};
+		std::vector<record> records{};
+		std::size_t next_record{};
+		std::size_t read_pos{};
+		std::size_t read_end{};
+	};
+
+	namespace stl {
+		[[noreturn]] inline void report_and_fail(const std::string_view msg) noexcept {
+			std::fprintf(stderr, "%.*s\n", static_cast<int>(msg.size()), msg.data());
+			std::abort();
+		}
+	}
+}
+
+#include "Version.h"
@@ -0,0 +1,9 @@
+#include "Logger.h"
+#include <cstdio>
+
+// Log without sinks or a game console. Everything goes to stderr as it comes.
+void Log::NativeMessage(in_msg_type msg, const Severity severity) noexcept {
+	static constexpr std::array<std::string_view, 4> prefixes{ "[info] "sv, "[warning] "sv, "[error] "sv, "[critical] "sv };
+	const std::string_view prefix = (severity < Severity::prohibit) ? prefixes[static_cast<std::size_t>(severity)] : ""sv;
+	std::fprintf(stderr, "%.*s%s\n", static_cast<int>(prefix.size()), prefix.data(), msg.c_str());
+}